@@ -0,0 +1,345 @@
+/**
+FNELEM-GPU ANALYSIS - SOLVER COST MODEL
+Estimates work and memory of each solver, used by automatic solver selection.
+
+@package fnelem.analysis
+@author ppizarror
+@date 03/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "solver_cost_model.h"
+
+// Available memory is read from the system if supported
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+/**
+ * Adds candidate.
+ *
+ * @param name Solver name
+ * @param flops Floating point operations
+ * @param memory Memory in bytes
+ * @param rate Flop rate relative to sparse operations
+ */
+void SolverCostModel::add_candidate(const std::string &name, double flops, double memory, double rate) {
+    this->names.push_back(name);
+    this->flops.push_back(flops);
+    this->memory.push_back(memory);
+    this->cost.push_back(flops / rate);
+}
+
+/**
+ * Return candidate position.
+ *
+ * @param name Solver name
+ * @return
+ */
+int SolverCostModel::get(const std::string &name) const {
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        if (this->names[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    throw std::logic_error("[SOLVER-COST-MODEL] Solver " + name + " is not a candidate");
+}
+
+/**
+ * Estimate the work and memory of each candidate. Direct solvers are estimated from
+ * the envelope (skyline) and the elimination tree column counts (sparse LDL'), iterative
+ * solvers assume O(sqrt(n)) iterations for Jacobi preconditioner and a constant number
+ * for multigrid. Memory of the assembled solvers includes the sparse stiffness.
+ *
+ * @param n Number of degrees of freedom
+ * @param pattern Column indices of the lower triangle of each row, sorted
+ * @param element_values Number of element stiffness values, used by matrix free solver
+ * @param nrhs Number of load cases
+ */
+void SolverCostModel::estimate(int n, const std::vector<std::vector<int>> *pattern, long element_values, int nrhs) {
+    if (n < 1 || pattern->size() != static_cast<unsigned long>(n)) {
+        throw std::logic_error("[SOLVER-COST-MODEL] Pattern does not agree with the number of degrees of freedom");
+    }
+    this->n = n;
+    this->names.clear();
+    this->flops.clear();
+    this->memory.clear();
+    this->cost.clear();
+    this->selected.clear();
+    this->reason.clear();
+    double r = std::max(nrhs, 1);
+    double dn = n;
+
+    // Envelope and pattern of the lower triangle
+    int *ap = new int[n + 1];
+    this->nnz = 0;
+    this->profile = 0;
+    double envelope_flops = 0;
+    for (int i = 0; i < n; i++) {
+        const std::vector<int> &row = pattern->at(static_cast<unsigned long>(i));
+        ap[i] = static_cast<int>(this->nnz);
+        this->nnz += static_cast<long>(row.size());
+        long h = row.empty() ? 0 : i - row.front();
+        this->profile += h;
+        envelope_flops += static_cast<double>(h) * h;
+    }
+    ap[n] = static_cast<int>(this->nnz);
+    int *ai = new int[this->nnz];
+    long k = 0;
+    for (auto &row : *pattern) {
+        for (int j : row) {
+            ai[k++] = j;
+        }
+    }
+
+    // Column counts of the sparse factor
+    int *parent = new int[n];
+    int *lnz = new int[n];
+    SparseLDL::elimination_tree(n, ap, ai, parent, lnz);
+    this->factor_nnz = 0;
+    double factor_flops = 0;
+    for (int i = 0; i < n; i++) {
+        this->factor_nnz += lnz[i];
+        factor_flops += static_cast<double>(lnz[i]) * (lnz[i] + 3);
+    }
+    delete[] ap;
+    delete[] ai;
+    delete[] parent;
+    delete[] lnz;
+
+    // Sparse stiffness and system vectors
+    double dnnz = this->nnz;
+    double stiffness = 12 * dnnz + 4 * dn;
+    double vectors = 16 * dn * r;
+    double product = 4 * dnnz;
+
+    // Direct solvers
+    this->add_candidate("dense", dn * dn * dn / 3 + 2 * dn * dn * r, stiffness + vectors + 16 * dn * dn,
+                        __SOLVER_COST_MODEL_DENSE_RATE);
+    this->add_candidate("skyline", envelope_flops + 4 * (this->profile + dn) * r,
+                        stiffness + vectors + 8 * (this->profile + dn), __SOLVER_COST_MODEL_SKYLINE_RATE);
+    this->add_candidate("ldl", factor_flops + 4 * (this->factor_nnz + dn) * r + 10 * (dnnz + this->factor_nnz),
+                        stiffness + vectors + 12 * this->factor_nnz + 28 * dn, 1);
+
+    // Iterative solvers
+    double pcg_iterations = std::ceil(__SOLVER_COST_MODEL_PCG_ITERATIONS * std::sqrt(dn));
+    this->add_candidate("pcg", r * pcg_iterations * (product + 12 * dn), stiffness + vectors + 48 * dn, 1);
+    this->add_candidate("amg", 60 * dnnz + r * __SOLVER_COST_MODEL_AMG_ITERATIONS *
+                                           (4 * __SOLVER_COST_MODEL_AMG_COMPLEXITY * product + 12 * dn),
+                        stiffness * (1 + 2 * __SOLVER_COST_MODEL_AMG_COMPLEXITY) + vectors + 48 * dn, 1);
+    this->add_candidate("matrix-free", r * pcg_iterations * (2 * element_values + 12 * dn),
+                        8 * static_cast<double>(element_values) + vectors + 56 * dn, 1);
+
+    // Skyline factors stored on disk, only the panels within the budget are in memory
+    if (this->out_of_core_memory > 0) {
+        this->add_candidate("out-of-core", envelope_flops + 4 * (this->profile + dn) * r,
+                            stiffness + vectors + 8 * dn +
+                            std::min(static_cast<double>(this->out_of_core_memory), 8 * (this->profile + dn)),
+                            __SOLVER_COST_MODEL_OUT_OF_CORE_RATE);
+    }
+
+    // GPU inversion
+    if (this->cuda) {
+        this->add_candidate("cuda", dn * dn * dn + 2 * dn * dn * r, stiffness + vectors + 24 * dn * dn,
+                            __SOLVER_COST_MODEL_CUDA_RATE);
+    }
+}
+
+/**
+ * Select the fastest candidate that fits within memory limit, if none fits the candidate
+ * using less memory is selected.
+ *
+ * @return Selected solver name
+ */
+std::string SolverCostModel::select() {
+    if (this->names.empty()) {
+        throw std::logic_error("[SOLVER-COST-MODEL] Candidates must be estimated first");
+    }
+    double limit = static_cast<double>(this->get_memory_limit());
+    int best = -1, smallest = 0;
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        if (this->memory[i] < this->memory[smallest]) smallest = static_cast<int>(i);
+        if (limit > 0 && this->memory[i] > limit) continue;
+        if (best < 0 || this->cost[i] < this->cost[best]) best = static_cast<int>(i);
+    }
+
+    // Write reason
+    std::ostringstream out;
+    out << std::setprecision(3);
+    if (best >= 0) {
+        out << this->names[best] << ", lowest estimated work " << this->cost[best] << " flops and "
+            << this->memory[best] / 1048576 << " MB";
+        if (limit > 0) {
+            out << " within " << limit / 1048576 << " MB";
+        }
+    } else {
+        best = smallest;
+        out << this->names[best] << ", no solver fits within " << limit / 1048576 << " MB, lowest memory "
+            << this->memory[best] / 1048576 << " MB";
+    }
+    out << " (n=" << this->n << ", nnz=" << this->nnz << ", profile=" << this->profile << ", factor nnz="
+        << this->factor_nnz << ")";
+    this->selected = this->names[best];
+    this->reason = out.str();
+    return this->selected;
+}
+
+/**
+ * Return selected candidate.
+ *
+ * @return Solver name, empty if there is no selection
+ */
+std::string SolverCostModel::get_selected() const {
+    return this->selected;
+}
+
+/**
+ * Return reason of the selection.
+ *
+ * @return
+ */
+std::string SolverCostModel::get_reason() const {
+    return this->reason;
+}
+
+/**
+ * Return candidate names.
+ *
+ * @return
+ */
+std::vector<std::string> SolverCostModel::get_names() const {
+    return this->names;
+}
+
+/**
+ * Return floating point operations of a candidate.
+ *
+ * @param name Solver name
+ * @return
+ */
+double SolverCostModel::get_flops(const std::string &name) const {
+    return this->flops[this->get(name)];
+}
+
+/**
+ * Return memory of a candidate.
+ *
+ * @param name Solver name
+ * @return Memory in bytes
+ */
+double SolverCostModel::get_memory(const std::string &name) const {
+    return this->memory[this->get(name)];
+}
+
+/**
+ * Return number of non zeros of the sparse LDL' factor, without reordering.
+ *
+ * @return
+ */
+long SolverCostModel::get_factor_nnz() const {
+    return this->factor_nnz;
+}
+
+/**
+ * Set memory limit, the current selection is discarded.
+ *
+ * @param bytes Memory in bytes, zero uses the available memory
+ */
+void SolverCostModel::set_memory_limit(long bytes) {
+    if (bytes < 0) {
+        throw std::logic_error("[SOLVER-COST-MODEL] Memory limit cannot be negative");
+    }
+    this->memory_limit = bytes;
+    this->selected.clear();
+}
+
+/**
+ * Return memory limit used by the selection.
+ *
+ * @return Memory in bytes, zero if it is unknown
+ */
+long SolverCostModel::get_memory_limit() const {
+    if (this->memory_limit > 0) {
+        return this->memory_limit;
+    }
+    return SolverCostModel::get_available_memory();
+}
+
+/**
+ * Consider GPU inversion as candidate.
+ *
+ * @param enabled GPU is available
+ */
+void SolverCostModel::set_cuda(bool enabled) {
+    this->cuda = enabled;
+    this->selected.clear();
+}
+
+/**
+ * Set memory budget of the out of core factorization, the candidate uses the skyline work
+ * and the budget instead of the envelope memory.
+ *
+ * @param bytes Memory budget in bytes, zero disables the candidate
+ */
+void SolverCostModel::set_out_of_core_memory(long bytes) {
+    if (bytes < 0) {
+        throw std::logic_error("[SOLVER-COST-MODEL] Memory budget cannot be negative");
+    }
+    this->out_of_core_memory = bytes;
+    this->selected.clear();
+}
+
+/**
+ * Return available physical memory.
+ *
+ * @return Memory in bytes, zero if it is unknown
+ */
+long SolverCostModel::get_available_memory() {
+#if (defined(__unix__) || defined(__APPLE__)) && defined(_SC_AVPHYS_PAGES)
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long size = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && size > 0) {
+        return pages * size;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Display candidates to console.
+ */
+void SolverCostModel::disp() const {
+    std::cout << "Solver cost model:" << std::endl;
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        std::cout << "\t" << std::left << std::setw(13) << this->names[i] << std::right << std::setprecision(3)
+                  << this->flops[i] << " flops, " << this->memory[i] / 1048576 << " MB";
+        if (this->names[i] == this->selected) {
+            std::cout << " [SELECTED]";
+        }
+        std::cout << std::endl;
+    }
+    if (!this->selected.empty()) {
+        std::cout << "\tSelected " << this->reason << std::endl;
+    }
+}
\ No newline at end of file
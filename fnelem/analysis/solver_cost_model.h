@@ -0,0 +1,157 @@
+/**
+FNELEM-GPU ANALYSIS - SOLVER COST MODEL
+Estimates work and memory of each solver, used by automatic solver selection.
+
+@package fnelem.analysis
+@author ppizarror
+@date 03/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_ANALYSIS_SOLVER_COST_MODEL_H
+#define __FNELEM_ANALYSIS_SOLVER_COST_MODEL_H
+
+// Include headers
+#include "../math/sparse_ldl.h"
+
+// Library imports
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Constant definition
+#define __SOLVER_COST_MODEL_DENSE_RATE 4.0          // Flop rate of dense factorization relative to sparse
+#define __SOLVER_COST_MODEL_SKYLINE_RATE 2.0        // Flop rate of skyline factorization relative to sparse
+#define __SOLVER_COST_MODEL_OUT_OF_CORE_RATE 1.0    // Flop rate of out of core skyline, panels are read from disk
+#define __SOLVER_COST_MODEL_CUDA_RATE 50.0          // Flop rate of GPU inversion relative to sparse
+#define __SOLVER_COST_MODEL_PCG_ITERATIONS 2.0      // PCG iterations per square root of the dimension
+#define __SOLVER_COST_MODEL_AMG_ITERATIONS 15       // AMG-PCG iterations, independent of the dimension
+#define __SOLVER_COST_MODEL_AMG_COMPLEXITY 1.5      // Operator complexity of the multigrid hierarchy
+
+/**
+ * Estimates the work and memory of each solver candidate from the stiffness pattern, and
+ * selects the fastest one that fits within the memory limit. Work is measured in floating
+ * point operations scaled by the relative flop rate of each solver.
+ */
+class SolverCostModel {
+private:
+
+    // Number of degrees of freedom
+    int n = 0;
+
+    // Number of values of the lower triangle
+    long nnz = 0;
+
+    // Number of values within the lower envelope
+    long profile = 0;
+
+    // Number of non zeros of the sparse LDL' factor
+    long factor_nnz = 0;
+
+    // Memory limit in bytes, zero uses the available memory
+    long memory_limit = 0;
+
+    // GPU inversion is a candidate
+    bool cuda = false;
+
+    // Memory budget of the out of core factorization in bytes
+    long out_of_core_memory = 0;
+
+    // Candidate names
+    std::vector<std::string> names;
+
+    // Floating point operations of each candidate
+    std::vector<double> flops;
+
+    // Memory of each candidate in bytes
+    std::vector<double> memory;
+
+    // Estimated time of each candidate, flops scaled by the flop rate
+    std::vector<double> cost;
+
+    // Selected candidate
+    std::string selected;
+
+    // Reason of the selection
+    std::string reason;
+
+    // Adds candidate
+    void add_candidate(const std::string &name, double flops, double memory, double rate);
+
+    // Return candidate position, throws exception if it does not exist
+    int get(const std::string &name) const;
+
+public:
+
+    // Estimate candidates from the lower triangle pattern of the stiffness
+    void estimate(int n, const std::vector<std::vector<int>> *pattern, long element_values, int nrhs);
+
+    // Select fastest candidate that fits within memory limit
+    std::string select();
+
+    // Return selected candidate, empty if there is no selection
+    std::string get_selected() const;
+
+    // Return reason of the selection
+    std::string get_reason() const;
+
+    // Return candidate names
+    std::vector<std::string> get_names() const;
+
+    // Return floating point operations of a candidate
+    double get_flops(const std::string &name) const;
+
+    // Return memory of a candidate in bytes
+    double get_memory(const std::string &name) const;
+
+    // Return number of non zeros of the sparse LDL' factor
+    long get_factor_nnz() const;
+
+    // Set memory limit in bytes, zero uses the available memory
+    void set_memory_limit(long bytes);
+
+    // Return memory limit used by the selection in bytes
+    long get_memory_limit() const;
+
+    // Consider GPU inversion
+    void set_cuda(bool enabled);
+
+    // Set memory budget of the out of core factorization, zero disables the candidate
+    void set_out_of_core_memory(long bytes);
+
+    // Return available physical memory in bytes, zero if unknown
+    static long get_available_memory();
+
+    // Display candidates to console
+    void disp() const;
+
+};
+
+#endif // __FNELEM_ANALYSIS_SOLVER_COST_MODEL_H
\ No newline at end of file
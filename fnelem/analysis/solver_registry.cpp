@@ -0,0 +1,224 @@
+/**
+FNELEM-GPU ANALYSIS - SOLVER REGISTRY
+Registry of the linear solver backends used by the analysis.
+
+@package fnelem.analysis
+@author ppizarror
+@date 02/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "solver_registry.h"
+
+/**
+ * Return backend position.
+ *
+ * @param name Backend name
+ * @return Position, -1 if the backend is not registered
+ */
+int SolverRegistry::find(const std::string &name) const {
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        if (this->names[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Return backend position, throws exception if the backend is not registered.
+ *
+ * @param name Backend name
+ * @return Position
+ */
+int SolverRegistry::get(const std::string &name) const {
+    int i = this->find(name);
+    if (i < 0) {
+        throw std::logic_error("[SOLVER-REGISTRY] Solver backend " + name + " is not registered");
+    }
+    return i;
+}
+
+/**
+ * Register new backend.
+ *
+ * @param name Backend name, must be unique
+ * @param description Backend description
+ * @param assembled Backend requires the assembled stiffness matrix, else the element by element operator is used
+ * @param backend Backend function
+ */
+void SolverRegistry::add(const std::string &name, const std::string &description, bool assembled,
+                         const SolverBackend &backend) {
+    if (name.empty()) {
+        throw std::logic_error("[SOLVER-REGISTRY] Solver backend name cannot be empty");
+    }
+    if (this->find(name) >= 0) {
+        throw std::logic_error("[SOLVER-REGISTRY] Solver backend " + name + " is already registered");
+    }
+    if (!backend) {
+        throw std::logic_error("[SOLVER-REGISTRY] Solver backend " + name + " function cannot be empty");
+    }
+    this->names.push_back(name);
+    this->descriptions.push_back(description);
+    this->assembled.push_back(assembled);
+    this->backends.push_back(backend);
+    this->runs.push_back(0);
+    this->last_time.push_back(-1);
+    this->total_time.push_back(0);
+}
+
+/**
+ * Check backend is registered.
+ *
+ * @param name Backend name
+ * @return
+ */
+bool SolverRegistry::has(const std::string &name) const {
+    return this->find(name) >= 0;
+}
+
+/**
+ * Return number of backends.
+ *
+ * @return
+ */
+int SolverRegistry::get_number_backends() const {
+    return static_cast<int>(this->names.size());
+}
+
+/**
+ * Return backend names, following registration order.
+ *
+ * @return
+ */
+std::vector<std::string> SolverRegistry::get_names() const {
+    return this->names;
+}
+
+/**
+ * Return backend description.
+ *
+ * @param name Backend name
+ * @return
+ */
+std::string SolverRegistry::get_description(const std::string &name) const {
+    return this->descriptions[this->get(name)];
+}
+
+/**
+ * Check backend requires the assembled stiffness matrix.
+ *
+ * @param name Backend name
+ * @return
+ */
+bool SolverRegistry::requires_stiffness(const std::string &name) const {
+    return this->assembled[this->get(name)];
+}
+
+/**
+ * Solve using a backend, the solution time is stored even if the backend fails.
+ *
+ * @param name Backend name
+ * @param cached Stored factorization can be used
+ * @return Solution description
+ */
+std::string SolverRegistry::solve(const std::string &name, bool cached) {
+    int i = this->get(name);
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    std::string method;
+    try {
+        method = this->backends[i](cached);
+    } catch (...) {
+        this->last_time[i] = -1;
+        throw;
+    }
+    std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+    long duration = static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count());
+    this->runs[i] += 1;
+    this->last_time[i] = duration;
+    this->total_time[i] += duration;
+    return method;
+}
+
+/**
+ * Return number of solutions of a backend.
+ *
+ * @param name Backend name
+ * @return
+ */
+int SolverRegistry::get_runs(const std::string &name) const {
+    return this->runs[this->get(name)];
+}
+
+/**
+ * Return time of the last solution of a backend.
+ *
+ * @param name Backend name
+ * @return Time in microseconds, -1 if the backend has not been used or the last solution failed
+ */
+long SolverRegistry::get_last_time(const std::string &name) const {
+    return this->last_time[this->get(name)];
+}
+
+/**
+ * Return total time of a backend.
+ *
+ * @param name Backend name
+ * @return Time in microseconds
+ */
+long SolverRegistry::get_total_time(const std::string &name) const {
+    return this->total_time[this->get(name)];
+}
+
+/**
+ * Reset number of solutions and time of all backends.
+ */
+void SolverRegistry::reset_timing() {
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        this->runs[i] = 0;
+        this->last_time[i] = -1;
+        this->total_time[i] = 0;
+    }
+}
+
+/**
+ * Display backends and their time to console.
+ */
+void SolverRegistry::disp() const {
+    unsigned long width = 0;
+    for (auto &name : this->names) {
+        width = std::max(width, name.size());
+    }
+    std::cout << "Solver backends:" << std::endl;
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        std::cout << "\t" << std::left << std::setw(static_cast<int>(width + 2)) << this->names[i] << std::right;
+        if (this->runs[i] == 0) {
+            std::cout << "not used";
+        } else {
+            std::cout << this->runs[i] << " runs, last " << this->last_time[i] << " microseconds, total "
+                      << this->total_time[i] << " microseconds";
+        }
+        std::cout << " - " << this->descriptions[i] << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/**
+FNELEM-GPU ANALYSIS - SOLVER REGISTRY
+Registry of the linear solver backends used by the analysis.
+
+@package fnelem.analysis
+@author ppizarror
+@date 02/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_ANALYSIS_SOLVER_REGISTRY_H
+#define __FNELEM_ANALYSIS_SOLVER_REGISTRY_H
+
+// Include headers
+#include "../math/fematrix.h"
+#include "../math/fematrix_sparse.h"
+
+// Library imports
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Solver backend, solves the stiffness system of the analysis. Receives true if the stored
+ * factorization can be used and returns the description of the solution.
+ */
+typedef std::function<std::string(bool cached)> SolverBackend;
+
+/**
+ * User defined solver, receives the stiffness matrix, the force matrix (one column per load
+ * case) and true if the stiffness did not change since the last call. Returns a new
+ * displacement matrix.
+ */
+typedef std::function<FEMatrix *(const FEMatrixSparse *K, const FEMatrix *F, bool cached)> SolverFunction;
+
+/**
+ * Registry of the solver backends, each one is selected by their name. The registry also
+ * stores the solution time of each backend, so solvers can be compared within the same run.
+ */
+class SolverRegistry {
+private:
+
+    // Backend names, following registration order
+    std::vector<std::string> names;
+
+    // Backend descriptions
+    std::vector<std::string> descriptions;
+
+    // Backend requires the assembled stiffness matrix
+    std::vector<bool> assembled;
+
+    // Backend functions
+    std::vector<SolverBackend> backends;
+
+    // Number of solutions of each backend
+    std::vector<int> runs;
+
+    // Time of the last solution of each backend in microseconds
+    std::vector<long> last_time;
+
+    // Total time of each backend in microseconds
+    std::vector<long> total_time;
+
+    // Return backend position, -1 if it is not registered
+    int find(const std::string &name) const;
+
+    // Return backend position, throws exception if it is not registered
+    int get(const std::string &name) const;
+
+public:
+
+    // Register new backend
+    void add(const std::string &name, const std::string &description, bool assembled,
+             const SolverBackend &backend);
+
+    // Check backend is registered
+    bool has(const std::string &name) const;
+
+    // Return number of backends
+    int get_number_backends() const;
+
+    // Return backend names, following registration order
+    std::vector<std::string> get_names() const;
+
+    // Return backend description
+    std::string get_description(const std::string &name) const;
+
+    // Check backend requires the assembled stiffness matrix
+    bool requires_stiffness(const std::string &name) const;
+
+    // Solve using a backend, solution time is stored
+    std::string solve(const std::string &name, bool cached);
+
+    // Return number of solutions of a backend
+    int get_runs(const std::string &name) const;
+
+    // Return time of the last solution of a backend in microseconds
+    long get_last_time(const std::string &name) const;
+
+    // Return total time of a backend in microseconds
+    long get_total_time(const std::string &name) const;
+
+    // Reset time of all backends
+    void reset_timing();
+
+    // Display backends and their time to console
+    void disp() const;
+
+};
+
+#endif // __FNELEM_ANALYSIS_SOLVER_REGISTRY_H
\ No newline at end of file
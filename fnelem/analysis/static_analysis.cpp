@@ -40,53 +40,140 @@ Performs static analysis calculation.
 StaticAnalysis::StaticAnalysis(Model *model) {
     this->model = model;
     this->ndof = 0;
+    this->pcg = new PCGSolver();
+    this->amg = new AMGPreconditioner();
+    this->gmg = new GMGPreconditioner();
+    this->mixed = new MixedPrecisionSolver();
+    this->update = new LowRankUpdate();
+    this->solvers = new SolverRegistry();
+    this->register_solvers();
+    this->costs = new SolverCostModel();
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+    this->costs->set_out_of_core_memory(this->out_of_core_memory);
+#endif
+#ifdef FNELEM_STATIC_ANALYSIS_CUDA
+    this->costs->set_cuda(true);
+#endif
 }
 
 /**
  * Destructor.
  */
 StaticAnalysis::~StaticAnalysis() {
-    if (this->ndof != 0) {
-        delete this->Kt;
-        delete this->u;
-        delete this->F;
-    }
+    this->delete_results();
+    delete this->Kt;
+    delete this->Kt_factorized;
+    delete this->invKt;
+    delete this->ebe;
+    delete this->pool;
+    delete this->amg;
+    delete this->gmg;
+    delete this->schur;
+    delete this->mixed;
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+    delete this->ooc;
+#endif
+    delete this->update;
+    delete this->solvers;
+    delete this->costs;
+    delete this->ldl;
+    delete this->skyline;
+    delete this->dense;
+    delete this->pcg;
+}
+
+/**
+ * Start static analysis using the selected solver backend.
+ */
+void StaticAnalysis::analyze() {
+    this->analyze(this->solver);
 }
 
 /**
  * Start static analysis.
  *
- * @param use_gpu Use GPU inversion
+ * @param solver Solver backend name, FNELEM_STATIC_ANALYSIS_SOLVER_AUTO selects it from the model size
  */
-void StaticAnalysis::analyze(bool use_gpu) {
+void StaticAnalysis::analyze(const std::string &solver) {
+
+    // Check solver
+    if (solver != FNELEM_STATIC_ANALYSIS_SOLVER_AUTO && !this->solvers->has(solver)) {
+        throw std::logic_error("[STATIC-ANALYSIS] Invalid solver " + solver);
+    }
 
     // Init timer
     std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
 
+    // Delete previous analysis
+    this->delete_results();
+
     // Define DOFID
     this->define_dof();
 
-    // Apply load patterns
-    this->model->apply_load_patterns();
+    // Select backend
+    std::string backend = solver;
+    if (backend == FNELEM_STATIC_ANALYSIS_SOLVER_AUTO) {
+        backend = this->select_solver();
+    }
+    this->last_solver = backend;
+
+    // Build analysis matrix data, each load pattern is a load case. If stiffness has not
+    // changed the stored matrix and factorization are used, if only a few stiffness rows
+    // changed the stored factorization is updated
+    bool updatable;
+    bool cached = this->check_factorization_cache(backend, &updatable);
+    bool updated = false;
+    this->cache_valid = false;
+    if (!cached && !this->solvers->requires_stiffness(backend)) {
+        this->build_element_operator();
+    } else if (!cached) {
+        this->build_stiffness_matrix();
+        updated = updatable && this->update_factorization(backend);
+    }
+    bool factorized = !cached && !updated;
+    if (factorized) {
+        this->update->clear();
+    }
+    this->build_force_matrix();
 
-    // Build analysis matrix data
-    this->build_stiffness_matrix();
-    this->build_force_vector();
+    // Solve matrix system, the registry stores the time of the backend
+    std::string method = this->solvers->solve(backend, !factorized);
+    if (this->update->is_active() && !this->correct_update()) { // Update is not accurate, factorize again
+        delete this->u_cases;
+        this->u_cases = nullptr;
+        this->update->clear();
+        cached = false;
+        updated = false;
+        factorized = true;
+        method = this->solvers->solve(backend, false);
+    }
+    method = "[" + backend + " " + std::to_string(this->solvers->get_last_time(backend)) + " microseconds]" +
+             (method.empty() ? "" : " " + method);
 
-    // Inverse matrix
-    FEMatrix *invKt;
-    std::string method;
-    if (!use_gpu) {
-        invKt = matrix_inverse_cpu(this->Kt);
-        method = "[GPU OFF]";
-    } else {
-        invKt = matrix_inverse_cuda(this->Kt);
-        method = "[GPU ON]";
+    // Stiffness of a new factorization is stored to compute the next low-rank update. Mixed
+    // precision refines the solution using the current stiffness, so it cannot be updated
+    if (factorized) {
+        delete this->Kt_factorized;
+        this->Kt_factorized = nullptr;
+        if (this->cache_enabled && this->update_max_rank > 0 && this->factorization_solve(backend) &&
+            backend != FNELEM_STATIC_ANALYSIS_SOLVER_MIXED) {
+            this->Kt_factorized = this->Kt->clone();
+        }
+    }
+
+    // Factorization can be used by the next analysis
+    this->cache_valid = true;
+    this->cache_used = cached;
+    this->update_used = updated;
+    if (cached) {
+        method += " [CACHED]";
+    }
+    if (this->update->is_active()) {
+        method += " [LOW-RANK UPDATE " + std::to_string(this->update->get_rank()) + " rows]";
     }
 
-    // Solve matrix system
-    this->u = *invKt * *this->F;
-    delete invKt;
+    // Loads are linear, displacements of all load cases are superposed
+    this->u = this->superpose_load_cases(this->u_cases);
 
     // Update model
     this->model->update(this->u);
@@ -100,193 +187,1800 @@ void StaticAnalysis::analyze(bool use_gpu) {
 }
 
 /**
- * Return matrix stiffness.
+ * Register built-in solver backends. The CUDA backend is only registered if the library
+ * is compiled by nvcc, the out of core backend if memory-mapped files are supported.
+ */
+void StaticAnalysis::register_solvers() {
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_LDL, "Sparse LDL' factorization", true,
+                       [this](bool cached) { return this->solver_ldl(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_PCG, "Conjugate gradient, Jacobi preconditioner", true,
+                       [this](bool cached) { return this->solver_pcg(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE, "Skyline LDL' factorization", true,
+                       [this](bool cached) { return this->solver_skyline(cached); });
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_OUT_OF_CORE, "Skyline LDL' factorization, memory-mapped files",
+                       true, [this](bool cached) { return this->solver_out_of_core(cached); });
+#endif
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_DENSE, "Dense Cholesky or LU factorization", true,
+                       [this](bool cached) { return this->solver_dense(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_MATRIX_FREE, "Element by element conjugate gradient", false,
+                       [this](bool cached) { return this->solver_matrix_free(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_AMG, "Conjugate gradient, algebraic multigrid", true,
+                       [this](bool cached) { return this->solver_amg(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_GMG, "Conjugate gradient, geometric multigrid", true,
+                       [this](bool cached) { return this->solver_gmg(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE, "Multithreaded substructuring", true,
+                       [this](bool cached) { return this->solver_substructure(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_MIXED, "Single precision LDL' and refinement", true,
+                       [this](bool cached) { return this->solver_mixed(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN, "Dense Gauss-Jordan inversion, CPU", true,
+                       [this](bool cached) { return this->solver_gauss_jordan(cached); });
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN_THREADED, "Dense Gauss-Jordan inversion, host threads",
+                       true, [this](bool cached) { return this->solver_gauss_jordan_threaded(cached); });
+#ifdef FNELEM_STATIC_ANALYSIS_CUDA
+    this->solvers->add(FNELEM_STATIC_ANALYSIS_SOLVER_CUDA, "Dense Gauss-Jordan inversion, GPU", true,
+                       [this](bool cached) { return this->solver_cuda(cached); });
+#endif
+}
+
+/**
+ * Select solver backend if automatic selection is used. The cost model estimates the work
+ * and memory of each candidate from the stiffness pattern and the number of load cases,
+ * the selection is kept while both do not change.
  *
- * @return
+ * @return Backend name
  */
-FEMatrix *StaticAnalysis::get_stiffness_matrix() const {
-    if (this->ndof == 0) {
-        return nullptr;
-    } else {
-        return this->Kt->clone();
+std::string StaticAnalysis::select_solver() {
+    unsigned long long topology = this->topology_fingerprint();
+    int nrhs = static_cast<int>(this->model->get_load_patterns()->size());
+    if (!this->costs->get_selected().empty() && this->costs_topology == topology && this->costs_nrhs == nrhs) {
+        return this->costs->get_selected();
+    }
+
+    // Estimate candidates
+    std::vector<std::vector<int>> *pattern = this->build_stiffness_pattern();
+    long element_values = 0;
+    for (auto &element : *this->model->get_elements()) {
+        element_values += static_cast<long>(element->get_ndof()) * element->get_ndof();
     }
+    this->costs->estimate(this->ndof, pattern, element_values, nrhs);
+    delete pattern;
+
+    // Select
+    std::string backend = this->costs->select();
+    this->costs_topology = topology;
+    this->costs_nrhs = nrhs;
+    std::cout << "[STATIC-ANALYSIS] Automatic solver " << this->costs->get_reason() << std::endl;
+    return backend;
 }
 
 /**
- * Return displacement vector.
+ * Sparse LDL' factorization, inverse matrix is never built. Symbolic factorization is
+ * kept while the stiffness pattern does not change, so only the numeric factorization
+ * is redone.
  *
+ * @param cached Stored factorization can be used
  * @return
  */
-FEMatrix *StaticAnalysis::get_displacements_vector() const {
-    if (this->ndof == 0) {
-        return nullptr;
-    } else {
-        return this->u->clone();
+std::string StaticAnalysis::solver_ldl(bool cached) {
+    if (this->ldl == nullptr) {
+        this->ldl = new SparseLDL();
     }
+    if (!cached) {
+        this->ldl->factorize(this->Kt);
+    }
+    this->u_cases = this->ldl->solve(this->F_cases);
+    return "";
 }
 
 /**
- * Return force vector.
+ * Iterative solver, only uses the assembled stiffness.
  *
+ * @param cached Stored factorization can be used
  * @return
  */
-FEMatrix *StaticAnalysis::get_force_vector() const {
-    if (this->ndof == 0) {
-        return nullptr;
-    } else {
-        return this->F->clone();
+std::string StaticAnalysis::solver_pcg(bool /* cached */) {
+    std::vector<double> diagonal(static_cast<unsigned long>(this->ndof));
+    for (int i = 0; i < this->ndof; i++) {
+        diagonal[i] = this->Kt->get(i, i);
     }
+    FEMatrixSparse *K = this->Kt;
+    int iterations = this->solve_pcg([K](const double *x, double *y) { K->multiply(x, y); }, diagonal.data());
+    return "[PCG " + std::to_string(iterations) + " iterations]";
 }
 
 /**
- * Return number of degrees of freedom.
+ * Iterative solver, the multigrid hierarchy is built from the assembled stiffness.
  *
+ * @param cached Stored factorization can be used
  * @return
  */
-int StaticAnalysis::get_ndof() const {
-    return this->ndof;
+std::string StaticAnalysis::solver_amg(bool cached) {
+    if (!cached) {
+        std::vector<int> blocks;
+        FEMatrix *B = this->build_rigid_body_modes(&blocks);
+        this->amg->setup(this->Kt, &blocks, B);
+        delete B;
+    }
+    FEMatrixSparse *K = this->Kt;
+    AMGPreconditioner *M = this->amg;
+    PCGOperator precond = [M](const double *r, double *z) { M->apply(r, z); };
+    int iterations = this->solve_pcg([K](const double *x, double *y) { K->multiply(x, y); }, nullptr, &precond);
+    return "[AMG-PCG " + std::to_string(iterations) + " iterations, " + std::to_string(this->amg->get_levels()) +
+           " levels]";
 }
 
 /**
- * Return yes/no.
+ * Iterative solver, the multigrid hierarchy is built from the grid lines.
  *
- * @param v Boolean variable
+ * @param cached Stored factorization can be used
  * @return
  */
-std::string StaticAnalysis::yes_no(bool v) const {
-    if (v) {
-        return "yes";
-    } else {
-        return "no";
+std::string StaticAnalysis::solver_gmg(bool cached) {
+    if (!cached) {
+        std::vector<double> x, y;
+        std::vector<int> dof;
+        if (!this->build_structured_grid(&x, &y, &dof)) {
+            throw std::logic_error("[STATIC-ANALYSIS] Geometric multigrid requires a structured grid of "
+                                   "rectangular elements");
+        }
+        this->gmg->setup(this->Kt, &x, &y, &dof);
     }
+    FEMatrixSparse *K = this->Kt;
+    GMGPreconditioner *M = this->gmg;
+    PCGOperator precond = [M](const double *r, double *z) { M->apply(r, z); };
+    int iterations = this->solve_pcg([K](const double *x, double *y) { K->multiply(x, y); }, nullptr, &precond);
+    return "[GMG-PCG " + std::to_string(iterations) + " iterations, " + std::to_string(this->gmg->get_levels()) +
+           " levels]";
 }
 
 /**
- * Display static analysis on console.
+ * Substructuring, domains are condensed onto their interface and recovered in parallel.
+ *
+ * @param cached Stored factorization can be used
+ * @return
  */
-void StaticAnalysis::disp() const {
-    std::cout << "Static analysis information:" << std::endl;
-    if (this->ndof == 0) {
-        std::cout << "\tAnalysis is not yet initialized" << std::endl;
-        return;
+std::string StaticAnalysis::solver_substructure(bool cached) {
+    if (!cached) {
+        this->build_schur_solver();
     }
+    this->u_cases = this->schur->solve(this->F_cases);
+    return "[SUBSTRUCTURE " + std::to_string(this->schur->get_domains()) + " domains, " +
+           std::to_string(this->schur->get_interface_dimension()) + " interface DOF]";
+}
 
-    std::cout << "\tStiffness matrix:" << std::endl;
-    this->Kt->set_disp_identation(2);
-    this->Kt->disp();
-    this->Kt->set_disp_identation(0);
-    std::cout << "\tStiffness determinant: " << this->Kt->det() << std::endl;
-    std::cout << "\tStiffness symmetric: " << this->yes_no(this->Kt->is_symmetric()) << std::endl;
+/**
+ * Single precision factorization, double precision accuracy by iterative refinement.
+ *
+ * @param cached Stored factorization can be used
+ * @return
+ */
+std::string StaticAnalysis::solver_mixed(bool cached) {
+    if (!cached) {
+        this->mixed->factorize(this->Kt);
+    }
+    this->u_cases = this->mixed->solve(this->F_cases);
+    if (this->mixed->is_fallback()) {
+        return "[MIXED PRECISION, DOUBLE FALLBACK]";
+    }
+    return "[MIXED PRECISION " + std::to_string(this->mixed->get_refinement_steps()) + " refinement steps]";
+}
 
-    std::cout << "\tForce vector:" << std::endl;
-    this->F->set_disp_identation(2);
-    this->F->disp();
-    this->F->set_disp_identation(0);
+/**
+ * Iterative solver, products are computed element by element.
+ *
+ * @param cached Stored factorization can be used
+ * @return
+ */
+std::string StaticAnalysis::solver_matrix_free(bool /* cached */) {
+    ElementOperator *K = this->ebe;
+    int iterations = this->solve_pcg([K](const double *x, double *y) { K->multiply(x, y); },
+                                     this->ebe->get_diagonal());
+    return "[MATRIX-FREE PCG " + std::to_string(iterations) + " iterations]";
+}
 
-    std::cout << "\tDisplacements vector:" << std::endl;
-    this->u->set_disp_identation(2);
-    this->u->disp();
-    this->u->set_disp_identation(0);
+/**
+ * Skyline LDL' factorization, work depends on the profile.
+ *
+ * @param cached Stored factorization can be used
+ * @return
+ */
+std::string StaticAnalysis::solver_skyline(bool cached) {
+    if (!cached) {
+        delete this->skyline;
+        this->skyline = new FEMatrixSkyline(this->Kt);
+        this->skyline->factorize();
+    }
+    this->u_cases = this->skyline->solve(this->F_cases);
+    return "[SKYLINE profile " + std::to_string(this->skyline->get_profile()) + "]";
 }
 
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
 /**
- * Start dof numbering.
+ * Skyline LDL' factorization stored out of core, only the panels within the memory budget
+ * are mapped in memory.
+ *
+ * @param cached Stored factorization can be used
+ * @return
  */
-void StaticAnalysis::define_dof() {
+std::string StaticAnalysis::solver_out_of_core(bool cached) {
+    if (!cached) {
+        delete this->ooc;
+        this->ooc = nullptr;
+        this->ooc = new OutOfCoreSkyline(this->Kt, this->out_of_core_memory, this->out_of_core_directory);
+        this->ooc->factorize();
+    }
+    this->u_cases = this->ooc->solve(this->F_cases);
+    return "[OUT-OF-CORE " + std::to_string(this->ooc->get_panels()) + " panels, " +
+           std::to_string(this->ooc->get_file_bytes() / 1024) + " KB file]";
+}
 
-    // Apply model restraints
-    this->model->apply_restraints();
+#endif
 
-    // Check each node, then assign node DOFID
-    std::vector<Node *> *nodes = this->model->get_nodes();
-    FEMatrix *dof;
-    int dof_count = 0;
-    for (auto &node : *nodes) {
-        dof = node->get_dofid();
-        for (int i = 0; i < dof->length(); i++) {
-            if (fabs(dof->get(i) + 1) > FNELEM_CONST_ZERO_TOLERANCE) {
-                dof_count += 1;
-                node->set_dof(i + 1, dof_count);
-            }
+/**
+ * Dense blocked Cholesky, LU is used if the matrix is not positive definite.
+ *
+ * @param cached Stored factorization can be used
+ * @return
+ */
+std::string StaticAnalysis::solver_dense(bool cached) {
+    if (this->dense == nullptr) {
+        this->dense = new FEMatrixFactorization();
+    }
+    if (!cached) {
+        FEMatrix *Ktdense = this->Kt->to_dense();
+        try {
+            this->dense->cholesky(Ktdense);
+        } catch (const std::logic_error &e) {
+            this->dense->lu(Ktdense);
         }
-        delete dof;
+        delete Ktdense;
     }
-    this->ndof = dof_count;
+    this->u_cases = this->dense->solve(this->F_cases);
+    if (this->dense->get_type() == FEMATRIX_FACTORIZATION_CHOLESKY) {
+        return "[DENSE CHOLESKY]";
+    }
+    return "[DENSE LU]";
+}
 
-    // Update element dofid
-    std::vector<Element *> *elements = this->model->get_elements();
-    for (auto &element : *elements) {
-        element->set_dofid();
+/**
+ * Inverse matrix, CPU inversion works over the dense stiffness.
+ *
+ * @param cached Stored factorization can be used
+ * @return
+ */
+std::string StaticAnalysis::solver_gauss_jordan(bool cached) {
+    if (!cached) {
+        FEMatrix *Ktdense = this->Kt->to_dense();
+        delete this->invKt;
+        this->invKt = matrix_inverse_cpu(Ktdense);
+        delete Ktdense;
     }
+    this->u_cases = new FEMatrix();
+    this->invKt->multiply(*this->F_cases, *this->u_cases);
+    return "";
+}
 
+/**
+ * Inverse matrix, uses the CUDA Gauss-Jordan kernels over the analysis threads.
+ *
+ * @param cached Stored factorization can be used
+ * @return
+ */
+std::string StaticAnalysis::solver_gauss_jordan_threaded(bool cached) {
+    if (!cached) {
+        if (this->assembly_threads != 1 && this->pool == nullptr) {
+            this->pool = new ThreadPool(this->assembly_threads);
+        }
+        FEMatrix Ktdense;
+        this->Kt->to_dense(Ktdense);
+        delete this->invKt;
+        this->invKt = nullptr;
+        this->invKt = matrix_inverse_threaded(&Ktdense, this->assembly_threads != 1 ? this->pool : nullptr);
+    }
+    this->u_cases = new FEMatrix();
+    this->invKt->multiply(*this->F_cases, *this->u_cases, this->assembly_threads != 1 ? this->pool : nullptr);
+    return "";
 }
 
+#ifdef FNELEM_STATIC_ANALYSIS_CUDA
+
 /**
- * Build stiffness matrix.
+ * Inverse matrix, GPU inversion works over the dense stiffness.
+ *
+ * @param cached Stored factorization can be used
+ * @return
  */
-void StaticAnalysis::build_stiffness_matrix() {
+std::string StaticAnalysis::solver_cuda(bool cached) {
+    if (!cached) {
+        FEMatrix *Ktdense = this->Kt->to_dense();
+        delete this->invKt;
+        this->invKt = matrix_inverse_cuda(Ktdense);
+        delete Ktdense;
+    }
+    this->u_cases = new FEMatrix();
+    this->invKt->multiply(*this->F_cases, *this->u_cases);
+    return "[GPU ON]";
+}
 
-    // Create stiffness matrix
-    this->Kt = new FEMatrix(this->ndof, this->ndof);
-    Kt->set_origin(1);
+#endif
 
-    std::vector<Element *> *elements = this->model->get_elements();
-    FEMatrix *dofid;
-    FEMatrix *Ktelem;
-    int ndof, i, j;
-    for (auto &element : *elements) {
+/**
+ * Select solver backend used by the next analysis.
+ *
+ * @param solver Backend name, FNELEM_STATIC_ANALYSIS_SOLVER_AUTO selects it from the model size
+ */
+void StaticAnalysis::set_solver(const std::string &solver) {
+    if (solver != FNELEM_STATIC_ANALYSIS_SOLVER_AUTO && !this->solvers->has(solver)) {
+        throw std::logic_error("[STATIC-ANALYSIS] Invalid solver " + solver);
+    }
+    this->solver = solver;
+}
 
-        dofid = element->get_dofid();
-        dofid->set_origin(1);
-        ndof = element->get_ndof();
-        Ktelem = element->get_stiffness_global();
-        Ktelem->set_origin(1);
+/**
+ * Return selected solver backend.
+ *
+ * @return
+ */
+std::string StaticAnalysis::get_solver() const {
+    return this->solver;
+}
 
-        // Performs index method
-        for (int r = 1; r <= ndof; r++) {
-            for (int s = 1; s <= ndof; s++) {
-                i = static_cast<int>(dofid->get(r));
-                j = static_cast<int>(dofid->get(s));
+/**
+ * Return solver backend used by the last analysis, if automatic selection is used it
+ * returns the chosen backend.
+ *
+ * @return
+ */
+std::string StaticAnalysis::get_last_solver() const {
+    return this->last_solver;
+}
 
-                if (i != -1 && j != -1) {
-                    this->Kt->set(i, j, this->Kt->get(i, j) + Ktelem->get(r, s));
-                }
-            }
+/**
+ * Register user defined solver backend. The function receives the assembled stiffness
+ * matrix and the force matrix, and must return a new displacement matrix.
+ *
+ * @param name Backend name
+ * @param description Backend description
+ * @param function Solver function
+ */
+void StaticAnalysis::add_solver(const std::string &name, const std::string &description,
+                                const SolverFunction &function) {
+    if (name == FNELEM_STATIC_ANALYSIS_SOLVER_AUTO) {
+        throw std::logic_error("[STATIC-ANALYSIS] Solver backend name is reserved");
+    }
+    if (!function) {
+        throw std::logic_error("[STATIC-ANALYSIS] Solver function cannot be empty");
+    }
+    this->solvers->add(name, description, true, [this, name, function](bool cached) {
+        this->u_cases = function(this->Kt, this->F_cases, cached);
+        if (this->u_cases == nullptr) {
+            throw std::logic_error("[STATIC-ANALYSIS] Solver backend " + name + " did not return displacements");
+        }
+        int *dim = this->u_cases->size();
+        bool valid = dim[0] == this->ndof && dim[1] == this->nloadcases;
+        delete[] dim;
+        if (!valid) {
+            throw std::logic_error("[STATIC-ANALYSIS] Solver backend " + name +
+                                   " displacements dimension does not agree");
         }
+        return std::string();
+    });
+}
+
+/**
+ * Return solver cost model, used to set the memory limit of the automatic selection and
+ * to get the estimates of the last selection.
+ *
+ * @return
+ */
+SolverCostModel *StaticAnalysis::get_solver_cost_model() const {
+    return this->costs;
+}
+
+/**
+ * Return solver registry, used to list the backends and get the time of their last solution.
+ *
+ * @return
+ */
+SolverRegistry *StaticAnalysis::get_solver_registry() const {
+    return this->solvers;
+}
+
+/**
+ * Return iterative solver, it can be used to configure the tolerance, the max number of
+ * iterations and to get the convergence history of the last analysis.
+ *
+ * @return
+ */
+PCGSolver *StaticAnalysis::get_pcg_solver() const {
+    return this->pcg;
+}
+
+/**
+ * Return algebraic multigrid preconditioner, used to configure the hierarchy.
+ *
+ * @return
+ */
+AMGPreconditioner *StaticAnalysis::get_amg_preconditioner() const {
+    return this->amg;
+}
+
+/**
+ * Return geometric multigrid preconditioner, used to configure the hierarchy.
+ *
+ * @return
+ */
+GMGPreconditioner *StaticAnalysis::get_gmg_preconditioner() const {
+    return this->gmg;
+}
+
+/**
+ * Return mixed precision solver, used to configure the refinement and to get the
+ * refinement steps of the last analysis.
+ *
+ * @return
+ */
+MixedPrecisionSolver *StaticAnalysis::get_mixed_precision_solver() const {
+    return this->mixed;
+}
 
-        delete Ktelem;
-        delete dofid;
+/**
+ * Set number of substructures, elements are split automatically by their height.
+ *
+ * @param n Number of substructures
+ */
+void StaticAnalysis::set_substructures(int n) {
+    if (n < 1) {
+        throw std::logic_error("[STATIC-ANALYSIS] Number of substructures must be greater than zero");
     }
-    Kt->set_origin(0);
+    this->substructures = n;
+    this->substructure_elements.clear();
+    this->cache_valid = false;
+}
 
+/**
+ * Set substructure of each element.
+ *
+ * @param element_domain Substructure of each element, following model order
+ */
+void StaticAnalysis::set_substructures(const std::vector<int> *element_domain) {
+    this->substructure_elements = *element_domain;
+    this->cache_valid = false;
 }
 
 /**
- * Build force vector.
+ * Return substructuring solver of the last analysis.
+ *
+ * @return
  */
-void StaticAnalysis::build_force_vector() {
+SchurSolver *StaticAnalysis::get_schur_solver() const {
+    return this->schur;
+}
 
-    // Create force
-    this->F = FEMatrix_vector(this->ndof);
-    this->F->set_origin(1);
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
 
-    FEMatrix *dofid;
-    int ndof;
-    std::vector<Node *> *nodes = this->model->get_nodes();
-    for (auto &node : *nodes) {
-        dofid = node->get_dofid();
-        dofid->set_origin(0);
-        ndof = node->get_ndof();
-        for (int i = 0; i < ndof; i++) {
-            if (fabs(dofid->get(i) + 1) > FNELEM_CONST_ZERO_TOLERANCE) {
-                F->set(static_cast<int>(dofid->get(i)),
-                       F->get(static_cast<int>(dofid->get(i))) - node->get_reaction(i + 1));
-            }
-        }
-        delete dofid;
+/**
+ * Set memory budget of the out of core factorization, two panels of the factor fit within
+ * the budget. The automatic selection uses it to estimate the out of core memory.
+ *
+ * @param bytes Memory budget in bytes
+ */
+void StaticAnalysis::set_out_of_core_memory(long bytes) {
+    if (bytes <= 0) {
+        throw std::logic_error("[STATIC-ANALYSIS] Out of core memory budget must be greater than zero");
+    }
+    this->out_of_core_memory = bytes;
+    this->costs->set_out_of_core_memory(bytes);
+}
+
+/**
+ * Set directory of the out of core factor file, it should be on a local disk. If empty the
+ * temporary directory of the platform is used.
+ *
+ * @param directory Directory path
+ */
+void StaticAnalysis::set_out_of_core_directory(const std::string &directory) {
+    this->out_of_core_directory = directory;
+}
+
+/**
+ * Return out of core factorization of the last analysis.
+ *
+ * @return
+ */
+OutOfCoreSkyline *StaticAnalysis::get_out_of_core_solver() const {
+    return this->ooc;
+}
+
+#endif
+
+/**
+ * Return matrix stiffness.
+ *
+ * @return
+ */
+FEMatrix *StaticAnalysis::get_stiffness_matrix() const {
+    if (this->ndof == 0 || this->Kt == nullptr) {
+        return nullptr;
+    } else {
+        return this->Kt->to_dense();
     }
-    this->F->set_origin(0);
+}
 
+/**
+ * Return sparse matrix stiffness, only lower triangle is stored.
+ *
+ * @return
+ */
+FEMatrixSparse *StaticAnalysis::get_stiffness_matrix_sparse() const {
+    if (this->ndof == 0 || this->Kt == nullptr) {
+        return nullptr;
+    } else {
+        return this->Kt->clone();
+    }
+}
+
+/**
+ * Return logarithm of the absolute determinant of the stiffness matrix. If the last analysis
+ * used a factorization of the stiffness it is reused, else, the sparse stiffness is factorized.
+ *
+ * @param sign Sign of the determinant, -1 or 1, zero if the stiffness is singular
+ * @return Logarithm of the absolute determinant, -infinity if the stiffness is singular
+ */
+double StaticAnalysis::get_stiffness_log_det(int *sign) const {
+    if (this->ndof == 0 || this->Kt == nullptr) {
+        throw std::logic_error("[STATIC-ANALYSIS] Stiffness matrix is not assembled");
+    }
+
+    // Stored factorization, the low-rank update multiplies by the capacitance determinant
+    if (this->cache_valid && this->factorization_solve(this->last_solver)) {
+        double logdet = 0;
+        if (this->last_solver == FNELEM_STATIC_ANALYSIS_SOLVER_LDL) {
+            logdet = this->ldl->log_det(sign);
+        } else if (this->last_solver == FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE) {
+            logdet = this->skyline->log_det(sign);
+        } else if (this->last_solver == FNELEM_STATIC_ANALYSIS_SOLVER_DENSE) {
+            logdet = this->dense->log_det(sign);
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+        } else if (this->last_solver == FNELEM_STATIC_ANALYSIS_SOLVER_OUT_OF_CORE) {
+            logdet = this->ooc->log_det(sign);
+#endif
+        } else {
+            logdet = this->mixed->log_det(sign);
+        }
+        int update_sign;
+        logdet += this->update->log_det(&update_sign);
+        *sign *= update_sign;
+        return logdet;
+    }
+
+    // Factorize stiffness
+    SparseLDL fact;
+    try {
+        fact.factorize(this->Kt);
+    } catch (const std::logic_error &e) {
+        *sign = 0;
+        return -std::numeric_limits<double>::infinity();
+    }
+    return fact.log_det(sign);
+}
+
+/**
+ * Estimates the 1-norm condition number of the stiffness matrix. The norm of the inverse is
+ * estimated with Hager's method, each iteration solves the system using the factorization
+ * of the last analysis. If the solver did not factorize the stiffness, a sparse LDL'
+ * factorization is computed.
+ *
+ * @param nsolves Returns the number of solves, can be nullptr
+ * @return Condition number estimate, infinity if the stiffness is singular
+ */
+double StaticAnalysis::get_stiffness_condition(int *nsolves) const {
+    if (this->ndof == 0 || this->Kt == nullptr) {
+        throw std::logic_error("[STATIC-ANALYSIS] Stiffness matrix is not assembled");
+    }
+
+    // Stiffness is symmetric, the same solve is used for the transpose
+    ConditionSolve solve;
+    SparseLDL fact;
+    LowRankSolve stored = this->cache_valid ? this->factorization_solve(this->last_solver) : nullptr;
+    if (stored) {
+        const LowRankUpdate *update = this->update;
+        solve = [stored, update](double *x) {
+            stored(x, 1);
+            update->solve(x, 1);
+        };
+    } else {
+        try {
+            fact.factorize(this->Kt);
+        } catch (const std::logic_error &e) {
+            if (nsolves != nullptr) *nsolves = 0;
+            return std::numeric_limits<double>::infinity();
+        }
+        solve = [&fact](double *x) { fact.solve(x); };
+    }
+    return condition_norm1(this->Kt) * condition_inverse_norm1(this->ndof, solve, nullptr, nsolves);
+}
+
+/**
+ * Return displacement vector.
+ *
+ * @return
+ */
+FEMatrix *StaticAnalysis::get_displacements_vector() const {
+    if (this->ndof == 0) {
+        return nullptr;
+    } else {
+        return this->u->clone();
+    }
+}
+
+/**
+ * Return force vector.
+ *
+ * @return
+ */
+FEMatrix *StaticAnalysis::get_force_vector() const {
+    if (this->ndof == 0) {
+        return nullptr;
+    } else {
+        return this->F->clone();
+    }
+}
+
+/**
+ * Return force matrix, each column stores a load case.
+ *
+ * @return
+ */
+FEMatrix *StaticAnalysis::get_force_matrix() const {
+    if (this->ndof == 0) {
+        return nullptr;
+    } else {
+        return this->F_cases->clone();
+    }
+}
+
+/**
+ * Return displacements matrix, each column stores a load case.
+ *
+ * @return
+ */
+FEMatrix *StaticAnalysis::get_displacements_matrix() const {
+    if (this->ndof == 0) {
+        return nullptr;
+    } else {
+        return this->u_cases->clone();
+    }
+}
+
+/**
+ * Return number of load cases.
+ *
+ * @return
+ */
+int StaticAnalysis::get_number_load_cases() const {
+    return this->nloadcases;
+}
+
+/**
+ * Return number of degrees of freedom.
+ *
+ * @return
+ */
+int StaticAnalysis::get_ndof() const {
+    return this->ndof;
+}
+
+/**
+ * Return yes/no.
+ *
+ * @param v Boolean variable
+ * @return
+ */
+std::string StaticAnalysis::yes_no(bool v) const {
+    if (v) {
+        return "yes";
+    } else {
+        return "no";
+    }
+}
+
+/**
+ * Display static analysis on console.
+ */
+void StaticAnalysis::disp() const {
+    std::cout << "Static analysis information:" << std::endl;
+    if (this->ndof == 0) {
+        std::cout << "\tAnalysis is not yet initialized" << std::endl;
+        return;
+    }
+
+    if (this->Kt != nullptr) {
+        std::cout << "\tStiffness matrix:" << std::endl;
+        FEMatrix *Ktdense = this->Kt->to_dense();
+        Ktdense->set_disp_identation(2);
+        Ktdense->disp();
+        std::cout << "\tStiffness non-zero values: " << this->Kt->get_nnz() << std::endl;
+        int sign, nsolves;
+        double logdet = this->get_stiffness_log_det(&sign);
+        double cond = this->get_stiffness_condition(&nsolves);
+        std::cout << "\tStiffness log determinant: " << logdet << ", sign " << sign << std::endl;
+        std::cout << "\tStiffness condition number (1-norm estimate): " << cond << ", " << nsolves
+                  << " solves" << std::endl;
+        std::cout << "\tStiffness symmetric: " << this->yes_no(Ktdense->is_symmetric()) << std::endl;
+        delete Ktdense;
+    } else {
+        std::cout << "\tStiffness matrix is not assembled, element values: " << this->ebe->get_number_values()
+                  << std::endl;
+    }
+
+    std::cout << "\tSolver: " << this->last_solver << std::endl;
+    std::cout << "\tLoad cases: " << this->nloadcases << std::endl;
+    std::cout << "\tForce vector:" << std::endl;
+    this->F->set_disp_identation(2);
+    this->F->disp();
+    this->F->set_disp_identation(0);
+
+    std::cout << "\tDisplacements vector:" << std::endl;
+    this->u->set_disp_identation(2);
+    this->u->disp();
+    this->u->set_disp_identation(0);
+}
+
+/**
+ * Start dof numbering. Nodes are numbered following model order, if a numbering method
+ * is defined, the nodes are renumbered using the node adjacency graph.
+ */
+void StaticAnalysis::define_dof() {
+
+    // Apply model restraints
+    this->model->apply_restraints();
+
+    // Number nodes following model order
+    this->number_dof(nullptr);
+    this->calculate_bandwidth_profile();
+    if (this->numbering == FNELEM_STATIC_ANALYSIS_NUMBERING_NONE) {
+        return;
+    }
+
+    // Compute new node order
+    int bandwidth_model = this->bandwidth;
+    long profile_model = this->profile;
+    std::vector<std::vector<int>> *graph = this->build_node_graph();
+    std::vector<int> *order;
+    std::string method;
+    if (this->numbering == FNELEM_STATIC_ANALYSIS_NUMBERING_RCM) {
+        order = ordering_rcm(graph);
+        method = "RCM";
+    } else {
+        order = ordering_minimum_degree(graph);
+        method = "MINIMUM DEGREE";
+    }
+
+    // Renumber nodes
+    this->number_dof(order);
+    this->calculate_bandwidth_profile();
+    delete graph;
+    delete order;
+
+    std::cout << "[STATIC-ANALYSIS] DOF numbering " << method << ", bandwidth " << bandwidth_model << " -> "
+              << this->bandwidth << ", profile " << profile_model << " -> " << this->profile << std::endl;
+
+}
+
+/**
+ * Assign node DOFID, restrained DOF (-1) are not numbered.
+ *
+ * @param order Node order, nullptr uses model order
+ */
+void StaticAnalysis::number_dof(std::vector<int> *order) {
+
+    // Check each node, then assign node DOFID
+    std::vector<Node *> *nodes = this->model->get_nodes();
+    Node *node;
+    FEMatrix *dof;
+    int dof_count = 0;
+    for (unsigned long k = 0; k < nodes->size(); k++) {
+        if (order == nullptr) {
+            node = nodes->at(k);
+        } else {
+            node = nodes->at(static_cast<unsigned long>(order->at(k)));
+        }
+        dof = node->get_dofid();
+        for (int i = 0; i < dof->length(); i++) {
+            if (fabs(dof->get(i) + 1) > FNELEM_CONST_ZERO_TOLERANCE) {
+                dof_count += 1;
+                node->set_dof(i + 1, dof_count);
+            }
+        }
+        delete dof;
+    }
+    this->ndof = dof_count;
+
+    // Update element dofid
+    std::vector<Element *> *elements = this->model->get_elements();
+    for (auto &element : *elements) {
+        element->set_dofid();
+    }
+
+}
+
+/**
+ * Build node adjacency graph, two nodes are adjacent if they share an element.
+ *
+ * @return Adjacency list, vertices follow model node order
+ */
+std::vector<std::vector<int>> *StaticAnalysis::build_node_graph() const {
+
+    // Node position within model
+    std::vector<Node *> *nodes = this->model->get_nodes();
+    std::unordered_map<Node *, int> node_index;
+    for (unsigned long k = 0; k < nodes->size(); k++) {
+        node_index[nodes->at(k)] = static_cast<int>(k);
+    }
+
+    // Connect element nodes
+    std::vector<std::vector<int>> *graph = new std::vector<std::vector<int>>(nodes->size());
+    std::vector<Element *> *elements = this->model->get_elements();
+    std::vector<int> elem_nodes;
+    for (auto &element : *elements) {
+        elem_nodes.clear();
+        for (auto &node : *element->get_nodes()) {
+            elem_nodes.push_back(node_index.at(node));
+        }
+        for (int a : elem_nodes) {
+            for (int b : elem_nodes) {
+                if (a != b) graph->at(static_cast<unsigned long>(a)).push_back(b);
+            }
+        }
+    }
+    return graph;
+
+}
+
+/**
+ * Calculate bandwidth and profile of the stiffness matrix using element DOFID. For each
+ * row i the first coupled column f(i) is found, bandwidth is max(i - f(i)) and profile is
+ * the sum of (i - f(i)).
+ */
+void StaticAnalysis::calculate_bandwidth_profile() {
+
+    // First coupled column of each row
+    std::vector<int> first(static_cast<unsigned long>(this->ndof));
+    for (int i = 0; i < this->ndof; i++) {
+        first[i] = i;
+    }
+    std::vector<Element *> *elements = this->model->get_elements();
+    FEMatrix dofid;
+    int ndof, i, dmin;
+    for (auto &element : *elements) {
+        element->get_dofid(dofid);
+        ndof = element->get_ndof();
+        dmin = this->ndof;
+        for (int r = 0; r < ndof; r++) {
+            i = static_cast<int>(dofid.get(r));
+            if (i > 0) dmin = std::min(dmin, i - 1);
+        }
+        for (int r = 0; r < ndof; r++) {
+            i = static_cast<int>(dofid.get(r));
+            if (i > 0) first[i - 1] = std::min(first[i - 1], dmin);
+        }
+    }
+
+    // Compute bandwidth and profile
+    this->bandwidth = 0;
+    this->profile = 0;
+    for (i = 0; i < this->ndof; i++) {
+        this->bandwidth = std::max(this->bandwidth, i - first[i]);
+        this->profile += i - first[i];
+    }
+
+}
+
+/**
+ * Set DOF numbering method.
+ *
+ * @param method FNELEM_STATIC_ANALYSIS_NUMBERING_NONE, RCM or MINDEGREE
+ */
+void StaticAnalysis::set_dof_numbering(int method) {
+    if (method != FNELEM_STATIC_ANALYSIS_NUMBERING_NONE && method != FNELEM_STATIC_ANALYSIS_NUMBERING_RCM &&
+        method != FNELEM_STATIC_ANALYSIS_NUMBERING_MINDEGREE) {
+        throw std::logic_error("[STATIC-ANALYSIS] Invalid DOF numbering method");
+    }
+    this->numbering = method;
+}
+
+/**
+ * Return stiffness matrix bandwidth of the last analysis.
+ *
+ * @return
+ */
+int StaticAnalysis::get_bandwidth() const {
+    return this->bandwidth;
+}
+
+/**
+ * Return stiffness matrix profile of the last analysis.
+ *
+ * @return
+ */
+long StaticAnalysis::get_profile() const {
+    return this->profile;
+}
+
+/**
+ * Build stiffness matrix pattern, each row stores the columns coupled by the elements. As
+ * stiffness matrix is symmetric only the lower triangle is stored.
+ *
+ * @return Vector of rows, indices start from zero
+ */
+std::vector<std::vector<int>> *StaticAnalysis::build_stiffness_pattern() const {
+
+    // Create rows
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(
+            static_cast<unsigned long>(this->ndof));
+
+    std::vector<Element *> *elements = this->model->get_elements();
+    FEMatrix dofid;
+    int ndof, i, j;
+    for (auto &element : *elements) {
+        element->get_dofid(dofid);
+        dofid.set_origin(1);
+        ndof = element->get_ndof();
+        for (int r = 1; r <= ndof; r++) {
+            i = static_cast<int>(dofid.get(r));
+            if (i == -1) continue;
+            for (int s = 1; s <= ndof; s++) {
+                j = static_cast<int>(dofid.get(s));
+                if (j != -1 && j <= i) {
+                    pattern->at(static_cast<unsigned long>(i - 1)).push_back(j - 1);
+                }
+            }
+        }
+    }
+
+    // Sort each row and remove duplicates
+    for (auto &row : *pattern) {
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    }
+    return pattern;
+
+}
+
+/**
+ * Build stiffness matrix. If more than one assembly thread is used, elements are colored
+ * so that elements of the same color do not share nodes, then each color is assembled in
+ * parallel. Elements of the same color update different stiffness values, so no locks
+ * are needed.
+ */
+void StaticAnalysis::build_stiffness_matrix() {
+
+    // Create stiffness matrix from element connectivity
+    std::vector<std::vector<int>> *pattern = this->build_stiffness_pattern();
+    delete this->ebe;
+    this->ebe = nullptr;
+    delete this->Kt;
+    this->Kt = new FEMatrixSparse(this->ndof, this->ndof, pattern, true);
+    delete pattern;
+
+    // Serial assembly
+    std::vector<Element *> *elements = this->model->get_elements();
+    FEMatrix dofid, Ktelem;
+    std::vector<int> index;
+    if (this->assembly_threads == 1) {
+        for (auto &element : *elements) {
+            this->assemble_element(element, dofid, Ktelem, index);
+        }
+        this->assembly_colors = 0;
+        return;
+    }
+
+    // Parallel assembly, colors are assembled one after another
+    if (this->pool == nullptr) {
+        this->pool = new ThreadPool(this->assembly_threads);
+    }
+    std::vector<std::vector<int>> *colors = this->color_elements();
+    for (auto &color : *colors) {
+        this->pool->parallel_for(static_cast<int>(color.size()), [&](int begin, int end) {
+            FEMatrix dofid_task, Ktelem_task;
+            std::vector<int> index_task;
+            for (int k = begin; k < end; k++) {
+                this->assemble_element(elements->at(static_cast<unsigned long>(color[k])), dofid_task, Ktelem_task,
+                                       index_task);
+            }
+        });
+    }
+    this->assembly_colors = static_cast<int>(colors->size());
+    delete colors;
+
+}
+
+/**
+ * Build element by element operator, the stiffness matrix is not assembled. If more than
+ * one assembly thread is used, element colors are used to compute the products in parallel.
+ */
+void StaticAnalysis::build_element_operator() {
+
+    // Delete assembled stiffness
+    delete this->Kt;
+    this->Kt = nullptr;
+
+    // Store element stiffness
+    delete this->ebe;
+    this->ebe = new ElementOperator(this->ndof);
+    FEMatrix dofid, Ktelem;
+    const double *dofs;
+    std::vector<int> index;
+    int ndof;
+    for (auto &element : *this->model->get_elements()) {
+        element->get_dofid(dofid);
+        element->get_stiffness_global(Ktelem);
+        ndof = element->get_ndof();
+        dofs = dofid.get_data();
+        index.resize(static_cast<unsigned long>(ndof));
+        for (int r = 0; r < ndof; r++) {
+            index[r] = static_cast<int>(dofs[r]) - 1;
+        }
+        this->ebe->add_element(ndof, index.data(), Ktelem.get_data());
+    }
+
+    // Parallel products
+    if (this->assembly_threads != 1) {
+        if (this->pool == nullptr) {
+            this->pool = new ThreadPool(this->assembly_threads);
+        }
+        std::vector<std::vector<int>> *colors = this->color_elements();
+        this->ebe->set_parallel(*colors, this->pool);
+        this->assembly_colors = static_cast<int>(colors->size());
+        delete colors;
+    } else {
+        this->assembly_colors = 0;
+    }
+
+}
+
+/**
+ * Split elements into domains. If the partition has not been defined, elements are sorted
+ * by the height of their centroid (then by x) and split into groups of the same size, so
+ * the domains of a building are their stories.
+ *
+ * @return Domain of each element
+ */
+std::vector<int> *StaticAnalysis::partition_elements() const {
+    std::vector<Element *> *elements = this->model->get_elements();
+    if (!this->substructure_elements.empty()) {
+        if (this->substructure_elements.size() != elements->size()) {
+            throw std::logic_error("[STATIC-ANALYSIS] Substructure partition must have the number of elements");
+        }
+        return new std::vector<int>(this->substructure_elements);
+    }
+
+    // Element centroid
+    unsigned long nelem = elements->size();
+    std::vector<double> cx(nelem, 0), cy(nelem, 0);
+    for (unsigned long k = 0; k < nelem; k++) {
+        std::vector<Node *> *nodes = elements->at(k)->get_nodes();
+        for (auto &node : *nodes) {
+            cx[k] += node->get_pos_x() / nodes->size();
+            cy[k] += node->get_pos_y() / nodes->size();
+        }
+    }
+    std::vector<int> order(nelem);
+    for (unsigned long k = 0; k < nelem; k++) {
+        order[k] = static_cast<int>(k);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return cy[a] < cy[b] || (cy[a] == cy[b] && cx[a] < cx[b]);
+    });
+
+    // Groups of the same size
+    unsigned long ndomains = std::min(nelem, static_cast<unsigned long>(this->substructures));
+    std::vector<int> *domains = new std::vector<int>(nelem, 0);
+    for (unsigned long k = 0; k < nelem; k++) {
+        domains->at(static_cast<unsigned long>(order[k])) = static_cast<int>(k * ndomains / nelem);
+    }
+    return domains;
+}
+
+/**
+ * Build substructuring solver, element stiffness is added to their domain and then each
+ * domain is condensed onto the interface, in parallel if more than one thread is used.
+ */
+void StaticAnalysis::build_schur_solver() {
+    std::vector<int> *domains = this->partition_elements();
+    int ndomains = 1;
+    for (int d : *domains) {
+        if (d < 0) {
+            delete domains;
+            throw std::logic_error("[STATIC-ANALYSIS] Invalid substructure of element");
+        }
+        ndomains = std::max(ndomains, d + 1);
+    }
+    delete this->schur;
+    this->schur = new SchurSolver(this->ndof, ndomains);
+
+    // Store element stiffness
+    std::vector<Element *> *elements = this->model->get_elements();
+    FEMatrix dofid, Ktelem;
+    const double *dofs;
+    std::vector<int> index;
+    int ndof;
+    for (unsigned long k = 0; k < elements->size(); k++) {
+        elements->at(k)->get_dofid(dofid);
+        elements->at(k)->get_stiffness_global(Ktelem);
+        ndof = elements->at(k)->get_ndof();
+        dofs = dofid.get_data();
+        index.resize(static_cast<unsigned long>(ndof));
+        for (int r = 0; r < ndof; r++) {
+            index[r] = static_cast<int>(dofs[r]) - 1;
+        }
+        this->schur->add_element(domains->at(k), ndof, index.data(), Ktelem.get_data());
+    }
+    delete domains;
+
+    // Condense domains
+    if (this->assembly_threads != 1) {
+        if (this->pool == nullptr) {
+            this->pool = new ThreadPool(this->assembly_threads);
+        }
+        this->schur->set_thread_pool(this->pool);
+    }
+    this->schur->factorize();
+}
+
+/**
+ * Creates the rigid body modes of the structure (two translations and the rotation around
+ * the centroid of the nodes), used as near null space by the multigrid preconditioner.
+ *
+ * @param blocks Stores the node of each DOF
+ * @return Matrix of ndof x 3
+ */
+FEMatrix *StaticAnalysis::build_rigid_body_modes(std::vector<int> *blocks) const {
+
+    // Centroid, improves the conditioning of the rotation
+    std::vector<Node *> *nodes = this->model->get_nodes();
+    double xc = 0, yc = 0;
+    for (auto &node : *nodes) {
+        xc += node->get_pos_x();
+        yc += node->get_pos_y();
+    }
+    xc /= nodes->size();
+    yc /= nodes->size();
+
+    // Each node translates, rotation moves x by -dy and y by dx
+    FEMatrix *B = new FEMatrix(this->ndof, 3);
+    blocks->assign(static_cast<unsigned long>(this->ndof), 0);
+    Node *node;
+    int dof;
+    for (unsigned long k = 0; k < nodes->size(); k++) {
+        node = nodes->at(k);
+        for (int i = 1; i <= node->get_ndof(); i++) {
+            dof = node->get_dof(i);
+            if (dof < 1) continue;
+            blocks->at(static_cast<unsigned long>(dof - 1)) = static_cast<int>(k);
+            if (i == 1) {
+                B->set(dof - 1, 0, 1);
+                B->set(dof - 1, 2, -(node->get_pos_y() - yc));
+            } else if (i == 2) {
+                B->set(dof - 1, 1, 1);
+                B->set(dof - 1, 2, node->get_pos_x() - xc);
+            }
+        }
+    }
+    return B;
+
+}
+
+/**
+ * Finds the grid of a structured model, every node lies on the intersection of a vertical
+ * and a horizontal line and every element is the rectangle of a grid cell.
+ *
+ * @param x Stores vertical grid lines
+ * @param y Stores horizontal grid lines
+ * @param dof Stores DOF of each grid node component, (j*x.size()+i)*ncomp+c, -1 if restrained
+ * @return True if the model is structured
+ */
+bool StaticAnalysis::build_structured_grid(std::vector<double> *x, std::vector<double> *y,
+                                           std::vector<int> *dof) const {
+
+    // Grid lines, tolerance is relative to the model extent
+    std::vector<Node *> *nodes = this->model->get_nodes();
+    if (nodes->empty()) {
+        return false;
+    }
+    x->clear();
+    y->clear();
+    for (auto &node : *nodes) {
+        x->push_back(node->get_pos_x());
+        y->push_back(node->get_pos_y());
+    }
+    std::sort(x->begin(), x->end());
+    std::sort(y->begin(), y->end());
+    double tol = 1e-9 * (1 + x->back() - x->front() + y->back() - y->front());
+    auto same = [tol](double a, double b) { return fabs(a - b) <= tol; };
+    x->erase(std::unique(x->begin(), x->end(), same), x->end());
+    y->erase(std::unique(y->begin(), y->end(), same), y->end());
+    unsigned long nx = x->size(), ny = y->size();
+    if (nodes->size() != nx * ny) {
+        return false;
+    }
+
+    // Grid position of each node, each grid point must have one node
+    auto line = [tol](const std::vector<double> *lines, double v) {
+        return static_cast<int>(std::lower_bound(lines->begin(), lines->end(), v - tol) - lines->begin());
+    };
+    std::unordered_map<Node *, int> node_position;
+    std::vector<bool> used(nx * ny, false);
+    int ncomp = nodes->at(0)->get_ndof(), pos;
+    for (auto &node : *nodes) {
+        pos = line(y, node->get_pos_y()) * static_cast<int>(nx) + line(x, node->get_pos_x());
+        if (used[pos] || node->get_ndof() != ncomp) {
+            return false;
+        }
+        used[pos] = true;
+        node_position[node] = pos;
+    }
+
+    // Each element must be a grid cell, each cell must have one element
+    std::vector<Element *> *elements = this->model->get_elements();
+    if (elements->size() != (nx - 1) * (ny - 1)) {
+        return false;
+    }
+    std::vector<bool> cell(elements->size(), false);
+    int imin, imax, jmin, jmax, i, j;
+    for (auto &element : *elements) {
+        if (element->get_node_number() != 4) {
+            return false;
+        }
+        imin = jmin = static_cast<int>(nx * ny);
+        imax = jmax = -1;
+        std::vector<int> corners;
+        for (auto &node : *element->get_nodes()) {
+            pos = node_position.at(node);
+            i = pos % static_cast<int>(nx);
+            j = pos / static_cast<int>(nx);
+            imin = std::min(imin, i);
+            imax = std::max(imax, i);
+            jmin = std::min(jmin, j);
+            jmax = std::max(jmax, j);
+            corners.push_back(pos);
+        }
+        std::sort(corners.begin(), corners.end());
+        if (imax - imin != 1 || jmax - jmin != 1 || std::unique(corners.begin(), corners.end()) != corners.end()) {
+            return false;
+        }
+        pos = jmin * static_cast<int>(nx - 1) + imin;
+        if (cell[pos]) {
+            return false;
+        }
+        cell[pos] = true;
+    }
+
+    // DOF of each node component
+    dof->assign(nx * ny * ncomp, -1);
+    int d;
+    for (auto &node : *nodes) {
+        pos = node_position.at(node);
+        for (int c = 0; c < ncomp; c++) {
+            d = node->get_dof(c + 1);
+            if (d >= 1) {
+                dof->at(static_cast<unsigned long>(pos * ncomp + c)) = d - 1;
+            }
+        }
+    }
+    return true;
+
+}
+
+/**
+ * Solve each load case using the PCG solver, zero initial guess. If the solver does not
+ * converge for a load case the displacements are deleted and an exception is thrown, so
+ * they are not used to update the model.
+ *
+ * @param A Stiffness operator
+ * @param diagonal Stiffness diagonal, used by Jacobi preconditioner
+ * @param M Preconditioner, if nullptr Jacobi is used
+ * @return Total number of iterations
+ */
+int StaticAnalysis::solve_pcg(const PCGOperator &A, const double *diagonal, const PCGOperator *M) {
+    int iterations = 0;
+    std::vector<double> b(static_cast<unsigned long>(this->ndof));
+    std::vector<double> x(static_cast<unsigned long>(this->ndof));
+    this->u_cases = new FEMatrix(this->ndof, this->nloadcases);
+    for (int k = 0; k < this->nloadcases; k++) {
+        for (int i = 0; i < this->ndof; i++) {
+            b[i] = this->F_cases->get(i, k);
+            x[i] = 0;
+        }
+        if (M == nullptr) {
+            this->pcg->solve(this->ndof, A, diagonal, b.data(), x.data());
+        } else {
+            this->pcg->solve(this->ndof, A, *M, b.data(), x.data());
+        }
+        iterations += this->pcg->get_iterations();
+        if (!this->pcg->has_converged()) {
+            delete this->u_cases;
+            this->u_cases = nullptr;
+            throw std::logic_error("[STATIC-ANALYSIS] PCG did not converge for load case " + std::to_string(k) +
+                                   " after " + std::to_string(this->pcg->get_iterations()) +
+                                   " iterations, relative residual " +
+                                   std::to_string(this->pcg->get_history().back()));
+        }
+        for (int i = 0; i < this->ndof; i++) {
+            this->u_cases->set(i, k, x[i]);
+        }
+    }
+    return iterations;
+}
+
+/**
+ * Adds element stiffness to the stiffness matrix, only lower triangle is assembled. The
+ * given matrices and index are work storage reused between elements, so the assembly
+ * does not allocate once they have the element size.
+ *
+ * @param element Element
+ * @param dofid Work matrix, stores the element DOFID
+ * @param Ktelem Work matrix, stores the element stiffness
+ * @param index Work vector, stores the element DOF positions
+ */
+void StaticAnalysis::assemble_element(Element *element, FEMatrix &dofid, FEMatrix &Ktelem,
+                                      std::vector<int> &index) const {
+    element->get_dofid(dofid);
+    element->get_stiffness_global(Ktelem);
+    int ndof = element->get_ndof();
+    const double *dofs = dofid.get_data();
+
+    // Restrained DOF (-1) are negative after index shift, so they are skipped
+    index.resize(static_cast<unsigned long>(ndof));
+    for (int r = 0; r < ndof; r++) {
+        index[r] = static_cast<int>(dofs[r]) - 1;
+    }
+    this->Kt->assemble(ndof, index.data(), Ktelem.get_data());
+}
+
+/**
+ * Greedy element coloring, each element takes the lowest color not used by the elements
+ * sharing one of their nodes.
+ *
+ * @return Element positions of each color
+ */
+std::vector<std::vector<int>> *StaticAnalysis::color_elements() const {
+
+    // Node position within model
+    std::vector<Node *> *nodes = this->model->get_nodes();
+    std::unordered_map<Node *, int> node_index;
+    for (unsigned long k = 0; k < nodes->size(); k++) {
+        node_index[nodes->at(k)] = static_cast<int>(k);
+    }
+
+    // Colors used by the elements of each node
+    std::vector<std::vector<int>> node_colors(nodes->size());
+    std::vector<std::vector<int>> *colors = new std::vector<std::vector<int>>();
+    std::vector<Element *> *elements = this->model->get_elements();
+    std::vector<bool> used;
+    int c;
+    for (unsigned long e = 0; e < elements->size(); e++) {
+        used.assign(colors->size() + 1, false);
+        for (auto &node : *elements->at(e)->get_nodes()) {
+            for (int nc : node_colors[node_index.at(node)]) {
+                used[nc] = true;
+            }
+        }
+        c = 0;
+        while (used[c]) c++;
+        if (c == static_cast<int>(colors->size())) {
+            colors->push_back(std::vector<int>());
+        }
+        colors->at(static_cast<unsigned long>(c)).push_back(static_cast<int>(e));
+        for (auto &node : *elements->at(e)->get_nodes()) {
+            node_colors[node_index.at(node)].push_back(c);
+        }
+    }
+    return colors;
+
+}
+
+/**
+ * Set number of threads used by stiffness assembly.
+ *
+ * @param nthreads Number of threads, 1 assembles serially, 0 uses hardware concurrency
+ */
+void StaticAnalysis::set_assembly_threads(int nthreads) {
+    if (nthreads < 0) {
+        throw std::logic_error("[STATIC-ANALYSIS] Number of assembly threads cannot be negative");
+    }
+    delete this->pool;
+    this->pool = nullptr;
+    this->assembly_threads = nthreads;
+}
+
+/**
+ * Return number of element colors used by the last parallel assembly, zero if assembly
+ * was serial.
+ *
+ * @return
+ */
+int StaticAnalysis::get_assembly_colors() const {
+    return this->assembly_colors;
+}
+
+/**
+ * Build force matrix, each column stores the loads of a load pattern. Load patterns are
+ * applied one at a time over the unloaded model, at the end all load patterns are applied
+ * and the force vector stores the sum of all load cases.
+ */
+void StaticAnalysis::build_force_matrix() {
+
+    // One load case for each load pattern
+    std::vector<LoadPattern *> *loadpatterns = this->model->get_load_patterns();
+    this->nloadcases = std::max(1, static_cast<int>(loadpatterns->size()));
+    this->F_cases = new FEMatrix(this->ndof, this->nloadcases);
+
+    FEMatrix *dofid;
+    int ndof, dof;
+    std::vector<Node *> *nodes = this->model->get_nodes();
+    for (int k = 0; k < this->nloadcases; k++) {
+        this->model->reset_loads();
+        if (k < static_cast<int>(loadpatterns->size())) {
+            this->model->apply_load_pattern(k);
+        }
+        for (auto &node : *nodes) {
+            dofid = node->get_dofid();
+            dofid->set_origin(0);
+            ndof = node->get_ndof();
+            for (int i = 0; i < ndof; i++) {
+                if (fabs(dofid->get(i) + 1) > FNELEM_CONST_ZERO_TOLERANCE) {
+                    dof = static_cast<int>(dofid->get(i)) - 1;
+                    this->F_cases->set(dof, k, this->F_cases->get(dof, k) - node->get_reaction(i + 1));
+                }
+            }
+            delete dofid;
+        }
+    }
+
+    // Apply all load patterns
+    this->model->reset_loads();
+    this->model->apply_load_patterns();
+    this->F = this->superpose_load_cases(this->F_cases);
+
+}
+
+/**
+ * Sum all columns of a load case matrix.
+ *
+ * @param cases Matrix, one column per load case
+ * @return Vector
+ */
+FEMatrix *StaticAnalysis::superpose_load_cases(FEMatrix *cases) const {
+    FEMatrix *sum = FEMatrix_vector(this->ndof);
+    double val;
+    for (int i = 0; i < this->ndof; i++) {
+        val = 0;
+        for (int k = 0; k < this->nloadcases; k++) {
+            val += cases->get(i, k);
+        }
+        sum->set(i, val);
+    }
+    return sum;
+}
+
+/**
+ * Update model using the displacements of a single load case. Only the loads of the
+ * load pattern are applied, so node reactions and element stresses are the ones of
+ * the load case.
+ *
+ * @param k Load case, follows model load pattern order
+ */
+void StaticAnalysis::update_load_case(int k) {
+    if (this->u_cases == nullptr) {
+        throw std::logic_error("[STATIC-ANALYSIS] Analysis has not been done");
+    }
+    if (k < 0 || k >= this->nloadcases) {
+        throw std::logic_error("[STATIC-ANALYSIS] Load case position overflow");
+    }
+    FEMatrix *uk = FEMatrix_vector(this->ndof);
+    for (int i = 0; i < this->ndof; i++) {
+        uk->set(i, this->u_cases->get(i, k));
+    }
+    this->model->reset_loads();
+    if (k < static_cast<int>(this->model->get_load_patterns()->size())) {
+        this->model->apply_load_pattern(k);
+    }
+    this->model->update(uk);
+    delete uk;
+}
+
+/**
+ * Update model using the superposition of all load cases, restores the model state of
+ * the analysis.
+ */
+void StaticAnalysis::update_load_cases() {
+    if (this->u == nullptr) {
+        throw std::logic_error("[STATIC-ANALYSIS] Analysis has not been done");
+    }
+    this->model->reset_loads();
+    this->model->apply_load_patterns();
+    this->model->update(this->u);
+}
+
+/**
+ * Computes topology fingerprint, depends on the DOFID of each element.
+ *
+ * @return
+ */
+unsigned long long StaticAnalysis::topology_fingerprint() const {
+    unsigned long long h = FEMATRIX_FINGERPRINT_SEED;
+    FEMatrix dofid;
+    for (auto &element : *this->model->get_elements()) {
+        element->get_dofid(dofid);
+        h = FEMatrix_fingerprint(&dofid, h);
+    }
+    return h;
+}
+
+/**
+ * Computes stiffness fingerprint, depends on the global stiffness of each element.
+ *
+ * @return
+ */
+unsigned long long StaticAnalysis::stiffness_fingerprint() const {
+    unsigned long long h = FEMATRIX_FINGERPRINT_SEED;
+    FEMatrix k;
+    for (auto &element : *this->model->get_elements()) {
+        element->get_stiffness_global(k);
+        h = FEMatrix_fingerprint(&k, h);
+    }
+    return h;
+}
+
+/**
+ * Check if the stored stiffness and factorization can be used. The model revision, the
+ * topology and the stiffness fingerprints must be the same as the stored ones, and the
+ * solver must not change. Fingerprints of the current model are stored.
+ *
+ * @param solver Solver backend
+ * @param updatable Returns true if only the stiffness changed, the factorization can be updated
+ * @return
+ */
+bool StaticAnalysis::check_factorization_cache(const std::string &solver, bool *updatable) {
+    unsigned long long topology = this->topology_fingerprint();
+    unsigned long long stiffness = this->stiffness_fingerprint();
+    bool same = this->cache_enabled && this->cache_valid && this->cache_solver == solver &&
+                this->cache_revision == this->model->get_revision() && this->cache_topology == topology;
+    bool cached = same && this->cache_stiffness == stiffness;
+    *updatable = same && !cached && this->Kt_factorized != nullptr && this->update_max_rank > 0;
+    this->cache_solver = solver;
+    this->cache_revision = this->model->get_revision();
+    this->cache_topology = topology;
+    this->cache_stiffness = stiffness;
+    return cached;
+}
+
+/**
+ * Enable or disable factorization cache.
+ *
+ * @param enabled Stiffness factorization is reused if model does not change
+ */
+void StaticAnalysis::set_factorization_cache(bool enabled) {
+    this->cache_enabled = enabled;
+    if (!enabled) {
+        this->cache_valid = false;
+    }
+}
+
+/**
+ * Discard stored factorization, next analysis assembles and factorizes the stiffness.
+ * Must be called if the model changes without modifying element DOFID nor element
+ * stiffness, else, the change is detected by the fingerprints.
+ */
+void StaticAnalysis::invalidate_factorization() {
+    this->cache_valid = false;
+}
+
+/**
+ * Returns true if the last analysis used the stored factorization.
+ *
+ * @return
+ */
+bool StaticAnalysis::is_factorization_cached() const {
+    return this->cache_used;
+}
+
+/**
+ * Return solve of the stored factorization of a solver. The low-rank update is not applied.
+ *
+ * @param solver Solver backend
+ * @return Solve function, empty if the solver does not factorize the stiffness
+ */
+LowRankSolve StaticAnalysis::factorization_solve(const std::string &solver) const {
+    if (solver == FNELEM_STATIC_ANALYSIS_SOLVER_LDL && this->ldl != nullptr) {
+        SparseLDL *ldl = this->ldl;
+        return [ldl](double *x, int nrhs) { ldl->solve(x, nrhs); };
+    } else if (solver == FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE && this->skyline != nullptr) {
+        FEMatrixSkyline *skyline = this->skyline;
+        return [skyline](double *x, int nrhs) { skyline->solve(x, nrhs); };
+    } else if (solver == FNELEM_STATIC_ANALYSIS_SOLVER_DENSE && this->dense != nullptr) {
+        FEMatrixFactorization *dense = this->dense;
+        return [dense](double *x, int nrhs) { dense->solve(x, nrhs); };
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+    } else if (solver == FNELEM_STATIC_ANALYSIS_SOLVER_OUT_OF_CORE && this->ooc != nullptr) {
+        OutOfCoreSkyline *ooc = this->ooc;
+        return [ooc](double *x, int nrhs) { ooc->solve(x, nrhs); };
+#endif
+    } else if (solver == FNELEM_STATIC_ANALYSIS_SOLVER_MIXED) {
+        MixedPrecisionSolver *mixed = this->mixed;
+        return [mixed](double *x, int nrhs) { mixed->solve(x, nrhs); };
+    }
+    return nullptr;
+}
+
+/**
+ * Computes the low-rank update of the stored factorization. The new stiffness is compared
+ * with the factorized one, the rows whose values changed define the update (an element
+ * changes at most their 8 rows). The update is always relative to the stored
+ * factorization, so design iterations do not accumulate errors.
+ *
+ * @param solver Solver backend
+ * @return False if the stiffness must be factorized again
+ */
+bool StaticAnalysis::update_factorization(const std::string &solver) {
+    LowRankSolve solve = this->factorization_solve(solver);
+    if (!solve || this->Kt_factorized == nullptr || this->Kt_factorized->get_nnz() != this->Kt->get_nnz()) {
+        return false;
+    }
+    const int *row_ptr = this->Kt->get_row_ptr();
+    const int *col_index = this->Kt->get_col_index();
+    const double *values = this->Kt->get_values();
+    const double *values0 = this->Kt_factorized->get_values();
+    int i, j, k;
+
+    // Find changed rows, stiffness is symmetric so both row and column are updated
+    std::vector<int> position(static_cast<unsigned long>(this->ndof), -1);
+    std::vector<int> rows;
+    for (i = 0; i < this->ndof; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            if (values[k] == values0[k]) continue;
+            j = col_index[k];
+            if (position[i] < 0) {
+                position[i] = 0;
+                rows.push_back(i);
+            }
+            if (position[j] < 0) {
+                position[j] = 0;
+                rows.push_back(j);
+            }
+        }
+    }
+    if (static_cast<int>(rows.size()) > this->update_max_rank) {
+        return false;
+    }
+    std::sort(rows.begin(), rows.end());
+    int s = static_cast<int>(rows.size());
+    for (k = 0; k < s; k++) {
+        position[rows[k]] = k;
+    }
+
+    // Change of the stiffness within the updated rows
+    std::vector<double> delta(static_cast<unsigned long>(s * s), 0);
+    double d;
+    for (int r = 0; r < s; r++) {
+        i = rows[r];
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            j = col_index[k];
+            if (position[j] < 0) continue;
+            d = values[k] - values0[k];
+            delta[r * s + position[j]] = d;
+            delta[position[j] * s + r] = d;
+        }
+    }
+    try {
+        this->update->update(this->ndof, rows, delta.data(), solve);
+    } catch (const std::logic_error &e) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Correct displacements using the low-rank update, the displacements of the stored
+ * factorization are replaced. The residual of the updated stiffness is checked, as the
+ * update loses accuracy if the change is large compared with the stiffness.
+ *
+ * @return False if the corrected displacements are not accurate
+ */
+bool StaticAnalysis::correct_update() {
+    int nrhs = this->nloadcases;
+    double *x = this->u_cases->get_array();
+    this->update->solve(x, nrhs);
+    FEMatrix *u_updated = new FEMatrix(this->ndof, nrhs, x);
+    delete[] x;
+
+    // Check relative residual of each load case, r = F - K*u
+    FEMatrix *Ku = *this->Kt * *u_updated;
+    double rnorm, fnorm, fi;
+    bool accurate = true;
+    for (int r = 0; r < nrhs; r++) {
+        rnorm = 0;
+        fnorm = 0;
+        for (int i = 0; i < this->ndof; i++) {
+            fi = this->F_cases->get(i, r);
+            rnorm += (fi - Ku->get(i, r)) * (fi - Ku->get(i, r));
+            fnorm += fi * fi;
+        }
+        if (rnorm > __STATIC_ANALYSIS_UPDATE_TOLERANCE * __STATIC_ANALYSIS_UPDATE_TOLERANCE * fnorm) {
+            accurate = false;
+        }
+    }
+    delete Ku;
+    if (!accurate) {
+        delete u_updated;
+        return false;
+    }
+    delete this->u_cases;
+    this->u_cases = u_updated;
+    return true;
+}
+
+/**
+ * Set max number of updated stiffness rows. If more rows change, the stiffness is
+ * factorized again.
+ *
+ * @param rank Max number of rows, zero disables the low-rank update
+ */
+void StaticAnalysis::set_update_max_rank(int rank) {
+    if (rank < 0) {
+        throw std::logic_error("[STATIC-ANALYSIS] Update rank cannot be negative");
+    }
+    this->update_max_rank = rank;
+    if (rank == 0) {
+        delete this->Kt_factorized;
+        this->Kt_factorized = nullptr;
+    }
+}
+
+/**
+ * Return max number of updated stiffness rows.
+ *
+ * @return
+ */
+int StaticAnalysis::get_update_max_rank() const {
+    return this->update_max_rank;
+}
+
+/**
+ * Returns true if the last analysis updated the stored factorization, the stiffness was
+ * not factorized again.
+ *
+ * @return
+ */
+bool StaticAnalysis::is_factorization_updated() const {
+    return this->update_used;
+}
+
+/**
+ * Return number of updated rows of the stored factorization, zero if there is no update.
+ *
+ * @return
+ */
+int StaticAnalysis::get_update_rank() const {
+    return this->update->get_rank();
+}
+
+/**
+ * Delete forces and displacements of last analysis.
+ */
+void StaticAnalysis::delete_results() {
+    delete this->F;
+    delete this->F_cases;
+    delete this->u;
+    delete this->u_cases;
+    this->F = nullptr;
+    this->F_cases = nullptr;
+    this->u = nullptr;
+    this->u_cases = nullptr;
 }
 
 /**
@@ -34,14 +34,66 @@ Performs static analysis calculation.
 
 // Include headers
 #include "../model/base/model.h"
+#include "solver_cost_model.h"
+#include "solver_registry.h"
+#include "../math/amg.h"
+#include "../math/condition_estimate.h"
+#include "../math/element_operator.h"
+#include "../math/fematrix_factorization.h"
+#include "../math/fematrix_skyline.h"
+#include "../math/fematrix_sparse.h"
+#include "../math/gmg.h"
+#include "../math/low_rank_update.h"
 #include "../math/matrix_inversion_cpu.h"
 #include "../math/matrix_inversion_cuda.h"
+#include "../math/matrix_inversion_threaded.h"
+#include "../math/matrix_ordering.h"
+#include "../math/mixed_precision.h"
+#include "../math/out_of_core_skyline.h"
+#include "../math/pcg.h"
+#include "../math/schur_solver.h"
+#include "../math/sparse_ldl.h"
+#include "../math/thread_pool.h"
 
 // Library imports
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+// Solver definition, name of the registered backends
+#define FNELEM_STATIC_ANALYSIS_SOLVER_AUTO "auto"                   // Backend is selected by the cost model
+#define FNELEM_STATIC_ANALYSIS_SOLVER_LDL "ldl"                     // Sparse LDL' direct solver
+#define FNELEM_STATIC_ANALYSIS_SOLVER_PCG "pcg"                     // Preconditioned conjugate gradient
+#define FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE "skyline"             // Skyline LDL' factorization
+#define FNELEM_STATIC_ANALYSIS_SOLVER_OUT_OF_CORE "out-of-core"     // Skyline LDL' stored in memory-mapped files
+#define FNELEM_STATIC_ANALYSIS_SOLVER_DENSE "dense"                 // Dense blocked Cholesky factorization
+#define FNELEM_STATIC_ANALYSIS_SOLVER_MATRIX_FREE "matrix-free"     // Element by element PCG, stiffness is not assembled
+#define FNELEM_STATIC_ANALYSIS_SOLVER_AMG "amg"                     // PCG using algebraic multigrid preconditioner
+#define FNELEM_STATIC_ANALYSIS_SOLVER_GMG "gmg"                     // PCG using geometric multigrid, structured grids only
+#define FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE "substructure"   // Substructuring, Schur complement of the interface
+#define FNELEM_STATIC_ANALYSIS_SOLVER_MIXED "mixed"                 // Single precision LDL' and double precision refinement
+#define FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN "gauss-jordan"   // Dense Gauss-Jordan inversion by CPU
+#define FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN_THREADED "gauss-jordan-threaded" // Gauss-Jordan by host threads
+#define FNELEM_STATIC_ANALYSIS_SOLVER_CUDA "cuda"                   // Dense Gauss-Jordan inversion by GPU
+
+// CUDA backend is only available if the library is compiled by nvcc
+#ifdef __CUDACC__
+#define FNELEM_STATIC_ANALYSIS_CUDA
+#endif
+
+// DOF numbering definition
+#define FNELEM_STATIC_ANALYSIS_NUMBERING_NONE 0         // Model node order
+#define FNELEM_STATIC_ANALYSIS_NUMBERING_RCM 1          // Reverse Cuthill-McKee, reduces bandwidth
+#define FNELEM_STATIC_ANALYSIS_NUMBERING_MINDEGREE 2    // Minimum degree, reduces factorization fill-in
+
+// Constant definition
+#define __STATIC_ANALYSIS_DEFAULT_SUBSTRUCTURES 4
+#define __STATIC_ANALYSIS_DEFAULT_UPDATE_RANK 64
+#define __STATIC_ANALYSIS_UPDATE_TOLERANCE 1e-8
+
 class StaticAnalysis {
 private:
 
@@ -51,8 +103,8 @@ private:
     // Number of degrees of freedom
     int ndof = 0;
 
-    // Matrix stiffness
-    FEMatrix *Kt = nullptr;
+    // Matrix stiffness, sparse symmetric
+    FEMatrixSparse *Kt = nullptr;
 
     // Displacement vector
     FEMatrix *u = nullptr;
@@ -60,14 +112,254 @@ private:
     // Force vector
     FEMatrix *F = nullptr;
 
+    // Number of load cases
+    int nloadcases = 0;
+
+    // Displacement matrix, one column per load case
+    FEMatrix *u_cases = nullptr;
+
+    // Force matrix, one column per load case
+    FEMatrix *F_cases = nullptr;
+
+    // Sparse factorization of the stiffness matrix
+    SparseLDL *ldl = nullptr;
+
+    // Skyline stiffness matrix, factorized in place
+    FEMatrixSkyline *skyline = nullptr;
+
+    // Dense factorization of the stiffness matrix
+    FEMatrixFactorization *dense = nullptr;
+
+    // Element by element stiffness operator, used by matrix free solver
+    ElementOperator *ebe = nullptr;
+
+    // Inverse of the stiffness matrix, used by Gauss-Jordan solvers
+    FEMatrix *invKt = nullptr;
+
+    // Iterative solver
+    PCGSolver *pcg = nullptr;
+
+    // Multigrid preconditioner of the iterative solver
+    AMGPreconditioner *amg = nullptr;
+
+    // Geometric multigrid preconditioner of the iterative solver
+    GMGPreconditioner *gmg = nullptr;
+
+    // Substructuring solver
+    SchurSolver *schur = nullptr;
+
+    // Mixed precision solver
+    MixedPrecisionSolver *mixed = nullptr;
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+    // Out of core skyline factorization
+    OutOfCoreSkyline *ooc = nullptr;
+
+    // Memory budget of the out of core factorization in bytes
+    long out_of_core_memory = __OUT_OF_CORE_SKYLINE_DEFAULT_MEMORY;
+
+    // Directory of the out of core factor file, empty uses the temporary directory
+    std::string out_of_core_directory;
+
+#endif
+
+    // Registered solver backends
+    SolverRegistry *solvers = nullptr;
+
+    // Selected solver backend
+    std::string solver = FNELEM_STATIC_ANALYSIS_SOLVER_AUTO;
+
+    // Solver backend used by the last analysis
+    std::string last_solver;
+
+    // Estimates the cost of each solver, used by automatic selection
+    SolverCostModel *costs = nullptr;
+
+    // Topology fingerprint of the last automatic selection
+    unsigned long long costs_topology = 0;
+
+    // Number of load cases used by the automatic solver selection
+    int costs_nrhs = 0;
+
+    // Number of substructures if the partition is automatic
+    int substructures = __STATIC_ANALYSIS_DEFAULT_SUBSTRUCTURES;
+
+    // Substructure of each element, empty if the partition is automatic
+    std::vector<int> substructure_elements;
+
+    // Number of threads used by stiffness assembly
+    int assembly_threads = 1;
+
+    // Number of element colors of the last parallel assembly
+    int assembly_colors = 0;
+
+    // Thread pool used by parallel assembly
+    ThreadPool *pool = nullptr;
+
+    // Stiffness factorization is reused if model does not change
+    bool cache_enabled = true;
+
+    // Stored stiffness and factorization can be used
+    bool cache_valid = false;
+
+    // Last analysis used the stored factorization
+    bool cache_used = false;
+
+    // Solver backend of the stored factorization
+    std::string cache_solver;
+
+    // Model revision of the stored factorization
+    int cache_revision = -1;
+
+    // Topology fingerprint of the stored factorization
+    unsigned long long cache_topology = 0;
+
+    // Stiffness fingerprint of the stored factorization
+    unsigned long long cache_stiffness = 0;
+
+    // Stiffness matrix of the stored factorization, used to find the low-rank update
+    FEMatrixSparse *Kt_factorized = nullptr;
+
+    // Low-rank update of the stored factorization
+    LowRankUpdate *update = nullptr;
+
+    // Max number of updated rows, zero disables the low-rank update
+    int update_max_rank = __STATIC_ANALYSIS_DEFAULT_UPDATE_RANK;
+
+    // Last analysis updated the stored factorization
+    bool update_used = false;
+
+    // DOF numbering method
+    int numbering = FNELEM_STATIC_ANALYSIS_NUMBERING_NONE;
+
+    // Bandwidth of the stiffness matrix
+    int bandwidth = 0;
+
+    // Profile of the stiffness matrix, number of values within lower envelope
+    long profile = 0;
+
     // Start dof numeration
     void define_dof();
 
+    // Assign node DOFID following node order
+    void number_dof(std::vector<int> *order);
+
+    // Build node adjacency graph from element connectivity
+    std::vector<std::vector<int>> *build_node_graph() const;
+
+    // Calculate bandwidth and profile of current numbering
+    void calculate_bandwidth_profile();
+
+    // Build stiffness matrix pattern from element connectivity
+    std::vector<std::vector<int>> *build_stiffness_pattern() const;
+
     // Build stiffness matrix
     void build_stiffness_matrix();
 
-    // Build force vector
-    void build_force_vector();
+    // Adds element stiffness to the stiffness matrix
+    void assemble_element(Element *element, FEMatrix &dofid, FEMatrix &Ktelem, std::vector<int> &index) const;
+
+    // Build element by element stiffness operator
+    void build_element_operator();
+
+    // Register built-in solver backends
+    void register_solvers();
+
+    // Select solver backend if automatic selection is used
+    std::string select_solver();
+
+    // Backend, sparse LDL' factorization
+    std::string solver_ldl(bool cached);
+
+    // Backend, PCG using Jacobi preconditioner
+    std::string solver_pcg(bool cached);
+
+    // Backend, PCG using algebraic multigrid preconditioner
+    std::string solver_amg(bool cached);
+
+    // Backend, PCG using geometric multigrid preconditioner
+    std::string solver_gmg(bool cached);
+
+    // Backend, substructuring
+    std::string solver_substructure(bool cached);
+
+    // Backend, mixed precision LDL'
+    std::string solver_mixed(bool cached);
+
+    // Backend, element by element PCG
+    std::string solver_matrix_free(bool cached);
+
+    // Backend, skyline LDL' factorization
+    std::string solver_skyline(bool cached);
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+    // Backend, skyline LDL' factorization stored out of core
+    std::string solver_out_of_core(bool cached);
+
+#endif
+
+    // Backend, dense Cholesky or LU factorization
+    std::string solver_dense(bool cached);
+
+    // Backend, dense Gauss-Jordan inversion by CPU
+    std::string solver_gauss_jordan(bool cached);
+
+    // Backend, dense Gauss-Jordan inversion by host threads
+    std::string solver_gauss_jordan_threaded(bool cached);
+
+#ifdef FNELEM_STATIC_ANALYSIS_CUDA
+
+    // Backend, dense Gauss-Jordan inversion by GPU
+    std::string solver_cuda(bool cached);
+
+#endif
+
+    // Solve all load cases using PCG
+    int solve_pcg(const PCGOperator &A, const double *diagonal, const PCGOperator *M = nullptr);
+
+    // Creates rigid body modes, used by multigrid
+    FEMatrix *build_rigid_body_modes(std::vector<int> *blocks) const;
+
+    // Finds grid lines and DOF of a structured model, used by geometric multigrid
+    bool build_structured_grid(std::vector<double> *x, std::vector<double> *y, std::vector<int> *dof) const;
+
+    // Split elements into substructures
+    std::vector<int> *partition_elements() const;
+
+    // Build substructuring solver
+    void build_schur_solver();
+
+    // Color elements, elements of the same color do not share nodes
+    std::vector<std::vector<int>> *color_elements() const;
+
+    // Build force matrix, one column per load pattern
+    void build_force_matrix();
+
+    // Sum the columns of a load case matrix
+    FEMatrix *superpose_load_cases(FEMatrix *cases) const;
+
+    // Delete last analysis data
+    void delete_results();
+
+    // Computes fingerprint of element DOFID
+    unsigned long long topology_fingerprint() const;
+
+    // Computes fingerprint of element stiffness
+    unsigned long long stiffness_fingerprint() const;
+
+    // Check stored factorization can be used
+    bool check_factorization_cache(const std::string &solver, bool *updatable);
+
+    // Return solve of the stored factorization of a solver, empty if the solver does not factorize
+    LowRankSolve factorization_solve(const std::string &solver) const;
+
+    // Computes low-rank update of the stored factorization from the changed stiffness rows
+    bool update_factorization(const std::string &solver);
+
+    // Correct displacements of the stored factorization using the low-rank update
+    bool correct_update();
 
     // Return yes/no
     std::string yes_no(bool v) const;
@@ -80,21 +372,136 @@ public:
     // Destructor
     ~StaticAnalysis();
 
-    // Start analysis
-    void analyze(bool use_gpu);
+    // Start analysis using the selected solver backend
+    void analyze();
+
+    // Start analysis using a certain solver backend
+    void analyze(const std::string &solver);
+
+    // Select solver backend by name
+    void set_solver(const std::string &solver);
+
+    // Return selected solver backend
+    std::string get_solver() const;
+
+    // Return solver backend used by the last analysis
+    std::string get_last_solver() const;
+
+    // Register user defined solver backend
+    void add_solver(const std::string &name, const std::string &description, const SolverFunction &function);
+
+    // Return solver registry, used to list backends and get their time
+    SolverRegistry *get_solver_registry() const;
+
+    // Return solver cost model, used by automatic selection
+    SolverCostModel *get_solver_cost_model() const;
+
+    // Return iterative solver, used to configure tolerance and get convergence history
+    PCGSolver *get_pcg_solver() const;
+
+    // Return algebraic multigrid preconditioner
+    AMGPreconditioner *get_amg_preconditioner() const;
+
+    // Return geometric multigrid preconditioner
+    GMGPreconditioner *get_gmg_preconditioner() const;
+
+    // Return mixed precision solver
+    MixedPrecisionSolver *get_mixed_precision_solver() const;
+
+    // Set number of substructures, elements are split by height
+    void set_substructures(int n);
+
+    // Set substructure of each element
+    void set_substructures(const std::vector<int> *element_domain);
+
+    // Return substructuring solver
+    SchurSolver *get_schur_solver() const;
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+    // Set memory budget of the out of core factorization
+    void set_out_of_core_memory(long bytes);
+
+    // Set directory of the out of core factor file
+    void set_out_of_core_directory(const std::string &directory);
+
+    // Return out of core factorization
+    OutOfCoreSkyline *get_out_of_core_solver() const;
+
+#endif
 
     // Return stiffness matrix
     FEMatrix *get_stiffness_matrix() const;
 
+    // Return sparse stiffness matrix
+    FEMatrixSparse *get_stiffness_matrix_sparse() const;
+
+    // Return logarithm of the absolute stiffness determinant, reuses the solver factorization
+    double get_stiffness_log_det(int *sign) const;
+
+    // Estimate 1-norm condition number of the stiffness, reuses the solver factorization
+    double get_stiffness_condition(int *nsolves) const;
+
     // Return displacement vector
     FEMatrix *get_displacements_vector() const;
 
     // Return force vector
     FEMatrix *get_force_vector() const;
 
+    // Return force matrix, one column per load case
+    FEMatrix *get_force_matrix() const;
+
+    // Return displacement matrix, one column per load case
+    FEMatrix *get_displacements_matrix() const;
+
+    // Return number of load cases
+    int get_number_load_cases() const;
+
+    // Update model using a single load case
+    void update_load_case(int k);
+
+    // Update model using all load cases
+    void update_load_cases();
+
+    // Set number of threads used by stiffness assembly
+    void set_assembly_threads(int nthreads);
+
+    // Return number of element colors used by the last parallel assembly
+    int get_assembly_colors() const;
+
+    // Enable or disable factorization cache
+    void set_factorization_cache(bool enabled);
+
+    // Discard stored factorization
+    void invalidate_factorization();
+
+    // Last analysis used the stored factorization
+    bool is_factorization_cached() const;
+
+    // Set max number of updated stiffness rows of the low-rank update
+    void set_update_max_rank(int rank);
+
+    // Return max number of updated stiffness rows of the low-rank update
+    int get_update_max_rank() const;
+
+    // Last analysis updated the stored factorization
+    bool is_factorization_updated() const;
+
+    // Return number of updated rows of the stored factorization
+    int get_update_rank() const;
+
     // Get number of degrees of freedom
     int get_ndof() const;
 
+    // Set DOF numbering method
+    void set_dof_numbering(int method);
+
+    // Get stiffness matrix bandwidth
+    int get_bandwidth() const;
+
+    // Get stiffness matrix profile
+    long get_profile() const;
+
     // Display analysis information to console
     void disp() const;
 
@@ -0,0 +1,426 @@
+/**
+FNELEM-GPU ALGEBRAIC MULTIGRID
+Smoothed aggregation algebraic multigrid preconditioner.
+
+@package fnelem.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "amg.h"
+
+/**
+ * Constructor.
+ */
+AMGPreconditioner::AMGPreconditioner() = default;
+
+/**
+ * Destructor.
+ */
+AMGPreconditioner::~AMGPreconditioner() = default;
+
+/**
+ * Set aggregation strength threshold.
+ *
+ * @param theta Threshold, zero considers all couplings as strong
+ */
+void AMGPreconditioner::set_strength_threshold(double theta) {
+    if (theta < 0 || theta >= 1) {
+        throw std::logic_error("[AMG] Strength threshold must be within [0, 1)");
+    }
+    this->strength_threshold = theta;
+}
+
+/**
+ * Build hierarchy.
+ *
+ * @param K Symmetric positive definite matrix
+ * @param blocks Node (block) of each DOF, DOF of the same node are aggregated together
+ * @param B Near null space, each column is a mode (rigid body movement) of n values
+ */
+void AMGPreconditioner::setup(const FEMatrixSparse *K, const std::vector<int> *blocks, const FEMatrix *B) {
+
+    // Check dimension
+    int n = K->get_square_dimension();
+    if (n == 0) {
+        throw std::logic_error("[AMG] Matrix must be square");
+    }
+    if (blocks->size() != static_cast<unsigned long>(n)) {
+        throw std::logic_error("[AMG] Block vector must have the matrix dimension");
+    }
+    int *dim = B->size();
+    int nrows = dim[0], nmodes = dim[1];
+    delete[] dim;
+    if (nrows != n) {
+        throw std::logic_error("[AMG] Near null space must have the matrix dimension");
+    }
+    this->destroy();
+
+    // Compact block numbers
+    int nblocks = 0;
+    for (int b : *blocks) {
+        if (b < 0) {
+            throw std::logic_error("[AMG] Block number must be positive");
+        }
+        nblocks = std::max(nblocks, b + 1);
+    }
+    std::vector<int> blkmap(static_cast<unsigned long>(nblocks), -1);
+    for (int b : *blocks) {
+        blkmap[b] = 0;
+    }
+    nblocks = 0;
+    for (auto &b : blkmap) {
+        if (b == 0) {
+            b = nblocks;
+            nblocks += 1;
+        }
+    }
+    std::vector<int> blk(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        blk[i] = blkmap[blocks->at(static_cast<unsigned long>(i))];
+    }
+
+    // Near null space
+    double *barr = B->get_array();
+    std::vector<double> Bl(barr, barr + n * nmodes);
+    delete[] barr;
+
+    // Coarsen until the dimension is small
+    FEMatrixSparse *Al = this->full(K);
+    this->A.push_back(Al);
+    while (n > this->coarse_size && static_cast<int>(this->A.size()) < this->max_levels) {
+        std::vector<int> aggregates;
+        int naggregates = this->aggregate(Al, blk, &aggregates);
+        if (naggregates == nblocks) break; // Aggregation does not reduce the dimension
+
+        // Prolongator
+        std::vector<double> Bc;
+        std::vector<int> blkc;
+        FEMatrixSparse *Pt = this->tentative_prolongator(naggregates, aggregates, Bl, nmodes, &Bc, &blkc);
+        if (Pt == nullptr) break;
+        int *pdim = Pt->size();
+        int nc = pdim[1];
+        delete[] pdim;
+        if (nc >= n) {
+            delete Pt;
+            break;
+        }
+        FEMatrixSparse *Pl = this->smooth_prolongator(Al, Pt);
+        delete Pt;
+
+        // Galerkin coarse matrix P'*A*P
+        this->add_level(Pl);
+        Al = this->A.back();
+
+        // Next level
+        n = nc;
+        nblocks = naggregates;
+        blk = blkc;
+        Bl = Bc;
+    }
+
+    // Factorize coarsest matrix
+    this->factorize_coarse();
+
+}
+
+/**
+ * Group blocks into aggregates. Two blocks are strongly coupled if the norm of their
+ * coupling satisfies ||Aij|| >= theta * sqrt(||Aii||*||Ajj||). First, each block whose
+ * strong neighbours are not aggregated creates an aggregate with them; then remaining
+ * blocks join their strongest aggregated neighbour; finally the rest form new aggregates.
+ *
+ * @param M Matrix storing full rows
+ * @param blocks Block of each DOF, numbered from zero
+ * @param aggregates Stores the aggregate of each DOF
+ * @return Number of aggregates
+ */
+int AMGPreconditioner::aggregate(const FEMatrixSparse *M, const std::vector<int> &blocks,
+                                 std::vector<int> *aggregates) const {
+    int n = M->get_square_dimension();
+    const int *row_ptr = M->get_row_ptr();
+    const int *col_index = M->get_col_index();
+    const double *values = M->get_values();
+
+    // DOF of each block
+    int nb = 0;
+    for (int b : blocks) {
+        nb = std::max(nb, b + 1);
+    }
+    std::vector<std::vector<int>> dofs(static_cast<unsigned long>(nb));
+    for (int i = 0; i < n; i++) {
+        dofs[blocks[i]].push_back(i);
+    }
+
+    // Norm of each block coupling
+    std::vector<double> diagonal(static_cast<unsigned long>(nb), 0);
+    std::vector<std::vector<int>> neighbours(static_cast<unsigned long>(nb));
+    std::vector<std::vector<double>> coupling(static_cast<unsigned long>(nb));
+    std::vector<double> acc(static_cast<unsigned long>(nb), 0);
+    std::vector<int> marker(static_cast<unsigned long>(nb), -1);
+    std::vector<int> touched;
+    int b, c, k;
+    for (b = 0; b < nb; b++) {
+        touched.clear();
+        for (int i : dofs[b]) {
+            for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+                c = blocks[col_index[k]];
+                if (marker[c] != b) {
+                    marker[c] = b;
+                    touched.push_back(c);
+                }
+                acc[c] += values[k] * values[k];
+            }
+        }
+        for (int t : touched) {
+            if (t == b) {
+                diagonal[b] = sqrt(acc[t]);
+            } else {
+                neighbours[b].push_back(t);
+                coupling[b].push_back(sqrt(acc[t]));
+            }
+            acc[t] = 0;
+        }
+    }
+
+    // Keep strong couplings
+    std::vector<std::vector<int>> strong(static_cast<unsigned long>(nb));
+    std::vector<std::vector<double>> strength(static_cast<unsigned long>(nb));
+    for (b = 0; b < nb; b++) {
+        for (unsigned long t = 0; t < neighbours[b].size(); t++) {
+            c = neighbours[b][t];
+            if (coupling[b][t] >= this->strength_threshold * sqrt(diagonal[b] * diagonal[c])) {
+                strong[b].push_back(c);
+                strength[b].push_back(coupling[b][t]);
+            }
+        }
+    }
+
+    // Phase 1, blocks whose strong neighbours are free create aggregates
+    std::vector<int> agg(static_cast<unsigned long>(nb), -1);
+    int naggregates = 0;
+    bool free;
+    for (b = 0; b < nb; b++) {
+        if (agg[b] >= 0) continue;
+        free = true;
+        for (int t : strong[b]) {
+            if (agg[t] >= 0) {
+                free = false;
+                break;
+            }
+        }
+        if (!free) continue;
+        agg[b] = naggregates;
+        for (int t : strong[b]) {
+            agg[t] = naggregates;
+        }
+        naggregates += 1;
+    }
+
+    // Phase 2, remaining blocks join the strongest neighbour aggregate
+    std::vector<int> agg_phase1 = agg;
+    double smax;
+    for (b = 0; b < nb; b++) {
+        if (agg_phase1[b] >= 0) continue;
+        smax = -1;
+        for (unsigned long t = 0; t < strong[b].size(); t++) {
+            c = strong[b][t];
+            if (agg_phase1[c] >= 0 && strength[b][t] > smax) {
+                smax = strength[b][t];
+                agg[b] = agg_phase1[c];
+            }
+        }
+    }
+
+    // Phase 3, new aggregates with the free neighbours
+    for (b = 0; b < nb; b++) {
+        if (agg[b] >= 0) continue;
+        agg[b] = naggregates;
+        for (int t : strong[b]) {
+            if (agg[t] < 0) {
+                agg[t] = naggregates;
+            }
+        }
+        naggregates += 1;
+    }
+
+    // Aggregate of each DOF
+    aggregates->resize(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        aggregates->at(static_cast<unsigned long>(i)) = agg[blocks[i]];
+    }
+    return naggregates;
+}
+
+/**
+ * Creates tentative prolongator. The near null space rows of each aggregate are
+ * orthonormalized (modified Gram-Schmidt, B = Q*R), Q is the prolongator block and R the
+ * coarse near null space. Dependent modes are dropped, so each aggregate has at most the
+ * number of modes as coarse DOF.
+ *
+ * @param naggregates Number of aggregates
+ * @param aggregates Aggregate of each DOF
+ * @param B Near null space, row major (n x nmodes)
+ * @param nmodes Number of modes
+ * @param Bc Stores coarse near null space, row major
+ * @param blocks_c Stores the block (aggregate) of each coarse DOF
+ * @return Prolongator, nullptr if there are no coarse DOF
+ */
+FEMatrixSparse *AMGPreconditioner::tentative_prolongator(int naggregates, const std::vector<int> &aggregates,
+                                                         const std::vector<double> &B, int nmodes,
+                                                         std::vector<double> *Bc,
+                                                         std::vector<int> *blocks_c) const {
+    int n = static_cast<int>(aggregates.size());
+    std::vector<std::vector<int>> dofs(static_cast<unsigned long>(naggregates));
+    for (int i = 0; i < n; i++) {
+        dofs[aggregates[i]].push_back(i);
+    }
+
+    // Orthonormalize modes of each aggregate
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(n));
+    std::vector<std::vector<double>> rows(static_cast<unsigned long>(n));
+    Bc->clear();
+    blocks_c->clear();
+    int nc = 0, nd, c, t, k;
+    double r, norm, norm0;
+    for (int a = 0; a < naggregates; a++) {
+        nd = static_cast<int>(dofs[a].size());
+        std::vector<std::vector<double>> q;
+        std::vector<double> R(static_cast<unsigned long>(nmodes * nmodes), 0);
+        for (c = 0; c < nmodes; c++) {
+            std::vector<double> v(static_cast<unsigned long>(nd));
+            norm0 = 0;
+            for (k = 0; k < nd; k++) {
+                v[k] = B[dofs[a][k] * nmodes + c];
+                norm0 += v[k] * v[k];
+            }
+            for (t = 0; t < static_cast<int>(q.size()); t++) {
+                r = 0;
+                for (k = 0; k < nd; k++) {
+                    r += q[t][k] * v[k];
+                }
+                for (k = 0; k < nd; k++) {
+                    v[k] -= r * q[t][k];
+                }
+                R[t * nmodes + c] = r;
+            }
+            norm = 0;
+            for (k = 0; k < nd; k++) {
+                norm += v[k] * v[k];
+            }
+            norm = sqrt(norm);
+            if (norm0 == 0 || norm <= __AMG_QR_TOLERANCE * sqrt(norm0)) continue; // Dependent mode
+            for (k = 0; k < nd; k++) {
+                v[k] /= norm;
+            }
+            R[q.size() * nmodes + c] = norm;
+            q.push_back(v);
+        }
+
+        // Store prolongator columns and coarse modes
+        for (t = 0; t < static_cast<int>(q.size()); t++) {
+            for (k = 0; k < nd; k++) {
+                pattern[dofs[a][k]].push_back(nc + t);
+                rows[dofs[a][k]].push_back(q[t][k]);
+            }
+            for (c = 0; c < nmodes; c++) {
+                Bc->push_back(R[t * nmodes + c]);
+            }
+            blocks_c->push_back(a);
+        }
+        nc += static_cast<int>(q.size());
+    }
+    if (nc == 0) {
+        return nullptr;
+    }
+
+    // Create matrix
+    FEMatrixSparse *Pt = new FEMatrixSparse(n, nc, &pattern, false);
+    for (int i = 0; i < n; i++) {
+        for (unsigned long s = 0; s < pattern[i].size(); s++) {
+            Pt->set(i, pattern[i][s], rows[i][s]);
+        }
+    }
+    return Pt;
+}
+
+/**
+ * Smooth tentative prolongator, P = (I - w*inv(D)*A)*Pt with w = 4/(3*rho(inv(D)*A)).
+ * The spectral radius is estimated by power iterations.
+ *
+ * @param M Matrix storing full rows
+ * @param Pt Tentative prolongator
+ * @return
+ */
+FEMatrixSparse *AMGPreconditioner::smooth_prolongator(const FEMatrixSparse *M, const FEMatrixSparse *Pt) const {
+    int n = M->get_square_dimension();
+    std::vector<double> diagonal(static_cast<unsigned long>(n));
+    int i, k;
+    for (i = 0; i < n; i++) {
+        diagonal[i] = M->get(i, i);
+        if (diagonal[i] <= 0) {
+            throw std::logic_error("[AMG] Matrix diagonal must be positive");
+        }
+    }
+
+    // Estimate spectral radius of inv(D)*A
+    std::vector<double> x(static_cast<unsigned long>(n)), y(static_cast<unsigned long>(n));
+    double rho = 0, norm = 0;
+    for (i = 0; i < n; i++) {
+        x[i] = 1.0 + (i % 7) * 0.1;
+        norm += x[i] * x[i];
+    }
+    norm = sqrt(norm);
+    for (i = 0; i < n; i++) {
+        x[i] /= norm;
+    }
+    for (k = 0; k < __AMG_POWER_ITERATIONS; k++) {
+        M->multiply(x.data(), y.data());
+        rho = 0;
+        for (i = 0; i < n; i++) {
+            y[i] /= diagonal[i];
+            rho += y[i] * y[i];
+        }
+        rho = sqrt(rho);
+        for (i = 0; i < n; i++) {
+            x[i] = y[i] / rho;
+        }
+    }
+    double omega = 4.0 / (3.0 * rho);
+
+    // The pattern of A*Pt contains the pattern of Pt
+    FEMatrixSparse *AP = this->product(M, Pt);
+    const int *row_ptr = AP->get_row_ptr();
+    const int *col_index = AP->get_col_index();
+    const double *values = AP->get_values();
+    FEMatrixSparse *Ps = AP->clone();
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            Ps->set(i, col_index[k], Pt->get(i, col_index[k]) - omega * values[k] / diagonal[i]);
+        }
+    }
+    delete AP;
+    return Ps;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+FNELEM-GPU ALGEBRAIC MULTIGRID
+Smoothed aggregation algebraic multigrid preconditioner.
+
+@package fnelem.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_AMG_H
+#define __FNELEM_MATH_AMG_H
+
+// Include headers
+#include "multigrid.h"
+
+// Constant definition
+#define __AMG_DEFAULT_STRENGTH_THRESHOLD 0.08
+#define __AMG_POWER_ITERATIONS 15
+#define __AMG_QR_TOLERANCE 1e-10
+
+/**
+ * Smoothed aggregation algebraic multigrid preconditioner. Nodes (blocks of DOF) are
+ * grouped into aggregates using the strength of their coupling, each aggregate becomes a
+ * coarse node. The tentative prolongator interpolates the near null space (the rigid body
+ * modes of the structure) within each aggregate, it is orthonormalized and then smoothed
+ * by a damped Jacobi step.
+ */
+class AMGPreconditioner : public Multigrid {
+private:
+
+    // Strength threshold, ||Aij|| >= theta * sqrt(||Aii||*||Ajj||)
+    double strength_threshold = __AMG_DEFAULT_STRENGTH_THRESHOLD;
+
+    // Group blocks into aggregates, returns the number of aggregates
+    int aggregate(const FEMatrixSparse *M, const std::vector<int> &blocks, std::vector<int> *aggregates) const;
+
+    // Creates tentative prolongator from the near null space of each aggregate
+    FEMatrixSparse *tentative_prolongator(int naggregates, const std::vector<int> &aggregates,
+                                          const std::vector<double> &B, int nmodes, std::vector<double> *Bc,
+                                          std::vector<int> *blocks_c) const;
+
+    // Smooth tentative prolongator using a damped Jacobi step
+    FEMatrixSparse *smooth_prolongator(const FEMatrixSparse *M, const FEMatrixSparse *Pt) const;
+
+public:
+
+    // Constructor
+    AMGPreconditioner();
+
+    // Destructor
+    ~AMGPreconditioner() override;
+
+    // Set aggregation strength threshold
+    void set_strength_threshold(double theta);
+
+    // Build hierarchy, blocks stores the node of each DOF and B the near null space (n x modes)
+    void setup(const FEMatrixSparse *K, const std::vector<int> *blocks, const FEMatrix *B);
+
+};
+
+#endif // __FNELEM_MATH_AMG_H
\ No newline at end of file
@@ -0,0 +1,193 @@
+/**
+FNELEM-GPU CONDITION ESTIMATE
+Estimates the 1-norm condition number of a matrix using an existing factorization.
+
+@package fnelem.math
+@author ppizarror
+@date 04/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "condition_estimate.h"
+
+/**
+ * Return sign of each value, zero is considered positive.
+ *
+ * @param y Values
+ * @param n Number of values
+ * @param xi Stores the signs
+ * @return True if signs did not change
+ */
+bool condition_sign(const double *y, int n, double *xi) {
+    bool same = true;
+    double s;
+    for (int i = 0; i < n; i++) {
+        s = (y[i] >= 0) ? 1 : -1;
+        if (s != xi[i]) same = false;
+        xi[i] = s;
+    }
+    return same;
+}
+
+/**
+ * Return 1-norm of a vector.
+ *
+ * @param y Values
+ * @param n Number of values
+ * @return
+ */
+double condition_vector_norm1(const double *y, int n) {
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += fabs(y[i]);
+    }
+    return sum;
+}
+
+/**
+ * Return position of the maximum absolute value.
+ *
+ * @param z Values
+ * @param n Number of values
+ * @return
+ */
+int condition_argmax(const double *z, int n) {
+    int j = 0;
+    for (int i = 1; i < n; i++) {
+        if (fabs(z[i]) > fabs(z[j])) j = i;
+    }
+    return j;
+}
+
+/**
+ * Estimates 1-norm of the inverse, Hager's method with Higham's alternative vector.
+ *
+ * @param n Matrix dimension
+ * @param solve Solves A*x = b in place
+ * @param solve_transpose Solves A'*x = b in place, if nullptr the matrix is symmetric
+ * @param nsolves Returns the number of solves, can be nullptr
+ * @return Estimate of ||inv(A)||_1
+ */
+double condition_inverse_norm1(int n, const ConditionSolve &solve, const ConditionSolve &solve_transpose,
+                               int *nsolves) {
+    if (n < 1) {
+        throw std::logic_error("[CONDITION-ESTIMATE] Invalid matrix dimension");
+    }
+    const ConditionSolve &solve_t = solve_transpose ? solve_transpose : solve;
+    std::vector<double> x(static_cast<unsigned long>(n), 1.0 / n);
+    std::vector<double> xi(static_cast<unsigned long>(n), 0);
+    int i, j, jlast, solves = 1;
+
+    // First estimate uses a vector with all values equal
+    solve(x.data());
+    double est = condition_vector_norm1(x.data(), n), est_old;
+    if (n == 1) {
+        if (nsolves != nullptr) *nsolves = solves;
+        return est;
+    }
+    condition_sign(x.data(), n, xi.data());
+    x = xi;
+    solve_t(x.data());
+    solves += 1;
+    j = condition_argmax(x.data(), n);
+
+    // Hager iterations, x = e_j is the column that maximizes the gradient
+    for (int iter = 2; iter <= __CONDITION_ESTIMATE_MAX_ITERATIONS; iter++) {
+        std::fill(x.begin(), x.end(), 0);
+        x[j] = 1;
+        solve(x.data());
+        solves += 1;
+        est_old = est;
+        est = condition_vector_norm1(x.data(), n);
+        if (condition_sign(x.data(), n, xi.data()) || est <= est_old) { // Converged
+            est = std::max(est, est_old);
+            break;
+        }
+        x = xi;
+        solve_t(x.data());
+        solves += 1;
+        jlast = j;
+        j = condition_argmax(x.data(), n);
+        if (fabs(x[jlast]) == fabs(x[j])) break; // Gradient does not change the column
+    }
+
+    // Higham's alternative vector detects matrices where the iteration stagnates
+    for (i = 0; i < n; i++) {
+        x[i] = ((i % 2 == 0) ? 1 : -1) * (1 + static_cast<double>(i) / (n - 1));
+    }
+    solve(x.data());
+    solves += 1;
+    est = std::max(est, 2 * condition_vector_norm1(x.data(), n) / (3 * n));
+
+    if (nsolves != nullptr) *nsolves = solves;
+    return est;
+}
+
+/**
+ * Computes 1-norm of a dense matrix.
+ *
+ * @param A Matrix
+ * @return Max column sum
+ */
+double condition_norm1(const FEMatrix *A) {
+    int *dim = A->size();
+    int n = dim[0], m = dim[1];
+    delete[] dim;
+    double *a = A->get_array();
+    std::vector<double> sum(static_cast<unsigned long>(m), 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            sum[j] += fabs(a[i * m + j]);
+        }
+    }
+    delete[] a;
+    return *std::max_element(sum.begin(), sum.end());
+}
+
+/**
+ * Computes 1-norm of a sparse matrix.
+ *
+ * @param A Matrix
+ * @return Max column sum
+ */
+double condition_norm1(const FEMatrixSparse *A) {
+    int *dim = A->size();
+    int n = dim[0], m = dim[1];
+    delete[] dim;
+    const int *row_ptr = A->get_row_ptr();
+    const int *col_index = A->get_col_index();
+    const double *values = A->get_values();
+    std::vector<double> sum(static_cast<unsigned long>(m), 0);
+    int j;
+    for (int i = 0; i < n; i++) {
+        for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            j = col_index[k];
+            sum[j] += fabs(values[k]);
+            if (A->is_symmetric() && j != i) { // Upper triangle contribution
+                sum[i] += fabs(values[k]);
+            }
+        }
+    }
+    return *std::max_element(sum.begin(), sum.end());
+}
\ No newline at end of file
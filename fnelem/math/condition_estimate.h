@@ -0,0 +1,85 @@
+/**
+FNELEM-GPU CONDITION ESTIMATE
+Estimates the 1-norm condition number of a matrix using an existing factorization.
+
+@package fnelem.math
+@author ppizarror
+@date 04/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_CONDITION_ESTIMATE_H
+#define __FNELEM_MATH_CONDITION_ESTIMATE_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_sparse.h"
+
+// Library imports
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+// Max number of Hager iterations
+#define __CONDITION_ESTIMATE_MAX_ITERATIONS 5
+
+/**
+ * Solves a system in place, x stores the right hand side and returns the solution.
+ */
+typedef std::function<void(double *x)> ConditionSolve;
+
+/**
+ * Estimates the 1-norm of the inverse using Hager's method with Higham's refinements
+ * (LAPACK xLACON). The inverse is never formed, each iteration solves one system with the
+ * matrix and one with their transpose, usually 4 or 5 solves are enough. The estimate is a
+ * lower bound of the exact norm, and it is exact in most cases.
+ *
+ * @param n Matrix dimension
+ * @param solve Solves A*x = b in place
+ * @param solve_transpose Solves A'*x = b in place, if nullptr the matrix is symmetric
+ * @param nsolves Returns the number of solves, can be nullptr
+ * @return Estimate of ||inv(A)||_1
+ */
+double condition_inverse_norm1(int n, const ConditionSolve &solve, const ConditionSolve &solve_transpose,
+                               int *nsolves);
+
+/**
+ * Computes 1-norm (max column sum) of a dense matrix.
+ *
+ * @param A Matrix
+ * @return
+ */
+double condition_norm1(const FEMatrix *A);
+
+/**
+ * Computes 1-norm (max column sum) of a sparse matrix, symmetric storage is considered.
+ *
+ * @param A Matrix
+ * @return
+ */
+double condition_norm1(const FEMatrixSparse *A);
+
+#endif // __FNELEM_MATH_CONDITION_ESTIMATE_H
\ No newline at end of file
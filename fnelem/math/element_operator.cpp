@@ -0,0 +1,176 @@
+/**
+FNELEM-GPU ELEMENT OPERATOR
+Element by element operator, performs matrix products without assembling the matrix.
+
+@package fnelem.math
+@author ppizarror
+@date 30/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "element_operator.h"
+
+/**
+ * Constructor.
+ *
+ * @param n Dimension of the operator
+ */
+ElementOperator::ElementOperator(int n) {
+    if (n < 1) {
+        throw std::logic_error("[ELEMENT-OPERATOR] Invalid dimension");
+    }
+    this->n = n;
+    this->index_ptr.push_back(0);
+    this->values_ptr.push_back(0);
+    this->diagonal.assign(static_cast<unsigned long>(n), 0);
+}
+
+/**
+ * Destructor.
+ */
+ElementOperator::~ElementOperator() = default;
+
+/**
+ * Adds element.
+ *
+ * @param nblock Element dimension
+ * @param index Position of each element row/column within operator, negative values are skipped
+ * @param block Element values, row major
+ */
+void ElementOperator::add_element(int nblock, const int *index, const double *block) {
+    for (int r = 0; r < nblock; r++) {
+        if (index[r] >= this->n) {
+            throw std::logic_error("[ELEMENT-OPERATOR] Element position overflow operator dimension");
+        }
+    }
+    for (int r = 0; r < nblock; r++) {
+        this->index.push_back(index[r]);
+        if (index[r] >= 0) {
+            this->diagonal[index[r]] += block[r * nblock + r];
+        }
+    }
+    for (int k = 0; k < nblock * nblock; k++) {
+        this->values.push_back(block[k]);
+    }
+    this->index_ptr.push_back(static_cast<long>(this->index.size()));
+    this->values_ptr.push_back(static_cast<long>(this->values.size()));
+}
+
+/**
+ * Set element colors and the pool used to process each color in parallel.
+ *
+ * @param colors Element positions of each color, elements of a color must not share DOF
+ * @param pool Thread pool
+ */
+void ElementOperator::set_parallel(const std::vector<std::vector<int>> &colors, ThreadPool *pool) {
+    this->colors = colors;
+    this->pool = pool;
+}
+
+/**
+ * Adds product of a single element, y += Ke * x(e).
+ *
+ * @param e Element position
+ * @param x Array of n values
+ * @param y Array of n values
+ */
+void ElementOperator::multiply_element(int e, const double *x, double *y) const {
+    const int *idx = this->index.data() + this->index_ptr[e];
+    const double *ke = this->values.data() + this->values_ptr[e];
+    int nblock = static_cast<int>(this->index_ptr[e + 1] - this->index_ptr[e]);
+    double sum;
+    for (int r = 0; r < nblock; r++) {
+        if (idx[r] < 0) continue;
+        sum = 0;
+        for (int s = 0; s < nblock; s++) {
+            if (idx[s] >= 0) sum += ke[r * nblock + s] * x[idx[s]];
+        }
+        y[idx[r]] += sum;
+    }
+}
+
+/**
+ * Performs y = K * x element by element.
+ *
+ * @param x Array of n values
+ * @param y Array of n values
+ */
+void ElementOperator::multiply(const double *x, double *y) const {
+    for (int i = 0; i < this->n; i++) {
+        y[i] = 0;
+    }
+
+    // Serial product
+    if (this->pool == nullptr) {
+        for (int e = 0; e < this->get_number_elements(); e++) {
+            this->multiply_element(e, x, y);
+        }
+        return;
+    }
+
+    // Each color is processed in parallel
+    for (auto &color : this->colors) {
+        this->pool->parallel_for(static_cast<int>(color.size()), [&](int begin, int end) {
+            for (int k = begin; k < end; k++) {
+                this->multiply_element(color[k], x, y);
+            }
+        });
+    }
+}
+
+/**
+ * Return dimension.
+ *
+ * @return
+ */
+int ElementOperator::get_dimension() const {
+    return this->n;
+}
+
+/**
+ * Return number of elements.
+ *
+ * @return
+ */
+int ElementOperator::get_number_elements() const {
+    return static_cast<int>(this->index_ptr.size()) - 1;
+}
+
+/**
+ * Return number of stored element values.
+ *
+ * @return
+ */
+long ElementOperator::get_number_values() const {
+    return static_cast<long>(this->values.size());
+}
+
+/**
+ * Return assembled diagonal, used by the Jacobi preconditioner.
+ *
+ * @return
+ */
+const double *ElementOperator::get_diagonal() const {
+    return this->diagonal.data();
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+FNELEM-GPU ELEMENT OPERATOR
+Element by element operator, performs matrix products without assembling the matrix.
+
+@package fnelem.math
+@author ppizarror
+@date 30/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_ELEMENT_OPERATOR_H
+#define __FNELEM_MATH_ELEMENT_OPERATOR_H
+
+// Include headers
+#include "thread_pool.h"
+
+// Library imports
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Element by element operator, computes y = K*x without assembling K. Each element stores
+ * their DOF position and their dense stiffness, the product gathers x through the DOF
+ * map, multiplies by the element stiffness and scatters the result. Memory depends on the
+ * number of elements and their size. If element colors and a thread pool are defined the
+ * elements of each color are processed in parallel, elements of the same color must not
+ * share DOF so the scatter does not need locks.
+ */
+class ElementOperator {
+private:
+
+    // Dimension of the operator
+    int n = 0;
+
+    // Position of each element within index array [0..nelem]
+    std::vector<long> index_ptr;
+
+    // DOF position of each element, negative values are skipped
+    std::vector<int> index;
+
+    // Position of each element within values array [0..nelem]
+    std::vector<long> values_ptr;
+
+    // Element stiffness values, row major
+    std::vector<double> values;
+
+    // Assembled diagonal
+    std::vector<double> diagonal;
+
+    // Element positions of each color
+    std::vector<std::vector<int>> colors;
+
+    // Thread pool, not owned
+    ThreadPool *pool = nullptr;
+
+    // Adds product of a single element
+    void multiply_element(int e, const double *x, double *y) const;
+
+public:
+
+    // Constructor
+    explicit ElementOperator(int n);
+
+    // Destructor
+    ~ElementOperator();
+
+    // Adds element, A[index[r]][index[s]] = block[r][s]
+    void add_element(int nblock, const int *index, const double *block);
+
+    // Set element colors and the pool used to process each color
+    void set_parallel(const std::vector<std::vector<int>> &colors, ThreadPool *pool);
+
+    // Performs y = K * x, x and y must be arrays of n length
+    void multiply(const double *x, double *y) const;
+
+    // Return dimension
+    int get_dimension() const;
+
+    // Return number of elements
+    int get_number_elements() const;
+
+    // Return number of stored element values
+    long get_number_values() const;
+
+    // Return assembled diagonal
+    const double *get_diagonal() const;
+
+};
+
+#endif // __FNELEM_MATH_ELEMENT_OPERATOR_H
\ No newline at end of file
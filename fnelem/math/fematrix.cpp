@@ -30,6 +30,9 @@ FEMatrix implement a full matrix manipulation environment.
 
 // Include header
 #include "fematrix.h"
+#include "condition_estimate.h"
+#include "fematrix_factorization.h"
+#include "fematrix_gemm.h"
 
 /**
  * Default constructor, used by other class that initialize
@@ -54,6 +57,7 @@ FEMatrix::FEMatrix(int n, int m) {
     this->n = n;
     this->m = m;
     this->mat = new double[n * m];
+    this->capacity = n * m;
     this->fill_zeros();
 }
 
@@ -71,6 +75,7 @@ FEMatrix::FEMatrix(int n, int m, double *matrix) {
     this->n = n;
     this->m = m;
     this->mat = new double[n * m];
+    this->capacity = n * m;
     for (int i = 0; i < n; i++) { // Rows
         for (int j = 0; j < m; j++) { // Columns
             this->mat[i * m + j] = matrix[i * m + j];
@@ -78,6 +83,39 @@ FEMatrix::FEMatrix(int n, int m, double *matrix) {
     }
 }
 
+/**
+ * Copy matrix, dimension, values and origin are copied like clone.
+ *
+ * @param matrix Matrix to copy
+ */
+FEMatrix::FEMatrix(const FEMatrix &matrix) {
+    this->n = matrix.n;
+    this->m = matrix.m;
+    this->mat = new double[matrix.n * matrix.m];
+    this->capacity = matrix.n * matrix.m;
+    std::copy(matrix.mat, matrix.mat + matrix.n * matrix.m, this->mat);
+    this->origin = matrix.origin_temp;
+    this->origin_temp = matrix.origin_temp;
+}
+
+/**
+ * Move matrix, the storage is taken from the other matrix, which becomes empty.
+ *
+ * @param matrix Matrix to move
+ */
+FEMatrix::FEMatrix(FEMatrix &&matrix) noexcept {
+    this->n = matrix.n;
+    this->m = matrix.m;
+    this->mat = matrix.mat;
+    this->capacity = matrix.capacity;
+    this->origin = matrix.origin_temp;
+    this->origin_temp = matrix.origin_temp;
+    matrix.n = 0;
+    matrix.m = 0;
+    matrix.mat = nullptr;
+    matrix.capacity = 0;
+}
+
 /**
  * Destroy matrix.
  */
@@ -87,6 +125,28 @@ FEMatrix::~FEMatrix() {
     this->deleted = true;
 }
 
+/**
+ * Resize matrix. The storage is reused if it has enough capacity, so values are
+ * not preserved and must be written by the caller. Zero dimensions create an empty
+ * matrix, which keeps its storage.
+ *
+ * @param n Number of rows
+ * @param m Number of columns
+ */
+void FEMatrix::resize(int n, int m) {
+    if (n < 0 || m < 0) {
+        throw std::logic_error("[FEMATRIX] Invalid matrix dimension");
+    }
+    if (n * m > this->capacity) {
+        double *newMat = new double[n * m];
+        delete[] this->mat;
+        this->mat = newMat;
+        this->capacity = n * m;
+    }
+    this->n = n;
+    this->m = m;
+}
+
 /**
  * Fill matrix with a certain value.
  *
@@ -346,6 +406,16 @@ double *FEMatrix::get_array() const {
     return mat_array;
 }
 
+/**
+ * Get matrix values without copying them, the array is valid until the matrix is
+ * resized or destroyed.
+ *
+ * @return
+ */
+const double *FEMatrix::get_data() const {
+    return this->mat;
+}
+
 /**
  * Return matrix dimension.
  *
@@ -380,42 +450,48 @@ int FEMatrix::get_square_dimension() const {
 }
 
 /**
- * Asignation operation.
+ * Copy assignation, the storage is reused if it has enough capacity.
  *
- * @param matrix
+ * @param matrix Matrix to copy
  * @return
  */
-FEMatrix &FEMatrix::operator=(const FEMatrix *matrix) {
-
-    // If both matrices have same size
-    if (this->n == matrix->n && this->m == matrix->m) {
-        for (int i = 0; i < this->n; i++) { // Rows
-            for (int j = 0; j < this->m; j++) { // Columns
-                this->_set(i, j, matrix->_get(i, j));
-            }
-        }
-        return *this;
-    }
-
-    // Create new matrix
-    double *newMatrix = new double[matrix->n * matrix->m];
-    this->n = matrix->n;
-    this->m = matrix->m;
-
-    // Assign values
-    for (int i = 0; i < this->n; i++) { // Rows
-        for (int j = 0; j < this->m; j++) { // Columns
-            newMatrix[i * this->m + j] = matrix->_get(i, j);
-        }
-    }
-
-    // Delete actual matrix and update
-    delete[] this->mat;
-    this->mat = newMatrix;
+FEMatrix &FEMatrix::operator=(const FEMatrix &matrix) {
+    if (this == &matrix) return *this;
+    *this = &matrix;
+    this->origin = matrix.origin_temp;
+    this->origin_temp = matrix.origin_temp;
+    return *this;
+}
 
-    // Return actual matrix
+/**
+ * Move assignation, the storage is swapped with the other matrix.
+ *
+ * @param matrix Matrix to move
+ * @return
+ */
+FEMatrix &FEMatrix::operator=(FEMatrix &&matrix) noexcept {
+    if (this == &matrix) return *this;
+    std::swap(this->n, matrix.n);
+    std::swap(this->m, matrix.m);
+    std::swap(this->mat, matrix.mat);
+    std::swap(this->capacity, matrix.capacity);
+    this->origin = matrix.origin_temp;
+    this->origin_temp = matrix.origin_temp;
     return *this;
+}
 
+/**
+ * Asignation operation, only values are copied. Matrix can be empty.
+ *
+ * @param matrix
+ * @return
+ */
+FEMatrix &FEMatrix::operator=(const FEMatrix *matrix) {
+    if (this == matrix) return *this;
+    this->resize(matrix->n, matrix->m);
+    if (matrix->n * matrix->m == 0) return *this;
+    std::copy(matrix->mat, matrix->mat + matrix->n * matrix->m, this->mat);
+    return *this;
 }
 
 /**
@@ -455,15 +531,21 @@ FEMatrix &FEMatrix::operator+=(const FEMatrix *matrix) {
 }
 
 /**
- * Adds with a matrix and return new.
+ * Adds with a matrix, result = self + matrix. Result storage is reused.
  *
  * @param matrix Matrix to add
- * @return
+ * @param result Result matrix, can be self
  */
-FEMatrix *FEMatrix::operator+(const FEMatrix &matrix) const {
-    FEMatrix *newMatrix = this->clone();
-    *newMatrix += matrix;
-    return newMatrix;
+void FEMatrix::add(const FEMatrix &matrix, FEMatrix &result) const {
+    if (matrix.n != this->n || matrix.m != this->m) {
+        throw std::logic_error("[FEMATRIX] Matrix dimension must be the same");
+    }
+    if (&result == &matrix && &result != this) {
+        result += *this;
+        return;
+    }
+    result = this;
+    result += matrix;
 }
 
 /**
@@ -503,30 +585,23 @@ FEMatrix &FEMatrix::operator-=(const FEMatrix *matrix) {
 }
 
 /**
- * Substract with a matrix and return new.
- *
- * @param matrix Matrix to add
- * @return
- */
-FEMatrix *FEMatrix::operator-(const FEMatrix &matrix) const {
-    FEMatrix *newMatrix = this->clone();
-    *newMatrix -= matrix;
-    return newMatrix;
-}
-
-/**
- * Unary substract.
+ * Substract with a matrix, result = self - matrix. Result storage is reused.
  *
- * @return
+ * @param matrix Matrix to substract
+ * @param result Result matrix, can be self
  */
-FEMatrix *FEMatrix::operator-() const {
-    FEMatrix *newMatrix = new FEMatrix(this->n, this->m);
-    for (int i = 0; i < this->n; i++) { // Rows
-        for (int j = 0; j < this->m; j++) { // Columns
-            newMatrix->_set(i, j, -this->_get(i, j));
+void FEMatrix::subtract(const FEMatrix &matrix, FEMatrix &result) const {
+    if (matrix.n != this->n || matrix.m != this->m) {
+        throw std::logic_error("[FEMATRIX] Matrix dimension must be the same");
+    }
+    if (&result == &matrix && &result != this) {
+        for (int k = 0; k < this->n * this->m; k++) {
+            result.mat[k] = this->mat[k] - result.mat[k];
         }
+        return;
     }
-    return newMatrix;
+    result = this;
+    result -= matrix;
 }
 
 /**
@@ -566,14 +641,34 @@ void FEMatrix::transpose_self() {
  *
  * @return New transposed matrix
  */
-FEMatrix *FEMatrix::transpose() const {
-    FEMatrix *matrix = this->clone();
-    matrix->transpose_self();
+FEMatrix FEMatrix::transpose() const {
+    FEMatrix matrix;
+    this->transpose(matrix);
+    matrix.set_origin(this->origin_temp);
     return matrix;
 }
 
 /**
- * Matrix multiplication with self.
+ * Matrix transpose, stored in a given matrix whose storage is reused.
+ *
+ * @param result Transposed matrix, can be self
+ */
+void FEMatrix::transpose(FEMatrix &result) const {
+    if (&result == this) {
+        result.transpose_self();
+        return;
+    }
+    result.resize(this->m, this->n);
+    for (int i = 0; i < this->m; i++) { // Rows
+        for (int j = 0; j < this->n; j++) { // Columns
+            result.mat[i * this->n + j] = this->mat[j * this->m + i];
+        }
+    }
+}
+
+/**
+ * Matrix multiplication with self. The product is computed in a new storage that
+ * replaces the storage of the matrix.
  *
  * @param matrix Matrix to multiply
  * @return
@@ -585,34 +680,17 @@ FEMatrix &FEMatrix::operator*=(const FEMatrix &matrix) {
         throw std::logic_error("[FEMATRIX] Can't multiply matrix, dimension doest not agree");
     }
 
-    // Create new auxiliar matrix AXB = (this) AXN * (matrix) NXB
+    // Multiply, AXB = (this) AXN * (matrix) NXB
     int a = this->n;
     int b = matrix.m;
-    double *auxMatrix = new double[a * b];
-    double sum = 0; // Stores partial sum
-
-    // Multiply
-    for (int i = 0; i < a; i++) { // Rows of new matrix
-        for (int j = 0; j < b; j++) { // Columns of new matrix
-            sum = 0;
-            for (int k = 0; k < this->m; k++) {
-                sum += this->_get(i, k) * matrix._get(k, j);
-            }
-            auxMatrix[i * b + j] = sum;
-        }
-    }
+    double *product = new double[a * b];
+    fematrix_gemm(this->mat, matrix.mat, product, a, this->m, b, nullptr);
 
-    // Update matrix
-    this->n = a;
+    // Update matrix, product can have more columns than self
+    delete[] this->mat;
+    this->mat = product;
     this->m = b;
-    for (int i = 0; i < a; i++) { // Rows of new matrix
-        for (int j = 0; j < b; j++) { // Columns of new matrix
-            this->mat[i * b + j] = auxMatrix[i * b + j];
-        }
-    }
-
-    // Delete matrix
-    delete[] auxMatrix;
+    this->capacity = a * b;
 
     // Return self
     return *this;
@@ -620,27 +698,46 @@ FEMatrix &FEMatrix::operator*=(const FEMatrix &matrix) {
 }
 
 /**
- * Matrix multiplication and return new matrix.
+ * Matrix multiplication, result = self * matrix. Result storage is reused, so it must
+ * be different from both operands.
  *
  * @param matrix Matrix to multiply
- * @return
+ * @param result Result matrix
  */
-FEMatrix *FEMatrix::operator*=(const FEMatrix &matrix) const {
-    FEMatrix *newMatrix = this->clone();
-    *newMatrix *= matrix;
-    return newMatrix;
+void FEMatrix::multiply(const FEMatrix &matrix, FEMatrix &result) const {
+    this->multiply(matrix, result, nullptr);
 }
 
 /**
- * Matrix multiplication and return new matrix.
+ * Matrix multiplication, result = self * matrix. Large products are split over the
+ * thread pool. Result storage is reused, so it must be different from both operands.
  *
  * @param matrix Matrix to multiply
- * @return
+ * @param result Result matrix
+ * @param pool Thread pool, if null the product is serial
  */
-FEMatrix *FEMatrix::operator*(const FEMatrix &matrix) const {
-    FEMatrix *newMatrix = this->clone();
-    *newMatrix *= matrix;
-    return newMatrix;
+void FEMatrix::multiply(const FEMatrix &matrix, FEMatrix &result, ThreadPool *pool) const {
+    if (this->m != matrix.n) {
+        throw std::logic_error("[FEMATRIX] Can't multiply matrix, dimension doest not agree");
+    }
+    if (&result == this || &result == &matrix) {
+        throw std::logic_error("[FEMATRIX] Result matrix must be different from the operands");
+    }
+    result.resize(this->n, matrix.m);
+    fematrix_gemm(this->mat, matrix.mat, result.mat, this->n, this->m, matrix.m, pool);
+}
+
+/**
+ * Write product of two matrices, the operator form of a dense product uses the same
+ * blocked multiplication as multiply. Storage must have the product dimension and be
+ * different from both operands.
+ *
+ * @param e Product expression
+ */
+void FEMatrix::evaluate(const FEMatrixProduct<FEMatrix, FEMatrix> &e) {
+    const FEMatrix &a = e.left();
+    const FEMatrix &b = e.right();
+    fematrix_gemm(a.mat, b.mat, this->mat, a.n, a.m, b.m, nullptr);
 }
 
 /**
@@ -658,18 +755,6 @@ FEMatrix &FEMatrix::operator*=(double a) {
     return *this;
 }
 
-/**
- * Multiply matrix by a constant and return new matrix
- *
- * @param a Constant
- * @return
- */
-FEMatrix *FEMatrix::operator*=(double a) const {
-    FEMatrix *newMatrix = this->clone();
-    *newMatrix *= a;
-    return newMatrix;
-}
-
 /**
  * Clones matrix.
  *
@@ -871,7 +956,7 @@ double FEMatrix::sum() const {
  * @param to Final column position
  * @return
  */
-FEMatrix *FEMatrix::get_row(int i, int from, int to) const {
+FEMatrix FEMatrix::get_row(int i, int from, int to) const {
 
     // Check row consistency
     i -= this->origin;
@@ -885,11 +970,11 @@ FEMatrix *FEMatrix::get_row(int i, int from, int to) const {
     }
 
     // Create new vector
-    FEMatrix *row = new FEMatrix(1, to - from + 1);
+    FEMatrix row(1, to - from + 1);
     for (int j = from; j <= to; j++) { // Columns
-        row->set(0, j - from, this->_get(i, j));
+        row._set(0, j - from, this->_get(i, j));
     }
-    row->set_origin(this->origin_temp);
+    row.set_origin(this->origin_temp);
 
     // Return row vector
     return row;
@@ -902,10 +987,28 @@ FEMatrix *FEMatrix::get_row(int i, int from, int to) const {
  * @param i Row number
  * @return
  */
-FEMatrix *FEMatrix::get_row(int i) const {
+FEMatrix FEMatrix::get_row(int i) const {
     return this->get_row(i, this->origin_temp, this->m);
 }
 
+/**
+ * Get matrix full row, stored in a given matrix whose storage is reused.
+ *
+ * @param i Row number
+ * @param row Row vector
+ */
+void FEMatrix::get_row(int i, FEMatrix &row) const {
+    i -= this->origin;
+    if (i < 0 || i >= this->n) {
+        throw std::logic_error("[FEMATRIX] Row position overflow");
+    }
+    if (&row == this) {
+        throw std::logic_error("[FEMATRIX] Row matrix must be different from self");
+    }
+    row.resize(1, this->m);
+    std::copy(this->mat + i * this->m, this->mat + (i + 1) * this->m, row.mat);
+}
+
 /**
  * Get matrix column.
  *
@@ -914,7 +1017,7 @@ FEMatrix *FEMatrix::get_row(int i) const {
  * @param to Final row position
  * @return
  */
-FEMatrix *FEMatrix::get_column(int j, int from, int to) const {
+FEMatrix FEMatrix::get_column(int j, int from, int to) const {
 
     // Check column consistency
     j -= this->origin;
@@ -928,11 +1031,11 @@ FEMatrix *FEMatrix::get_column(int j, int from, int to) const {
     }
 
     // Create new vector
-    FEMatrix *column = new FEMatrix(to - from + 1, 1);
+    FEMatrix column(to - from + 1, 1);
     for (int i = from; i <= to; i++) { // Columns
-        column->set(i - from, 0, this->_get(i, j));
+        column._set(i - from, 0, this->_get(i, j));
     }
-    column->set_origin(this->origin_temp);
+    column.set_origin(this->origin_temp);
 
     // Return column vector
     return column;
@@ -945,10 +1048,30 @@ FEMatrix *FEMatrix::get_column(int j, int from, int to) const {
  * @param j Column number
  * @return
  */
-FEMatrix *FEMatrix::get_column(int j) const {
+FEMatrix FEMatrix::get_column(int j) const {
     return this->get_column(j, this->origin_temp, this->n);
 }
 
+/**
+ * Get matrix full column, stored in a given matrix whose storage is reused.
+ *
+ * @param j Column number
+ * @param column Column vector
+ */
+void FEMatrix::get_column(int j, FEMatrix &column) const {
+    j -= this->origin;
+    if (j < 0 || j >= this->m) {
+        throw std::logic_error("[FEMATRIX] Column position overflow");
+    }
+    if (&column == this) {
+        throw std::logic_error("[FEMATRIX] Column matrix must be different from self");
+    }
+    column.resize(this->n, 1);
+    for (int i = 0; i < this->n; i++) { // Rows
+        column.mat[i] = this->mat[i * this->m + j];
+    }
+}
+
 /**
  * Return max dimension of matrix, usefull for vectors.
  *
@@ -996,7 +1119,8 @@ bool FEMatrix::operator!=(const FEMatrix &matrix) const {
 }
 
 /**
- * Calculates determinant of the matrix.
+ * Calculates determinant of the matrix, uses LU factorization with partial pivoting. The
+ * matrix is singular only if a pivot is exactly zero, so small determinants are kept.
  *
  * @return
  */
@@ -1004,57 +1128,56 @@ double FEMatrix::det() const {
     if (!this->is_square()) {
         throw std::logic_error("[FEMATRIX] Cannot calculate determinant for a non-square matrix");
     }
-    if (this->n == 1) {
-        return this->_get(0, 0);
+    FEMatrixFactorization fact;
+    try {
+        fact.lu(this, 0);
+    } catch (const std::logic_error &e) { // Singular matrix
+        return 0;
     }
-    return this->_det_recursive(this->mat, this->n);
+    return fact.det();
 }
 
 /**
- * Calculate determinant of the matrix.
+ * Calculates logarithm of the absolute determinant, uses LU factorization with partial
+ * pivoting. It does not overflow for large matrices, the matrix is singular only if a
+ * pivot is exactly zero.
  *
- * @param matrix Submatrix to calcualte determinant
- * @param d Actual dimension of the matrix
- * @return
+ * @param sign Sign of the determinant, -1 or 1, zero if the matrix is singular
+ * @return Logarithm of the absolute determinant, -infinity if the matrix is singular
  */
-double FEMatrix::_det_recursive(double *matrix, int d) const {
-
-    // If dimension is 2
-    if (d == 2) {
-        return matrix[0] * matrix[3] - matrix[1] * matrix[2];
+double FEMatrix::log_det(int *sign) const {
+    if (!this->is_square()) {
+        throw std::logic_error("[FEMATRIX] Cannot calculate determinant for a non-square matrix");
     }
-
-    // Dimension is greather than 2, split matrix into sub-matrices and evaluate
-    int nd = d - 1;
-    int i, j, k, p;
-    double *submat = new double[nd * nd];
-
-    // Iterates submatrices
-    double dsum = 0; // Saves actual sum of the determinant
-    int sign = 1; // Sign
-    for (k = 0; k < d; k++) { // k stores column number
-
-        // Fill submatrix
-        for (i = 0; i < nd; i++) { // Rows
-            for (j = 0; j < nd; j++) { // Column
-                if (j >= k) p = j + 1; // Calculates position in global matrix
-                else p = j;
-                submat[i * nd + j] = matrix[(i + 1) * d + p];
-            }
-        }
-
-        // Calculates recursively and multiply by column value at first row
-        dsum += matrix[k] * this->_det_recursive(submat, nd) * sign;
-        sign *= -1; // Flip sign
-
+    FEMatrixFactorization fact;
+    try {
+        fact.lu(this, 0);
+    } catch (const std::logic_error &e) {
+        *sign = 0;
+        return -std::numeric_limits<double>::infinity();
     }
+    return fact.log_det(sign);
+}
 
-    // Destroy memory
-    delete[] submat;
-
-    // Return value
-    return dsum;
-
+/**
+ * Estimates 1-norm condition number. The matrix is factorized with LU and the norm of the
+ * inverse is estimated from a few triangular solves, the inverse is not computed.
+ *
+ * @return Condition number estimate, infinity if the matrix is singular
+ */
+double FEMatrix::cond() const {
+    if (!this->is_square()) {
+        throw std::logic_error("[FEMATRIX] Cannot calculate condition number for a non-square matrix");
+    }
+    FEMatrixFactorization fact;
+    try {
+        fact.lu(this);
+    } catch (const std::logic_error &e) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double ainv = condition_inverse_norm1(this->n, [&fact](double *x) { fact.solve(x, 1); },
+                                          [&fact](double *x) { fact.solve_transpose(x, 1); }, nullptr);
+    return condition_norm1(this) * ainv;
 }
 
 /**
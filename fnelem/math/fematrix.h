@@ -35,18 +35,28 @@ FEMatrix implements a full matrix manipulation environment.
 // Constant definition
 #define __FEMATRIX_ZERO_TOL 1e-12
 
+// Include headers
+#include "fematrix_expression.h"
+#include "thread_pool.h"
+
 // Library imports
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <math.h>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 /**
  * Matrix class for working with CUDA. Stores matrix in an array [1..n*m].
+ * Matrices are values, operators return an expression that is evaluated when it is
+ * assigned to a matrix. Methods with a result matrix and expression assignments reuse
+ * their storage, so loops only allocate once.
  */
-class FEMatrix {
+class FEMatrix : public FEMatrixExpression<FEMatrix> {
 private:
 
     // Number of rows
@@ -58,6 +68,9 @@ private:
     // Matrix data
     double *mat;
 
+    // Allocated values, storage is reused while the dimension fits
+    int capacity = 0;
+
     // Origin from one
     int origin = 0;
 
@@ -70,12 +83,16 @@ private:
     // Returns value A[i][j], no origin
     double _get(int i, int j) const;
 
+    // Write expression values, storage must have the expression dimension
+    template<class E>
+    void evaluate(const E &e);
+
+    // Write product of two matrices, uses blocked multiplication
+    void evaluate(const FEMatrixProduct<FEMatrix, FEMatrix> &e);
+
     // Uses pad or not to display matrix on console
     bool apply_pad = false;
 
-    // Calcualtes determinant recursive
-    double _det_recursive(double *matrix, int d) const;
-
     // Display a matrix in console
     void disp_matrix(double *matrix, int dim_n, int dim_m, bool norm_exponent, int identation) const;
 
@@ -105,9 +122,22 @@ public:
     // Create matrix from array
     FEMatrix(int n, int m, double *matrix);
 
+    // Copy constructor
+    FEMatrix(const FEMatrix &matrix);
+
+    // Move constructor
+    FEMatrix(FEMatrix &&matrix) noexcept;
+
+    // Create matrix from expression
+    template<class E>
+    FEMatrix(const FEMatrixExpression<E> &expression);
+
     // Destructor
     ~FEMatrix();
 
+    // Resize matrix, values are not preserved
+    void resize(int n, int m);
+
     // Set origin
     void set_origin(int o);
 
@@ -142,16 +172,22 @@ public:
     double get(int i) const;
 
     // Get row
-    FEMatrix *get_row(int i, int from, int to) const;
+    FEMatrix get_row(int i, int from, int to) const;
 
     // Get full row
-    FEMatrix *get_row(int i) const;
+    FEMatrix get_row(int i) const;
+
+    // Get full row, stored in a given matrix
+    void get_row(int i, FEMatrix &row) const;
 
     // Get column
-    FEMatrix *get_column(int j, int from, int to) const;
+    FEMatrix get_column(int j, int from, int to) const;
 
     // Get full column
-    FEMatrix *get_column(int j) const;
+    FEMatrix get_column(int j) const;
+
+    // Get full column, stored in a given matrix
+    void get_column(int j, FEMatrix &column) const;
 
     // Save matrix to file
     void save_to_file(std::string filename) const;
@@ -159,6 +195,9 @@ public:
     // Get matrix array
     double *get_array() const;
 
+    // Get matrix values, no copy is made
+    const double *get_data() const;
+
     // Return matrix dimension [N, M]
     int *size() const;
 
@@ -168,6 +207,16 @@ public:
     // Get square dimension
     int get_square_dimension() const;
 
+    // Copy assign
+    FEMatrix &operator=(const FEMatrix &matrix);
+
+    // Move assign
+    FEMatrix &operator=(FEMatrix &&matrix) noexcept;
+
+    // Evaluate expression
+    template<class E>
+    FEMatrix &operator=(const FEMatrixExpression<E> &expression);
+
     // Assign
     FEMatrix &operator=(const FEMatrix *matrix);
 
@@ -177,8 +226,12 @@ public:
     // Adds a matrix with self
     FEMatrix &operator+=(const FEMatrix *matrix);
 
-    // Add and return a new matrix
-    FEMatrix *operator+(const FEMatrix &matrix) const;
+    // Adds an expression with self
+    template<class E>
+    FEMatrix &operator+=(const FEMatrixExpression<E> &expression);
+
+    // Add, result = self + matrix
+    void add(const FEMatrix &matrix, FEMatrix &result) const;
 
     // Substract a matrix with self
     FEMatrix &operator-=(const FEMatrix &matrix);
@@ -186,32 +239,45 @@ public:
     // Substract a matrix with self
     FEMatrix &operator-=(const FEMatrix *matrix);
 
-    // Substract and return a new matrix
-    FEMatrix *operator-(const FEMatrix &matrix) const;
+    // Substract an expression with self
+    template<class E>
+    FEMatrix &operator-=(const FEMatrixExpression<E> &expression);
 
-    // Unary substract
-    FEMatrix *operator-() const;
+    // Substract, result = self - matrix
+    void subtract(const FEMatrix &matrix, FEMatrix &result) const;
 
     // Matrix transpose
     void transpose_self();
 
     // Matrix transpose and return new
-    FEMatrix *transpose() const;
+    FEMatrix transpose() const;
+
+    // Matrix transpose, stored in a given matrix
+    void transpose(FEMatrix &result) const;
 
     // Matrix multiplication with self
     FEMatrix &operator*=(const FEMatrix &matrix);
 
-    // Matrix multiplication and return new matrix
-    FEMatrix *operator*=(const FEMatrix &matrix) const;
+    // Matrix multiplication, result = self * matrix
+    void multiply(const FEMatrix &matrix, FEMatrix &result) const;
 
-    // Matrix multiplication and return new matrix
-    FEMatrix *operator*(const FEMatrix &matrix) const;
+    // Matrix multiplication over a thread pool, result = self * matrix
+    void multiply(const FEMatrix &matrix, FEMatrix &result, ThreadPool *pool) const;
 
     // Multiply self matrix by a constant
     FEMatrix &operator*=(double a);
 
-    // Multiply matrix by a constant and return new matrix
-    FEMatrix *operator*=(double a) const;
+    // Number of rows
+    int rows() const;
+
+    // Number of columns
+    int columns() const;
+
+    // Returns value A[i][j], no origin
+    double operator()(int i, int j) const;
+
+    // Check if matrix is the given one, used by expressions
+    bool aliases(const FEMatrix *matrix) const;
 
     // Create new matrix
     FEMatrix *clone() const;
@@ -252,6 +318,12 @@ public:
     // Calculate determinant
     double det() const;
 
+    // Calculate logarithm of the absolute determinant, sign stores -1, 0 or 1
+    double log_det(int *sign) const;
+
+    // Estimate 1-norm condition number
+    double cond() const;
+
     // Get norm of vector
     double norm() const;
 
@@ -308,4 +380,145 @@ public:
 
 };
 
+/**
+ * Return number of rows.
+ *
+ * @return
+ */
+inline int FEMatrix::rows() const {
+    return this->n;
+}
+
+/**
+ * Return number of columns.
+ *
+ * @return
+ */
+inline int FEMatrix::columns() const {
+    return this->m;
+}
+
+/**
+ * Returns value A[i][j], indices start from zero.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @return
+ */
+inline double FEMatrix::operator()(int i, int j) const {
+    return this->mat[i * this->m + j];
+}
+
+/**
+ * Check if matrix is the given one, expressions reading self are evaluated in a
+ * temporary matrix.
+ *
+ * @param matrix Matrix
+ * @return
+ */
+inline bool FEMatrix::aliases(const FEMatrix *matrix) const {
+    return this == matrix;
+}
+
+/**
+ * Write expression values in a single loop, storage must have the expression dimension.
+ * Products of two matrices use an overload.
+ *
+ * @param e Expression
+ */
+template<class E>
+void FEMatrix::evaluate(const E &e) {
+    for (int i = 0; i < this->n; i++) { // Rows
+        for (int j = 0; j < this->m; j++) { // Columns
+            this->mat[i * this->m + j] = e(i, j);
+        }
+    }
+}
+
+/**
+ * Creates matrix from expression, values are computed in a single loop.
+ *
+ * @param expression Matrix expression
+ */
+template<class E>
+FEMatrix::FEMatrix(const FEMatrixExpression<E> &expression) {
+    const E &e = expression.self();
+    this->n = e.rows();
+    this->m = e.columns();
+    this->mat = new double[this->n * this->m];
+    this->capacity = this->n * this->m;
+    this->evaluate(e);
+}
+
+/**
+ * Evaluate expression, the storage is reused if it has enough capacity. If the expression
+ * reads self it is evaluated in a new matrix.
+ *
+ * @param expression Matrix expression
+ * @return
+ */
+template<class E>
+FEMatrix &FEMatrix::operator=(const FEMatrixExpression<E> &expression) {
+    const E &e = expression.self();
+    if (e.aliases(this)) {
+        FEMatrix result(expression);
+        std::swap(this->n, result.n);
+        std::swap(this->m, result.m);
+        std::swap(this->mat, result.mat);
+        std::swap(this->capacity, result.capacity);
+        return *this;
+    }
+    this->resize(e.rows(), e.columns());
+    this->evaluate(e);
+    return *this;
+}
+
+/**
+ * Adds an expression with self, if the expression reads self it is evaluated first.
+ *
+ * @param expression Matrix expression
+ * @return
+ */
+template<class E>
+FEMatrix &FEMatrix::operator+=(const FEMatrixExpression<E> &expression) {
+    const E &e = expression.self();
+    if (e.rows() != this->n || e.columns() != this->m) {
+        throw std::logic_error("[FEMATRIX] Matrix dimension must be the same");
+    }
+    if (e.aliases(this)) {
+        FEMatrix result(expression);
+        return *this += result;
+    }
+    for (int i = 0; i < this->n; i++) { // Rows
+        for (int j = 0; j < this->m; j++) { // Columns
+            this->mat[i * this->m + j] += e(i, j);
+        }
+    }
+    return *this;
+}
+
+/**
+ * Substract an expression with self, if the expression reads self it is evaluated first.
+ *
+ * @param expression Matrix expression
+ * @return
+ */
+template<class E>
+FEMatrix &FEMatrix::operator-=(const FEMatrixExpression<E> &expression) {
+    const E &e = expression.self();
+    if (e.rows() != this->n || e.columns() != this->m) {
+        throw std::logic_error("[FEMATRIX] Matrix dimension must be the same");
+    }
+    if (e.aliases(this)) {
+        FEMatrix result(expression);
+        return *this -= result;
+    }
+    for (int i = 0; i < this->n; i++) { // Rows
+        for (int j = 0; j < this->m; j++) { // Columns
+            this->mat[i * this->m + j] -= e(i, j);
+        }
+    }
+    return *this;
+}
+
 #endif // __FNELEM_MATH_FEMATRIX_H
\ No newline at end of file
@@ -0,0 +1,393 @@
+/**
+FNELEM-GPU MATRIX EXPRESSIONS
+Lazily evaluated FEMatrix arithmetic, expressions are computed in a single loop.
+
+@package fnelem.math
+@author ppizarror
+@date 06/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_FEMATRIX_EXPRESSION_H
+#define __FNELEM_MATH_FEMATRIX_EXPRESSION_H
+
+// Library imports
+#include <stdexcept>
+
+// Matrix is the leaf of the expressions
+class FEMatrix;
+
+/**
+ * Base of the lazily evaluated matrix expressions. An expression E defines rows(),
+ * columns(), the value at (i,j) with operator() (indices start from zero, origin is not
+ * used) and aliases(), true if the expression reads a given matrix. Values are computed
+ * when the expression is assigned to a FEMatrix, so chains like a * x + y or
+ * transpose(B) * D * B are evaluated in a single loop without temporary matrices.
+ */
+template<class E>
+class FEMatrixExpression {
+public:
+
+    // Return expression
+    const E &self() const {
+        return static_cast<const E &>(*this);
+    }
+
+};
+
+/**
+ * Stores the operands of an expression. Nodes are stored by value, they only keep
+ * references and scalars, matrices are stored by reference.
+ */
+template<class E>
+class FEMatrixExpressionOperand {
+public:
+
+    // Operand type
+    typedef const E type;
+
+};
+
+/**
+ * Matrices are stored by reference.
+ */
+template<>
+class FEMatrixExpressionOperand<FEMatrix> {
+public:
+
+    // Operand type
+    typedef const FEMatrix &type;
+
+};
+
+/**
+ * Sum of two expressions, a + b.
+ */
+template<class A, class B>
+class FEMatrixSum : public FEMatrixExpression<FEMatrixSum<A, B>> {
+private:
+
+    // Left operand
+    typename FEMatrixExpressionOperand<A>::type a;
+
+    // Right operand
+    typename FEMatrixExpressionOperand<B>::type b;
+
+public:
+
+    // Constructor
+    FEMatrixSum(const A &a, const B &b) : a(a), b(b) {
+        if (a.rows() != b.rows() || a.columns() != b.columns()) {
+            throw std::logic_error("[FEMATRIX] Matrix dimension must be the same");
+        }
+    }
+
+    // Number of rows
+    int rows() const {
+        return this->a.rows();
+    }
+
+    // Number of columns
+    int columns() const {
+        return this->a.columns();
+    }
+
+    // Value (i,j)
+    double operator()(int i, int j) const {
+        return this->a(i, j) + this->b(i, j);
+    }
+
+    // Check if expression reads matrix
+    bool aliases(const FEMatrix *matrix) const {
+        return this->a.aliases(matrix) || this->b.aliases(matrix);
+    }
+
+};
+
+/**
+ * Difference of two expressions, a - b.
+ */
+template<class A, class B>
+class FEMatrixDifference : public FEMatrixExpression<FEMatrixDifference<A, B>> {
+private:
+
+    // Left operand
+    typename FEMatrixExpressionOperand<A>::type a;
+
+    // Right operand
+    typename FEMatrixExpressionOperand<B>::type b;
+
+public:
+
+    // Constructor
+    FEMatrixDifference(const A &a, const B &b) : a(a), b(b) {
+        if (a.rows() != b.rows() || a.columns() != b.columns()) {
+            throw std::logic_error("[FEMATRIX] Matrix dimension must be the same");
+        }
+    }
+
+    // Number of rows
+    int rows() const {
+        return this->a.rows();
+    }
+
+    // Number of columns
+    int columns() const {
+        return this->a.columns();
+    }
+
+    // Value (i,j)
+    double operator()(int i, int j) const {
+        return this->a(i, j) - this->b(i, j);
+    }
+
+    // Check if expression reads matrix
+    bool aliases(const FEMatrix *matrix) const {
+        return this->a.aliases(matrix) || this->b.aliases(matrix);
+    }
+
+};
+
+/**
+ * Expression multiplied by a constant, s * a.
+ */
+template<class A>
+class FEMatrixScale : public FEMatrixExpression<FEMatrixScale<A>> {
+private:
+
+    // Operand
+    typename FEMatrixExpressionOperand<A>::type a;
+
+    // Constant
+    double s;
+
+public:
+
+    // Constructor
+    FEMatrixScale(const A &a, double s) : a(a), s(s) {}
+
+    // Number of rows
+    int rows() const {
+        return this->a.rows();
+    }
+
+    // Number of columns
+    int columns() const {
+        return this->a.columns();
+    }
+
+    // Value (i,j)
+    double operator()(int i, int j) const {
+        return this->s * this->a(i, j);
+    }
+
+    // Check if expression reads matrix
+    bool aliases(const FEMatrix *matrix) const {
+        return this->a.aliases(matrix);
+    }
+
+};
+
+/**
+ * Transpose of an expression, a'.
+ */
+template<class A>
+class FEMatrixTranspose : public FEMatrixExpression<FEMatrixTranspose<A>> {
+private:
+
+    // Operand
+    typename FEMatrixExpressionOperand<A>::type a;
+
+public:
+
+    // Constructor
+    explicit FEMatrixTranspose(const A &a) : a(a) {}
+
+    // Number of rows
+    int rows() const {
+        return this->a.columns();
+    }
+
+    // Number of columns
+    int columns() const {
+        return this->a.rows();
+    }
+
+    // Value (i,j)
+    double operator()(int i, int j) const {
+        return this->a(j, i);
+    }
+
+    // Check if expression reads matrix
+    bool aliases(const FEMatrix *matrix) const {
+        return this->a.aliases(matrix);
+    }
+
+};
+
+/**
+ * Product of two expressions, a * b. Each value is the dot product of a row of a and a
+ * column of b, so a product used as the operand of another product computes their values
+ * again for each use. This is cheap for element matrices; for large chains the inner
+ * product should be assigned to a matrix first.
+ */
+template<class A, class B>
+class FEMatrixProduct : public FEMatrixExpression<FEMatrixProduct<A, B>> {
+private:
+
+    // Left operand
+    typename FEMatrixExpressionOperand<A>::type a;
+
+    // Right operand
+    typename FEMatrixExpressionOperand<B>::type b;
+
+public:
+
+    // Constructor
+    FEMatrixProduct(const A &a, const B &b) : a(a), b(b) {
+        if (a.columns() != b.rows()) {
+            throw std::logic_error("[FEMATRIX] Can't multiply matrix, dimension doest not agree");
+        }
+    }
+
+    // Return left operand
+    const A &left() const {
+        return this->a;
+    }
+
+    // Return right operand
+    const B &right() const {
+        return this->b;
+    }
+
+    // Number of rows
+    int rows() const {
+        return this->a.rows();
+    }
+
+    // Number of columns
+    int columns() const {
+        return this->b.columns();
+    }
+
+    // Value (i,j)
+    double operator()(int i, int j) const {
+        double sum = 0;
+        int n = this->a.columns();
+        for (int k = 0; k < n; k++) {
+            sum += this->a(i, k) * this->b(k, j);
+        }
+        return sum;
+    }
+
+    // Check if expression reads matrix
+    bool aliases(const FEMatrix *matrix) const {
+        return this->a.aliases(matrix) || this->b.aliases(matrix);
+    }
+
+};
+
+/**
+ * Adds two expressions.
+ *
+ * @param a Left expression
+ * @param b Right expression
+ * @return
+ */
+template<class A, class B>
+FEMatrixSum<A, B> operator+(const FEMatrixExpression<A> &a, const FEMatrixExpression<B> &b) {
+    return FEMatrixSum<A, B>(a.self(), b.self());
+}
+
+/**
+ * Substract two expressions.
+ *
+ * @param a Left expression
+ * @param b Right expression
+ * @return
+ */
+template<class A, class B>
+FEMatrixDifference<A, B> operator-(const FEMatrixExpression<A> &a, const FEMatrixExpression<B> &b) {
+    return FEMatrixDifference<A, B>(a.self(), b.self());
+}
+
+/**
+ * Unary substract.
+ *
+ * @param a Expression
+ * @return
+ */
+template<class A>
+FEMatrixScale<A> operator-(const FEMatrixExpression<A> &a) {
+    return FEMatrixScale<A>(a.self(), -1);
+}
+
+/**
+ * Multiply an expression by a constant.
+ *
+ * @param a Expression
+ * @param s Constant
+ * @return
+ */
+template<class A>
+FEMatrixScale<A> operator*(const FEMatrixExpression<A> &a, double s) {
+    return FEMatrixScale<A>(a.self(), s);
+}
+
+/**
+ * Multiply an expression by a constant.
+ *
+ * @param s Constant
+ * @param a Expression
+ * @return
+ */
+template<class A>
+FEMatrixScale<A> operator*(double s, const FEMatrixExpression<A> &a) {
+    return FEMatrixScale<A>(a.self(), s);
+}
+
+/**
+ * Multiply two expressions.
+ *
+ * @param a Left expression
+ * @param b Right expression
+ * @return
+ */
+template<class A, class B>
+FEMatrixProduct<A, B> operator*(const FEMatrixExpression<A> &a, const FEMatrixExpression<B> &b) {
+    return FEMatrixProduct<A, B>(a.self(), b.self());
+}
+
+/**
+ * Transpose an expression, values are not moved.
+ *
+ * @param a Expression
+ * @return
+ */
+template<class A>
+FEMatrixTranspose<A> FEMatrix_transpose(const FEMatrixExpression<A> &a) {
+    return FEMatrixTranspose<A>(a.self());
+}
+
+#endif // __FNELEM_MATH_FEMATRIX_EXPRESSION_H
\ No newline at end of file
@@ -0,0 +1,509 @@
+/**
+FNELEM-GPU DENSE MATRIX FACTORIZATION
+Blocked dense LU and Cholesky factorizations, used to solve systems without computing the inverse.
+
+@package fnelem.math
+@author ppizarror
+@date 29/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "fematrix_factorization.h"
+
+/**
+ * Constructor.
+ */
+FEMatrixFactorization::FEMatrixFactorization() = default;
+
+/**
+ * Destructor.
+ */
+FEMatrixFactorization::~FEMatrixFactorization() {
+    this->destroy();
+}
+
+/**
+ * Delete factorization data.
+ */
+void FEMatrixFactorization::destroy() {
+    delete[] this->a;
+    delete[] this->piv;
+    this->a = nullptr;
+    this->piv = nullptr;
+    this->type = FEMATRIX_FACTORIZATION_NONE;
+}
+
+/**
+ * Copy matrix values.
+ *
+ * @param A Square matrix
+ */
+void FEMatrixFactorization::init(const FEMatrix *A) {
+    if (!A->is_square()) {
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Matrix not square, cannot be factorized");
+    }
+    this->destroy();
+    this->n = A->get_square_dimension();
+    this->a = A->get_array();
+}
+
+/**
+ * Set block size.
+ *
+ * @param size Number of columns of each panel
+ */
+void FEMatrixFactorization::set_block_size(int size) {
+    if (size < 1) {
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Block size must be greater than zero");
+    }
+    this->nb = size;
+}
+
+/**
+ * Get block size.
+ *
+ * @return
+ */
+int FEMatrixFactorization::get_block_size() const {
+    return this->nb;
+}
+
+/**
+ * Computes P*A = L*U using a blocked right looking algorithm with partial pivoting. For
+ * each panel of nb columns:
+ *
+ * 1. The panel is factorized column by column, rows are exchanged along the whole matrix.
+ * 2. U12 = inv(L11)*A12 is computed for the block rows.
+ * 3. The trailing matrix A22 -= L21*U12 is updated by tiles of nb columns.
+ *
+ * L has unit diagonal and is stored below U.
+ *
+ * @param A Square matrix
+ */
+void FEMatrixFactorization::lu(const FEMatrix *A) {
+    this->lu(A, __FEMATRIX_FACTORIZATION_PIVOT_TOLERANCE);
+}
+
+/**
+ * Computes P*A = L*U, the matrix is singular if a pivot is not greater than the tolerance
+ * times the largest absolute value. Zero tolerance only rejects exactly zero pivots.
+ *
+ * @param A Square matrix
+ * @param tolerance Relative pivot tolerance
+ */
+void FEMatrixFactorization::lu(const FEMatrix *A, double tolerance) {
+    if (tolerance < 0) {
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Pivot tolerance cannot be negative");
+    }
+    this->init(A);
+    this->piv = new int[this->n];
+    int n = this->n;
+    double *a = this->a;
+
+    // Pivot tolerance is relative to the largest value
+    double amax = 0;
+    for (int k = 0; k < n * n; k++) {
+        amax = std::max(amax, fabs(a[k]));
+    }
+    double tol = tolerance * amax;
+
+    int i, j, k, p, kb, ke, jb, je;
+    double lik, *ai, *ak;
+    for (kb = 0; kb < n; kb += this->nb) {
+        ke = std::min(kb + this->nb, n);
+
+        // Factorize panel
+        for (k = kb; k < ke; k++) {
+
+            // Find pivot
+            p = k;
+            for (i = k + 1; i < n; i++) {
+                if (fabs(a[i * n + k]) > fabs(a[p * n + k])) p = i;
+            }
+            if (fabs(a[p * n + k]) <= tol) {
+                this->destroy();
+                throw std::logic_error("[FEMATRIX-FACTORIZATION] Matrix is singular, zero pivot at column " +
+                                       std::to_string(k));
+            }
+            this->piv[k] = p;
+            if (p != k) {
+                std::swap_ranges(a + k * n, a + (k + 1) * n, a + p * n);
+            }
+
+            // Compute multipliers and update panel columns
+            ak = a + k * n;
+            for (i = k + 1; i < n; i++) {
+                ai = a + i * n;
+                ai[k] /= ak[k];
+                lik = ai[k];
+                for (j = k + 1; j < ke; j++) {
+                    ai[j] -= lik * ak[j];
+                }
+            }
+
+        }
+
+        // Compute U12
+        for (k = kb; k < ke; k++) {
+            ak = a + k * n;
+            for (i = k + 1; i < ke; i++) {
+                ai = a + i * n;
+                lik = ai[k];
+                for (j = ke; j < n; j++) {
+                    ai[j] -= lik * ak[j];
+                }
+            }
+        }
+
+        // Update trailing matrix by tiles
+        for (jb = ke; jb < n; jb += this->nb) {
+            je = std::min(jb + this->nb, n);
+            for (i = ke; i < n; i++) {
+                ai = a + i * n;
+                for (k = kb; k < ke; k++) {
+                    lik = ai[k];
+                    ak = a + k * n;
+                    for (j = jb; j < je; j++) {
+                        ai[j] -= lik * ak[j];
+                    }
+                }
+            }
+        }
+
+    }
+    this->type = FEMATRIX_FACTORIZATION_LU;
+}
+
+/**
+ * Computes A = L*L' using a blocked right looking algorithm. For each panel of nb columns
+ * the diagonal block is factorized, then L21 = A21*inv(L11') is computed and the lower
+ * triangle of the trailing matrix is updated, A22 -= L21*L21'. All operations are dot
+ * products over contiguous rows.
+ *
+ * @param A Symmetric positive definite matrix
+ */
+void FEMatrixFactorization::cholesky(const FEMatrix *A) {
+    this->init(A);
+    int n = this->n;
+    double *a = this->a;
+
+    int i, j, k, kb, ke, ib, ie, jb, je;
+    double sum, *ai, *aj;
+    for (kb = 0; kb < n; kb += this->nb) {
+        ke = std::min(kb + this->nb, n);
+
+        // Factorize diagonal block
+        for (j = kb; j < ke; j++) {
+            aj = a + j * n;
+            sum = aj[j];
+            for (k = kb; k < j; k++) {
+                sum -= aj[k] * aj[k];
+            }
+            if (sum <= __FEMATRIX_FACTORIZATION_PIVOT_TOLERANCE * fabs(aj[j])) {
+                this->destroy();
+                throw std::logic_error("[FEMATRIX-FACTORIZATION] Matrix is not positive definite at column " +
+                                       std::to_string(j));
+            }
+            aj[j] = sqrt(sum);
+            for (i = j + 1; i < ke; i++) {
+                ai = a + i * n;
+                sum = ai[j];
+                for (k = kb; k < j; k++) {
+                    sum -= ai[k] * aj[k];
+                }
+                ai[j] = sum / aj[j];
+            }
+        }
+
+        // Compute L21
+        for (i = ke; i < n; i++) {
+            ai = a + i * n;
+            for (j = kb; j < ke; j++) {
+                aj = a + j * n;
+                sum = ai[j];
+                for (k = kb; k < j; k++) {
+                    sum -= ai[k] * aj[k];
+                }
+                ai[j] = sum / aj[j];
+            }
+        }
+
+        // Update lower triangle of the trailing matrix by tiles
+        for (ib = ke; ib < n; ib += this->nb) {
+            ie = std::min(ib + this->nb, n);
+            for (jb = ke; jb < ie; jb += this->nb) {
+                je = std::min(jb + this->nb, ie);
+                for (i = ib; i < ie; i++) {
+                    ai = a + i * n;
+                    for (j = jb; j < std::min(je, i + 1); j++) {
+                        aj = a + j * n;
+                        sum = 0;
+                        for (k = kb; k < ke; k++) {
+                            sum += ai[k] * aj[k];
+                        }
+                        ai[j] -= sum;
+                    }
+                }
+            }
+        }
+
+    }
+    this->type = FEMATRIX_FACTORIZATION_CHOLESKY;
+}
+
+/**
+ * Solve A*X = B in place, B rows are updated as vectors so each right hand side is solved
+ * within the same pass over the factor.
+ *
+ * @param b Array of n*nrhs values, row major
+ * @param nrhs Number of right hand sides
+ */
+void FEMatrixFactorization::solve(double *b, int nrhs) const {
+    if (this->type == FEMATRIX_FACTORIZATION_NONE) {
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Matrix has not been factorized");
+    }
+    int n = this->n;
+    const double *a = this->a;
+    int i, j, r;
+    double lij, *bi, *bj;
+
+    // Apply row exchanges
+    if (this->type == FEMATRIX_FACTORIZATION_LU) {
+        for (i = 0; i < n; i++) {
+            if (this->piv[i] != i) {
+                std::swap_ranges(b + i * nrhs, b + (i + 1) * nrhs, b + this->piv[i] * nrhs);
+            }
+        }
+    }
+
+    // Solve L*Y = B
+    for (i = 0; i < n; i++) {
+        bi = b + i * nrhs;
+        for (j = 0; j < i; j++) {
+            lij = a[i * n + j];
+            bj = b + j * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                bi[r] -= lij * bj[r];
+            }
+        }
+        if (this->type == FEMATRIX_FACTORIZATION_CHOLESKY) {
+            for (r = 0; r < nrhs; r++) {
+                bi[r] /= a[i * n + i];
+            }
+        }
+    }
+
+    // Solve U*X = Y or L'*X = Y
+    for (i = n - 1; i >= 0; i--) {
+        bi = b + i * nrhs;
+        if (this->type == FEMATRIX_FACTORIZATION_LU) {
+            for (j = i + 1; j < n; j++) {
+                lij = a[i * n + j];
+                bj = b + j * nrhs;
+                for (r = 0; r < nrhs; r++) {
+                    bi[r] -= lij * bj[r];
+                }
+            }
+            for (r = 0; r < nrhs; r++) {
+                bi[r] /= a[i * n + i];
+            }
+        } else {
+            for (r = 0; r < nrhs; r++) {
+                bi[r] /= a[i * n + i];
+            }
+            for (j = 0; j < i; j++) {
+                lij = a[i * n + j];
+                bj = b + j * nrhs;
+                for (r = 0; r < nrhs; r++) {
+                    bj[r] -= lij * bi[r];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Solve A'*X = B in place. LU solves U'*Y = B and L'*Z = Y, then undoes the row exchanges,
+ * Cholesky factor is symmetric so the system is the same.
+ *
+ * @param b Array of n*nrhs values, row major
+ * @param nrhs Number of right hand sides
+ */
+void FEMatrixFactorization::solve_transpose(double *b, int nrhs) const {
+    if (this->type != FEMATRIX_FACTORIZATION_LU) {
+        this->solve(b, nrhs);
+        return;
+    }
+    int n = this->n;
+    const double *a = this->a;
+    int i, j, r;
+    double uji, *bi, *bj;
+
+    // Solve U'*Y = B
+    for (i = 0; i < n; i++) {
+        bi = b + i * nrhs;
+        for (r = 0; r < nrhs; r++) {
+            bi[r] /= a[i * n + i];
+        }
+        for (j = i + 1; j < n; j++) {
+            uji = a[i * n + j];
+            bj = b + j * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                bj[r] -= uji * bi[r];
+            }
+        }
+    }
+
+    // Solve L'*Z = Y
+    for (i = n - 1; i >= 0; i--) {
+        bi = b + i * nrhs;
+        for (j = 0; j < i; j++) {
+            uji = a[i * n + j];
+            bj = b + j * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                bj[r] -= uji * bi[r];
+            }
+        }
+    }
+
+    // Undo row exchanges
+    for (i = n - 1; i >= 0; i--) {
+        if (this->piv[i] != i) {
+            std::swap_ranges(b + i * nrhs, b + (i + 1) * nrhs, b + this->piv[i] * nrhs);
+        }
+    }
+}
+
+/**
+ * Solve system and return new matrix.
+ *
+ * @param b Right hand side vector or matrix, each column is solved
+ * @return Solution
+ */
+FEMatrix *FEMatrixFactorization::solve(const FEMatrix *b) const {
+    int *dim = b->size();
+    if (dim[0] != this->n) {
+        delete[] dim;
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Right hand side must have the matrix dimension");
+    }
+    double *x = b->get_array();
+    this->solve(x, dim[1]);
+    FEMatrix *sol = new FEMatrix(dim[0], dim[1], x);
+    delete[] dim;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Return factorization type.
+ *
+ * @return FEMATRIX_FACTORIZATION_NONE, LU or CHOLESKY
+ */
+int FEMatrixFactorization::get_type() const {
+    return this->type;
+}
+
+/**
+ * Factorization has been done.
+ *
+ * @return
+ */
+bool FEMatrixFactorization::is_factorized() const {
+    return this->type != FEMATRIX_FACTORIZATION_NONE;
+}
+
+/**
+ * Return dimension of the factorized matrix.
+ *
+ * @return
+ */
+int FEMatrixFactorization::get_dimension() const {
+    return this->n;
+}
+
+/**
+ * Return factor values, row major. LU stores L below the diagonal (unit diagonal is not
+ * stored) and U on the upper triangle, Cholesky stores L on the lower triangle.
+ *
+ * @return
+ */
+const double *FEMatrixFactorization::get_factor() const {
+    return this->a;
+}
+
+/**
+ * Return pivots of LU factorization, row k was exchanged with row piv[k].
+ *
+ * @return
+ */
+const int *FEMatrixFactorization::get_pivots() const {
+    return this->piv;
+}
+
+/**
+ * Return determinant of the factorized matrix, product of the diagonal of U (LU) or the
+ * square of the product of the diagonal of L (Cholesky).
+ *
+ * @return
+ */
+double FEMatrixFactorization::det() const {
+    if (!this->is_factorized()) {
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Matrix has not been factorized");
+    }
+    double det = 1;
+    for (int k = 0; k < this->n; k++) {
+        if (this->type == FEMATRIX_FACTORIZATION_CHOLESKY) {
+            det *= this->a[k * this->n + k] * this->a[k * this->n + k];
+        } else {
+            det *= this->a[k * this->n + k];
+            if (this->piv[k] != k) det = -det;
+        }
+    }
+    return det;
+}
+
+/**
+ * Return logarithm of the absolute determinant, it does not overflow for large matrices.
+ *
+ * @param sign Sign of the determinant, -1 or 1
+ * @return
+ */
+double FEMatrixFactorization::log_det(int *sign) const {
+    if (!this->is_factorized()) {
+        throw std::logic_error("[FEMATRIX-FACTORIZATION] Matrix has not been factorized");
+    }
+    double logdet = 0;
+    double akk;
+    *sign = 1;
+    for (int k = 0; k < this->n; k++) {
+        akk = this->a[k * this->n + k];
+        if (this->type == FEMATRIX_FACTORIZATION_CHOLESKY) {
+            logdet += 2 * log(akk);
+        } else {
+            logdet += log(fabs(akk));
+            if ((akk < 0) != (this->piv[k] != k)) *sign = -*sign;
+        }
+    }
+    return logdet;
+}
\ No newline at end of file
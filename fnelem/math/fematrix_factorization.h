@@ -0,0 +1,139 @@
+/**
+FNELEM-GPU DENSE MATRIX FACTORIZATION
+Blocked dense LU and Cholesky factorizations, used to solve systems without computing the inverse.
+
+@package fnelem.math
+@author ppizarror
+@date 29/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_FEMATRIX_FACTORIZATION_H
+#define __FNELEM_MATH_FEMATRIX_FACTORIZATION_H
+
+// Include headers
+#include "fematrix.h"
+
+// Library imports
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// Constant definition
+#define __FEMATRIX_FACTORIZATION_BLOCK_SIZE 64
+#define __FEMATRIX_FACTORIZATION_PIVOT_TOLERANCE 1e-14
+
+// Factorization type
+#define FEMATRIX_FACTORIZATION_NONE 0
+#define FEMATRIX_FACTORIZATION_LU 1
+#define FEMATRIX_FACTORIZATION_CHOLESKY 2
+
+/**
+ * Dense factor and solve. Computes P*A = L*U with partial pivoting, or A = L*L' if the
+ * matrix is symmetric positive definite. Both factorizations are blocked (right looking),
+ * the panel of each block is factorized and then the trailing matrix is updated tile by
+ * tile, so the updated values stay within cache. Factors are stored in a single row major
+ * array, the matrix inverse is never computed.
+ */
+class FEMatrixFactorization {
+private:
+
+    // Dimension of the matrix
+    int n = 0;
+
+    // Block size
+    int nb = __FEMATRIX_FACTORIZATION_BLOCK_SIZE;
+
+    // Factorization type
+    int type = FEMATRIX_FACTORIZATION_NONE;
+
+    // Factor values, row major
+    double *a = nullptr;
+
+    // Row exchanged with row k during LU factorization
+    int *piv = nullptr;
+
+    // Copy matrix values
+    void init(const FEMatrix *A);
+
+    // Delete factorization data
+    void destroy();
+
+public:
+
+    // Constructor
+    FEMatrixFactorization();
+
+    // Destructor
+    ~FEMatrixFactorization();
+
+    // Set block size
+    void set_block_size(int size);
+
+    // Get block size
+    int get_block_size() const;
+
+    // Computes P*A = L*U
+    void lu(const FEMatrix *A);
+
+    // Computes P*A = L*U, pivots not greater than tolerance times the largest value are singular
+    void lu(const FEMatrix *A, double tolerance);
+
+    // Computes A = L*L', only the lower triangle of A is used
+    void cholesky(const FEMatrix *A);
+
+    // Solve A*X = B in place, B has nrhs columns stored row major
+    void solve(double *b, int nrhs) const;
+
+    // Solve A'*X = B in place, B has nrhs columns stored row major
+    void solve_transpose(double *b, int nrhs) const;
+
+    // Solve system and return new matrix, B can be a vector or a matrix
+    FEMatrix *solve(const FEMatrix *b) const;
+
+    // Return factorization type
+    int get_type() const;
+
+    // Factorization has been done
+    bool is_factorized() const;
+
+    // Return dimension of the factorized matrix
+    int get_dimension() const;
+
+    // Return factor values, L and U share the same array
+    const double *get_factor() const;
+
+    // Return pivots of LU factorization
+    const int *get_pivots() const;
+
+    // Return determinant of the factorized matrix
+    double det() const;
+
+    // Return logarithm of the absolute determinant, sign stores -1 or 1
+    double log_det(int *sign) const;
+
+};
+
+#endif // __FNELEM_MATH_FEMATRIX_FACTORIZATION_H
\ No newline at end of file
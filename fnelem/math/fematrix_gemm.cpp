@@ -0,0 +1,516 @@
+/**
+FNELEM-GPU MATRIX MULTIPLICATION
+Cache blocked dense matrix product with SIMD kernels selected at runtime.
+
+@package fnelem.math
+@author ppizarror
+@date 08/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "fematrix_gemm.h"
+
+// SIMD intrinsics
+#ifdef __FEMATRIX_GEMM_X86
+#include <immintrin.h>
+#endif
+
+// Library imports
+#include <algorithm>
+#include <atomic>
+
+// Micro kernel, adds the product of a packed mr x kc panel of A and a packed kc x nr panel of B to a tile of C
+typedef void (*fematrix_gemm_micro_kernel)(int kc, const double *a, const double *b, double *c, int ldc);
+
+// Dot product kernel
+typedef double (*fematrix_gemm_dot_kernel)(int k, const double *x, const double *y);
+
+// Kernel used by the multiplication, -1 if the processor has not been inspected
+static std::atomic<int> fematrix_gemm_kernel(-1);
+
+// Largest micro tile over all kernels
+#define __FEMATRIX_GEMM_MAX_TILE 128
+
+/**
+ * Scalar micro kernel, tile is 4 x 4.
+ *
+ * @param kc Panel depth
+ * @param a Packed panel of A, 4 values per depth
+ * @param b Packed panel of B, 4 values per depth
+ * @param c Tile of C
+ * @param ldc Leading dimension of C
+ */
+static void fematrix_gemm_micro_scalar(int kc, const double *a, const double *b, double *c, int ldc) {
+    double acc[4][4];
+    int i, j;
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) {
+            acc[i][j] = c[i * ldc + j];
+        }
+    }
+    for (int p = 0; p < kc; p++) {
+        for (i = 0; i < 4; i++) {
+            for (j = 0; j < 4; j++) {
+                acc[i][j] += a[i] * b[j];
+            }
+        }
+        a += 4;
+        b += 4;
+    }
+    for (i = 0; i < 4; i++) {
+        for (j = 0; j < 4; j++) {
+            c[i * ldc + j] = acc[i][j];
+        }
+    }
+}
+
+/**
+ * Scalar dot product, uses four partial sums.
+ *
+ * @param k Length
+ * @param x First array
+ * @param y Second array
+ * @return
+ */
+static double fematrix_gemm_dot_scalar(int k, const double *x, const double *y) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int p = 0;
+    for (; p + 4 <= k; p += 4) {
+        s0 += x[p] * y[p];
+        s1 += x[p + 1] * y[p + 1];
+        s2 += x[p + 2] * y[p + 2];
+        s3 += x[p + 3] * y[p + 3];
+    }
+    for (; p < k; p++) {
+        s0 += x[p] * y[p];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+#ifdef __FEMATRIX_GEMM_X86
+
+/**
+ * AVX2 micro kernel, tile is 6 x 8, accumulators are kept in twelve registers.
+ *
+ * @param kc Panel depth
+ * @param a Packed panel of A, 6 values per depth
+ * @param b Packed panel of B, 8 values per depth
+ * @param c Tile of C
+ * @param ldc Leading dimension of C
+ */
+__attribute__((target("avx2,fma")))
+static void fematrix_gemm_micro_avx2(int kc, const double *a, const double *b, double *c, int ldc) {
+    __m256d acc[6][2];
+    int i;
+    for (i = 0; i < 6; i++) {
+        acc[i][0] = _mm256_loadu_pd(c + i * ldc);
+        acc[i][1] = _mm256_loadu_pd(c + i * ldc + 4);
+    }
+    __m256d b0, b1, ai;
+    for (int p = 0; p < kc; p++) {
+        b0 = _mm256_loadu_pd(b);
+        b1 = _mm256_loadu_pd(b + 4);
+        for (i = 0; i < 6; i++) {
+            ai = _mm256_broadcast_sd(a + i);
+            acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += 6;
+        b += 8;
+    }
+    for (i = 0; i < 6; i++) {
+        _mm256_storeu_pd(c + i * ldc, acc[i][0]);
+        _mm256_storeu_pd(c + i * ldc + 4, acc[i][1]);
+    }
+}
+
+/**
+ * AVX2 dot product.
+ *
+ * @param k Length
+ * @param x First array
+ * @param y Second array
+ * @return
+ */
+__attribute__((target("avx2,fma")))
+static double fematrix_gemm_dot_avx2(int k, const double *x, const double *y) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    int p = 0;
+    for (; p + 8 <= k; p += 8) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + p), _mm256_loadu_pd(y + p), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + p + 4), _mm256_loadu_pd(y + p + 4), s1);
+    }
+    double s[4];
+    _mm256_storeu_pd(s, _mm256_add_pd(s0, s1));
+    double sum = (s[0] + s[1]) + (s[2] + s[3]);
+    for (; p < k; p++) {
+        sum += x[p] * y[p];
+    }
+    return sum;
+}
+
+/**
+ * AVX-512 micro kernel, tile is 8 x 16, accumulators are kept in sixteen registers.
+ *
+ * @param kc Panel depth
+ * @param a Packed panel of A, 8 values per depth
+ * @param b Packed panel of B, 16 values per depth
+ * @param c Tile of C
+ * @param ldc Leading dimension of C
+ */
+__attribute__((target("avx512f")))
+static void fematrix_gemm_micro_avx512(int kc, const double *a, const double *b, double *c, int ldc) {
+    __m512d acc[8][2];
+    int i;
+    for (i = 0; i < 8; i++) {
+        acc[i][0] = _mm512_loadu_pd(c + i * ldc);
+        acc[i][1] = _mm512_loadu_pd(c + i * ldc + 8);
+    }
+    __m512d b0, b1, ai;
+    for (int p = 0; p < kc; p++) {
+        b0 = _mm512_loadu_pd(b);
+        b1 = _mm512_loadu_pd(b + 8);
+        for (i = 0; i < 8; i++) {
+            ai = _mm512_set1_pd(a[i]);
+            acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += 8;
+        b += 16;
+    }
+    for (i = 0; i < 8; i++) {
+        _mm512_storeu_pd(c + i * ldc, acc[i][0]);
+        _mm512_storeu_pd(c + i * ldc + 8, acc[i][1]);
+    }
+}
+
+/**
+ * AVX-512 dot product.
+ *
+ * @param k Length
+ * @param x First array
+ * @param y Second array
+ * @return
+ */
+__attribute__((target("avx512f")))
+static double fematrix_gemm_dot_avx512(int k, const double *x, const double *y) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    int p = 0;
+    for (; p + 16 <= k; p += 16) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + p), _mm512_loadu_pd(y + p), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + p + 8), _mm512_loadu_pd(y + p + 8), s1);
+    }
+    double s[8];
+    _mm512_storeu_pd(s, _mm512_add_pd(s0, s1));
+    double sum = ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+    for (; p < k; p++) {
+        sum += x[p] * y[p];
+    }
+    return sum;
+}
+
+#endif
+
+/**
+ * Packs a mc x kc block of A in panels of mr rows, each panel stores mr values per depth.
+ * Rows beyond the block are filled with zeros.
+ *
+ * @param A First value of the block
+ * @param lda Leading dimension of A
+ * @param mc Block rows
+ * @param kc Block depth
+ * @param mr Panel rows
+ * @param Ap Packed block
+ */
+static void fematrix_gemm_pack_a(const double *A, int lda, int mc, int kc, int mr, double *Ap) {
+    for (int ir = 0; ir < mc; ir += mr) {
+        int rows = std::min(mr, mc - ir);
+        for (int p = 0; p < kc; p++) {
+            for (int i = 0; i < mr; i++) {
+                *Ap++ = i < rows ? A[(ir + i) * lda + p] : 0;
+            }
+        }
+    }
+}
+
+/**
+ * Packs a kc x nc block of B in panels of nr columns, each panel stores nr values per depth.
+ * Columns beyond the block are filled with zeros.
+ *
+ * @param B First value of the block
+ * @param ldb Leading dimension of B
+ * @param kc Block depth
+ * @param nc Block columns
+ * @param nr Panel columns
+ * @param Bp Packed block
+ */
+static void fematrix_gemm_pack_b(const double *B, int ldb, int kc, int nc, int nr, double *Bp) {
+    for (int jr = 0; jr < nc; jr += nr) {
+        int cols = std::min(nr, nc - jr);
+        for (int p = 0; p < kc; p++) {
+            const double *bp = B + p * ldb + jr;
+            for (int j = 0; j < nr; j++) {
+                *Bp++ = j < cols ? bp[j] : 0;
+            }
+        }
+    }
+}
+
+/**
+ * Inspects the processor and returns the widest supported kernel.
+ *
+ * @return Kernel
+ */
+static int fematrix_gemm_detect_kernel() {
+    if (fematrix_gemm_kernel_supported(FEMATRIX_GEMM_KERNEL_AVX512)) {
+        return FEMATRIX_GEMM_KERNEL_AVX512;
+    }
+    if (fematrix_gemm_kernel_supported(FEMATRIX_GEMM_KERNEL_AVX2)) {
+        return FEMATRIX_GEMM_KERNEL_AVX2;
+    }
+    return FEMATRIX_GEMM_KERNEL_SCALAR;
+}
+
+/**
+ * Check the processor supports a kernel.
+ *
+ * @param kernel Kernel
+ * @return
+ */
+bool fematrix_gemm_kernel_supported(int kernel) {
+    switch (kernel) {
+        case FEMATRIX_GEMM_KERNEL_SCALAR:
+            return true;
+#ifdef __FEMATRIX_GEMM_X86
+        case FEMATRIX_GEMM_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case FEMATRIX_GEMM_KERNEL_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * Returns the kernel used by the multiplication, the processor is inspected on first call.
+ *
+ * @return Kernel
+ */
+int fematrix_gemm_get_kernel() {
+    int kernel = fematrix_gemm_kernel.load();
+    if (kernel < 0) {
+        kernel = fematrix_gemm_detect_kernel();
+        fematrix_gemm_kernel.store(kernel);
+    }
+    return kernel;
+}
+
+/**
+ * Set the kernel used by the multiplication, the processor must support it.
+ *
+ * @param kernel Kernel
+ */
+void fematrix_gemm_set_kernel(int kernel) {
+    if (kernel < FEMATRIX_GEMM_KERNEL_SCALAR || kernel > FEMATRIX_GEMM_KERNEL_AVX512) {
+        throw std::logic_error("[FEMATRIX-GEMM] Invalid kernel");
+    }
+    if (!fematrix_gemm_kernel_supported(kernel)) {
+        throw std::logic_error("[FEMATRIX-GEMM] Kernel " + fematrix_gemm_kernel_name(kernel) +
+                               " is not supported by the processor");
+    }
+    fematrix_gemm_kernel.store(kernel);
+}
+
+/**
+ * Returns the name of a kernel.
+ *
+ * @param kernel Kernel
+ * @return
+ */
+std::string fematrix_gemm_kernel_name(int kernel) {
+    switch (kernel) {
+        case FEMATRIX_GEMM_KERNEL_SCALAR:
+            return "scalar";
+        case FEMATRIX_GEMM_KERNEL_AVX2:
+            return "avx2";
+        case FEMATRIX_GEMM_KERNEL_AVX512:
+            return "avx512";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Computes C = A * B, A is n x k, B is k x m and C is n x m, all row major. Blocks of
+ * B are packed once and shared by all threads, each thread packs its own blocks of A.
+ * Packing buffers are kept by each thread, so they are not allocated on every product.
+ *
+ * @param A Left matrix, row major
+ * @param B Right matrix, row major
+ * @param C Result matrix, row major
+ * @param n Rows of A
+ * @param k Columns of A, rows of B
+ * @param m Columns of B
+ * @param pool Thread pool, if null the product is serial
+ */
+void fematrix_gemm(const double *A, const double *B, double *C, int n, int k, int m, ThreadPool *pool) {
+    if (n < 0 || k < 0 || m < 0) {
+        throw std::logic_error("[FEMATRIX-GEMM] Invalid matrix dimension");
+    }
+    if (n == 0 || m == 0) return;
+    std::fill(C, C + n * m, 0.0);
+    if (k == 0) return;
+
+    // Small products are not packed
+    if (static_cast<double>(n) * k * m < __FEMATRIX_GEMM_SMALL_FLOPS) {
+        double aip;
+        for (int i = 0; i < n; i++) {
+            for (int p = 0; p < k; p++) {
+                aip = A[i * k + p];
+                for (int j = 0; j < m; j++) {
+                    C[i * m + j] += aip * B[p * m + j];
+                }
+            }
+        }
+        return;
+    }
+
+    // Select kernel
+    int mr = 4, nr = 4;
+    fematrix_gemm_micro_kernel micro = fematrix_gemm_micro_scalar;
+    fematrix_gemm_dot_kernel dot = fematrix_gemm_dot_scalar;
+#ifdef __FEMATRIX_GEMM_X86
+    int kernel = fematrix_gemm_get_kernel();
+    if (kernel == FEMATRIX_GEMM_KERNEL_AVX2) {
+        mr = 6, nr = 8;
+        micro = fematrix_gemm_micro_avx2;
+        dot = fematrix_gemm_dot_avx2;
+    } else if (kernel == FEMATRIX_GEMM_KERNEL_AVX512) {
+        mr = 8, nr = 16;
+        micro = fematrix_gemm_micro_avx512;
+        dot = fematrix_gemm_dot_avx512;
+    }
+#endif
+
+    // Threads are used only if the product is large enough
+    bool threaded = pool != nullptr && pool->get_threads() > 1 &&
+                    static_cast<double>(n) * k * m >= __FEMATRIX_GEMM_THREADED_MIN_FLOPS;
+
+    // Packed B of the calling thread, it never exceeds KC*NC values
+    static thread_local std::vector<double> Bp;
+
+    // Narrow products, each value is the dot product of a row of A and a column of B. The
+    // columns of B are transposed by blocks of KC rows
+    if (m < __FEMATRIX_GEMM_NARROW) {
+        int kc;
+        for (int pc = 0; pc < k; pc += __FEMATRIX_GEMM_KC) {
+            kc = std::min(__FEMATRIX_GEMM_KC, k - pc);
+            Bp.resize(static_cast<unsigned long>(kc * m));
+            for (int p = 0; p < kc; p++) {
+                for (int j = 0; j < m; j++) {
+                    Bp[j * kc + p] = B[(pc + p) * m + j];
+                }
+            }
+            const double *Bt = Bp.data();
+            std::function<void(int, int)> rows = [A, Bt, C, k, m, kc, pc, dot](int begin, int end) {
+                for (int i = begin; i < end; i++) {
+                    for (int j = 0; j < m; j++) {
+                        C[i * m + j] += dot(kc, A + i * k + pc, Bt + j * kc);
+                    }
+                }
+            };
+            if (threaded) {
+                pool->parallel_for(n, rows);
+            } else {
+                rows(0, n);
+            }
+        }
+        return;
+    }
+
+    // Row block size, large products are split in at least one block per thread
+    int mc = __FEMATRIX_GEMM_MC;
+    if (threaded) {
+        int nth = pool->get_threads();
+        mc = std::min(mc, std::max(mr, ((n + nth - 1) / nth + mr - 1) / mr * mr));
+    } else {
+        mc = std::min(mc, (n + mr - 1) / mr * mr);
+    }
+    int nblocks = (n + mc - 1) / mc;
+
+    int kc, nc;
+    for (int jc = 0; jc < m; jc += __FEMATRIX_GEMM_NC) {
+        nc = std::min(__FEMATRIX_GEMM_NC, m - jc);
+        for (int pc = 0; pc < k; pc += __FEMATRIX_GEMM_KC) {
+            kc = std::min(__FEMATRIX_GEMM_KC, k - pc);
+
+            // Pack block of B
+            Bp.resize(static_cast<unsigned long>(kc * ((nc + nr - 1) / nr * nr)));
+            fematrix_gemm_pack_b(B + pc * m + jc, m, kc, nc, nr, Bp.data());
+            const double *bp = Bp.data();
+
+            // Multiply row blocks
+            std::function<void(int, int)> blocks = [A, C, n, k, m, mr, nr, mc, kc, nc, pc, jc, bp, micro](int begin,
+                                                                                                         int end) {
+                static thread_local std::vector<double> Ap; // Never exceeds MC*KC values
+                Ap.resize(static_cast<unsigned long>(((mc + mr - 1) / mr * mr) * kc));
+                double tile[__FEMATRIX_GEMM_MAX_TILE];
+                for (int b = begin; b < end; b++) {
+                    int ic = b * mc;
+                    int mcb = std::min(mc, n - ic);
+                    fematrix_gemm_pack_a(A + ic * k + pc, k, mcb, kc, mr, Ap.data());
+                    for (int jr = 0; jr < nc; jr += nr) {
+                        int cols = std::min(nr, nc - jr);
+                        for (int ir = 0; ir < mcb; ir += mr) {
+                            int rows = std::min(mr, mcb - ir);
+                            double *c = C + (ic + ir) * m + jc + jr;
+                            if (rows == mr && cols == nr) {
+                                micro(kc, Ap.data() + ir * kc, bp + jr * kc, c, m);
+                                continue;
+                            }
+
+                            // Edge tiles are computed in a local tile
+                            std::fill(tile, tile + mr * nr, 0.0);
+                            micro(kc, Ap.data() + ir * kc, bp + jr * kc, tile, nr);
+                            for (int i = 0; i < rows; i++) {
+                                for (int j = 0; j < cols; j++) {
+                                    c[i * m + j] += tile[i * nr + j];
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+            if (threaded) {
+                pool->parallel_for(nblocks, blocks);
+            } else {
+                blocks(0, nblocks);
+            }
+
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+FNELEM-GPU MATRIX MULTIPLICATION
+Cache blocked dense matrix product with SIMD kernels selected at runtime.
+
+@package fnelem.math
+@author ppizarror
+@date 08/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_FEMATRIX_GEMM_H
+#define __FNELEM_MATH_FEMATRIX_GEMM_H
+
+// Include headers
+#include "thread_pool.h"
+
+// Library imports
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// SIMD kernels are compiled with target attributes, nvcc translation units use the scalar kernel
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__CUDACC__)
+#define __FEMATRIX_GEMM_X86
+#endif
+
+// Constant definition
+#define __FEMATRIX_GEMM_MC 96
+#define __FEMATRIX_GEMM_KC 256
+#define __FEMATRIX_GEMM_NC 2048
+#define __FEMATRIX_GEMM_NARROW 4
+#define __FEMATRIX_GEMM_SMALL_FLOPS 4096
+#define __FEMATRIX_GEMM_THREADED_MIN_FLOPS 2097152
+
+// Multiplication kernels
+#define FEMATRIX_GEMM_KERNEL_SCALAR 0
+#define FEMATRIX_GEMM_KERNEL_AVX2 1
+#define FEMATRIX_GEMM_KERNEL_AVX512 2
+
+/**
+ * Computes C = A * B, A is n x k, B is k x m and C is n x m, all row major. Operands are
+ * packed in cache sized panels and multiplied by a register blocked micro kernel, the
+ * kernel is selected at runtime from the instruction set of the processor. If B has only
+ * a few columns the product is computed as dot products of the rows of A. Large products
+ * are split by row blocks over the thread pool. C must not overlap A or B.
+ *
+ * @param A Left matrix, row major
+ * @param B Right matrix, row major
+ * @param C Result matrix, row major
+ * @param n Rows of A
+ * @param k Columns of A, rows of B
+ * @param m Columns of B
+ * @param pool Thread pool, if null the product is serial
+ */
+void fematrix_gemm(const double *A, const double *B, double *C, int n, int k, int m, ThreadPool *pool);
+
+/**
+ * Returns the kernel used by the multiplication.
+ *
+ * @return Kernel
+ */
+int fematrix_gemm_get_kernel();
+
+/**
+ * Set the kernel used by the multiplication, the processor must support it.
+ *
+ * @param kernel Kernel
+ */
+void fematrix_gemm_set_kernel(int kernel);
+
+/**
+ * Check the processor supports a kernel.
+ *
+ * @param kernel Kernel
+ * @return
+ */
+bool fematrix_gemm_kernel_supported(int kernel);
+
+/**
+ * Returns the name of a kernel.
+ *
+ * @param kernel Kernel
+ * @return
+ */
+std::string fematrix_gemm_kernel_name(int kernel);
+
+#endif // __FNELEM_MATH_FEMATRIX_GEMM_H
\ No newline at end of file
@@ -0,0 +1,459 @@
+/**
+FNELEM-GPU SKYLINE MATRIX DEFINITION
+FEMatrixSkyline stores symmetric banded matrices within their profile and factorizes them in place.
+
+@package fnelem.math
+@author ppizarror
+@date 28/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "fematrix_skyline.h"
+
+/**
+ * Creates skyline matrix from the first non zero column of each row.
+ *
+ * @param n Dimension of the matrix
+ * @param first First column of each row, must be lower or equal than the row
+ */
+FEMatrixSkyline::FEMatrixSkyline(int n, const int *first) {
+    this->init(n, first);
+}
+
+/**
+ * Creates skyline matrix from a sparse symmetric matrix, the envelope is defined by the
+ * first stored column of each row.
+ *
+ * @param matrix Sparse symmetric matrix
+ */
+FEMatrixSkyline::FEMatrixSkyline(const FEMatrixSparse *matrix) {
+    if (!matrix->is_symmetric()) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Sparse matrix must be symmetric");
+    }
+    int nrows = matrix->get_square_dimension();
+    const int *ap = matrix->get_row_ptr();
+    const int *ai = matrix->get_col_index();
+    const double *ax = matrix->get_values();
+
+    // Columns are sorted, so the first stored column defines the envelope
+    int *f = new int[nrows];
+    for (int i = 0; i < nrows; i++) {
+        f[i] = (ap[i] < ap[i + 1]) ? ai[ap[i]] : i;
+    }
+    this->init(nrows, f);
+    delete[] f;
+
+    // Copy values
+    for (int i = 0; i < nrows; i++) {
+        for (int k = ap[i]; k < ap[i + 1]; k++) {
+            this->values[this->row_ptr[i] + ai[k] - this->first[i]] = ax[k];
+        }
+    }
+}
+
+/**
+ * Destroy matrix.
+ */
+FEMatrixSkyline::~FEMatrixSkyline() {
+    delete[] this->first;
+    delete[] this->row_ptr;
+    delete[] this->values;
+}
+
+/**
+ * Create arrays from the first column of each row.
+ *
+ * @param n Dimension of the matrix
+ * @param first First column of each row
+ */
+void FEMatrixSkyline::init(int n, const int *first) {
+    if (n < 1) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Invalid matrix dimension");
+    }
+    this->n = n;
+    this->first = new int[n];
+    this->row_ptr = new long[n + 1];
+    this->row_ptr[0] = 0;
+    for (int i = 0; i < n; i++) {
+        if (first[i] < 0 || first[i] > i) {
+            delete[] this->first;
+            delete[] this->row_ptr;
+            throw std::logic_error("[FEMATRIX-SKYLINE] First column of the row must be within the lower triangle");
+        }
+        this->first[i] = first[i];
+        this->row_ptr[i + 1] = this->row_ptr[i] + i - first[i] + 1;
+    }
+    this->nvalues = this->row_ptr[n];
+    this->values = new double[this->nvalues];
+    this->fill_zeros();
+}
+
+/**
+ * Fill stored values with zeros, factorization is discarded.
+ */
+void FEMatrixSkyline::fill_zeros() {
+    for (long k = 0; k < this->nvalues; k++) {
+        this->values[k] = 0;
+    }
+    this->factorized = false;
+}
+
+/**
+ * Returns position of (i,j) within values array.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @return Position, -1 if the entry is outside the envelope
+ */
+long FEMatrixSkyline::find(int i, int j) const {
+    if (i < 0 || i >= this->n || j < 0 || j >= this->n) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Column or row position overflow matrix");
+    }
+    if (j > i) {
+        std::swap(i, j);
+    }
+    if (j < this->first[i]) {
+        return -1;
+    }
+    return this->row_ptr[i] + j - this->first[i];
+}
+
+/**
+ * Updates matrix value, position must be within the envelope.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @param val Value
+ */
+void FEMatrixSkyline::set(int i, int j, double val) {
+    long k = this->find(i, j);
+    if (k < 0) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Position is outside the matrix envelope");
+    }
+    this->values[k] = val;
+}
+
+/**
+ * Adds value to matrix, position must be within the envelope.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @param val Value to add
+ */
+void FEMatrixSkyline::add(int i, int j, double val) {
+    long k = this->find(i, j);
+    if (k < 0) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Position is outside the matrix envelope");
+    }
+    this->values[k] += val;
+}
+
+/**
+ * Returns matrix value, zero if position is outside the envelope. If the matrix has been
+ * factorized returns L values (i > j) or D values (i = j).
+ *
+ * @param i Row position
+ * @param j Column position
+ * @return Value at matrix[i][j]
+ */
+double FEMatrixSkyline::get(int i, int j) const {
+    long k = this->find(i, j);
+    if (k < 0) {
+        return 0;
+    }
+    return this->values[k];
+}
+
+/**
+ * Return dimension of the matrix.
+ *
+ * @return
+ */
+int FEMatrixSkyline::get_dimension() const {
+    return this->n;
+}
+
+/**
+ * Return number of stored values.
+ *
+ * @return
+ */
+long FEMatrixSkyline::get_nvalues() const {
+    return this->nvalues;
+}
+
+/**
+ * Return profile, number of stored values outside the diagonal.
+ *
+ * @return
+ */
+long FEMatrixSkyline::get_profile() const {
+    return this->nvalues - this->n;
+}
+
+/**
+ * Return maximum row bandwidth.
+ *
+ * @return
+ */
+int FEMatrixSkyline::get_bandwidth() const {
+    int bw = 0;
+    for (int i = 0; i < this->n; i++) {
+        bw = std::max(bw, i - this->first[i]);
+    }
+    return bw;
+}
+
+/**
+ * Performs y = A * x.
+ *
+ * @param x Array of n values
+ * @param y Array of n values
+ */
+void FEMatrixSkyline::multiply(const double *x, double *y) const {
+    if (this->factorized) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Matrix values have been factorized");
+    }
+    int i, j;
+    long k;
+    double sum;
+    for (i = 0; i < this->n; i++) {
+        y[i] = 0;
+    }
+    for (i = 0; i < this->n; i++) { // Rows
+        sum = 0;
+        for (k = this->row_ptr[i], j = this->first[i]; j < i; k++, j++) {
+            sum += this->values[k] * x[j];
+            y[j] += this->values[k] * x[i]; // Upper triangle contribution
+        }
+        y[i] += sum + this->values[k] * x[i];
+    }
+}
+
+/**
+ * Computes L*D*L' factorization in place using the row oriented (Crout) algorithm. For
+ * each row i, first g(i,j) = a(i,j) - sum g(i,k)*l(j,k) is computed within the envelope,
+ * then l(i,j) = g(i,j)/d(j) and d(i) = a(i,i) - sum g(i,j)*l(i,j).
+ */
+void FEMatrixSkyline::factorize() {
+    if (this->factorized) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Matrix has already been factorized");
+    }
+    int i, j, k, kmin;
+    double *row_i, *row_j, sum, dii, aii, lij;
+    for (i = 0; i < this->n; i++) {
+        row_i = this->values + this->row_ptr[i] - this->first[i]; // row_i[j] = A(i,j)
+
+        // Compute g(i,j)
+        for (j = this->first[i]; j < i; j++) {
+            row_j = this->values + this->row_ptr[j] - this->first[j];
+            kmin = std::max(this->first[i], this->first[j]);
+            sum = 0;
+            for (k = kmin; k < j; k++) {
+                sum += row_i[k] * row_j[k];
+            }
+            row_i[j] -= sum;
+        }
+
+        // Compute l(i,j) and d(i)
+        aii = row_i[i];
+        dii = aii;
+        for (j = this->first[i]; j < i; j++) {
+            row_j = this->values + this->row_ptr[j] - this->first[j];
+            lij = row_i[j] / row_j[j];
+            dii -= lij * row_i[j];
+            row_i[j] = lij;
+        }
+        if (fabs(dii) <= __FEMATRIX_SKYLINE_PIVOT_TOLERANCE * fabs(aii) || dii == 0) {
+            throw std::logic_error("[FEMATRIX-SKYLINE] Matrix is singular, zero pivot at row " + std::to_string(i));
+        }
+        row_i[i] = dii;
+    }
+    this->factorized = true;
+}
+
+/**
+ * Values have been factorized.
+ *
+ * @return
+ */
+bool FEMatrixSkyline::is_factorized() const {
+    return this->factorized;
+}
+
+/**
+ * Return determinant of the factorized matrix, product of D values.
+ *
+ * @return
+ */
+double FEMatrixSkyline::det() const {
+    if (!this->factorized) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Matrix has not been factorized");
+    }
+    double det = 1;
+    for (int i = 0; i < this->n; i++) {
+        det *= this->values[this->row_ptr[i + 1] - 1];
+    }
+    return det;
+}
+
+/**
+ * Return logarithm of the absolute determinant, it does not overflow for large matrices.
+ *
+ * @param sign Sign of the determinant, -1 or 1
+ * @return
+ */
+double FEMatrixSkyline::log_det(int *sign) const {
+    if (!this->factorized) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Matrix has not been factorized");
+    }
+    double logdet = 0;
+    double dii;
+    *sign = 1;
+    for (int i = 0; i < this->n; i++) {
+        dii = this->values[this->row_ptr[i + 1] - 1];
+        logdet += log(fabs(dii));
+        if (dii < 0) *sign = -*sign;
+    }
+    return logdet;
+}
+
+/**
+ * Solve L*D*L'*x = b in place.
+ *
+ * @param x Array of n values, stores b and returns the solution
+ */
+void FEMatrixSkyline::solve(double *x) const {
+    this->solve(x, 1);
+}
+
+/**
+ * Solve L*D*L'*X = B in place for several right hand sides, each row of L is applied to
+ * all the columns of B within the same pass.
+ *
+ * @param x Array of n*nrhs values row major, stores B and returns the solution
+ * @param nrhs Number of right hand sides
+ */
+void FEMatrixSkyline::solve(double *x, int nrhs) const {
+    if (!this->factorized) {
+        throw std::logic_error("[FEMATRIX-SKYLINE] Matrix has not been factorized");
+    }
+    int i, j, r;
+    const double *row_i;
+    double lij, dii, *xi, *xj;
+
+    // Solve L*Y = B, row by row
+    for (i = 0; i < this->n; i++) {
+        row_i = this->values + this->row_ptr[i] - this->first[i];
+        xi = x + i * nrhs;
+        for (j = this->first[i]; j < i; j++) {
+            lij = row_i[j];
+            xj = x + j * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                xi[r] -= lij * xj[r];
+            }
+        }
+    }
+
+    // Solve D*Z = Y
+    for (i = 0; i < this->n; i++) {
+        dii = this->values[this->row_ptr[i + 1] - 1];
+        xi = x + i * nrhs;
+        for (r = 0; r < nrhs; r++) {
+            xi[r] /= dii;
+        }
+    }
+
+    // Solve L'*X = Z, column by column
+    for (i = this->n - 1; i >= 0; i--) {
+        row_i = this->values + this->row_ptr[i] - this->first[i];
+        xi = x + i * nrhs;
+        for (j = this->first[i]; j < i; j++) {
+            lij = row_i[j];
+            xj = x + j * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                xj[r] -= lij * xi[r];
+            }
+        }
+    }
+}
+
+/**
+ * Solve system and return new matrix.
+ *
+ * @param b Right hand side vector, or matrix with one right hand side per column
+ * @return Solution
+ */
+FEMatrix *FEMatrixSkyline::solve(const FEMatrix *b) const {
+    int *dim = b->size();
+    if (dim[0] != this->n) {
+        delete[] dim;
+        throw std::logic_error("[FEMATRIX-SKYLINE] Right hand side must have the matrix dimension");
+    }
+    double *x = b->get_array();
+    this->solve(x, dim[1]);
+    FEMatrix *sol = new FEMatrix(dim[0], dim[1], x);
+    delete[] dim;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Creates a dense matrix, the upper triangle is filled. If factorized, the matrix
+ * contains L and D values.
+ *
+ * @return
+ */
+FEMatrix *FEMatrixSkyline::to_dense() const {
+    FEMatrix *dense = new FEMatrix(this->n, this->n);
+    long k;
+    for (int i = 0; i < this->n; i++) { // Rows
+        k = this->row_ptr[i];
+        for (int j = this->first[i]; j <= i; j++) {
+            dense->set(i, j, this->values[k]);
+            dense->set(j, i, this->values[k]);
+            k++;
+        }
+    }
+    return dense;
+}
+
+/**
+ * Display matrix in console, uses dense representation.
+ */
+void FEMatrixSkyline::disp() const {
+    FEMatrix *dense = this->to_dense();
+    dense->set_disp_identation(this->disp_identation);
+    dense->disp();
+    delete dense;
+}
+
+/**
+ * Set output indentation.
+ *
+ * @param identation Identation level
+ */
+void FEMatrixSkyline::set_disp_identation(int identation) {
+    this->disp_identation = identation;
+}
\ No newline at end of file
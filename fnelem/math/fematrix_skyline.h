@@ -0,0 +1,153 @@
+/**
+FNELEM-GPU SKYLINE MATRIX DEFINITION
+FEMatrixSkyline stores symmetric banded matrices within their profile and factorizes them in place.
+
+@package fnelem.math
+@author ppizarror
+@date 28/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_FEMATRIX_SKYLINE_H
+#define __FNELEM_MATH_FEMATRIX_SKYLINE_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_sparse.h"
+
+// Library imports
+#include <cmath>
+#include <stdexcept>
+
+// Constant definition
+#define __FEMATRIX_SKYLINE_PIVOT_TOLERANCE 1e-14
+
+/**
+ * Symmetric matrix stored in skyline (variable band) format. Each row i of the lower
+ * triangle is stored from their first non zero column f(i) to the diagonal, values within
+ * the envelope are stored even if zero. LDL' factorization does not create values outside
+ * the envelope, so it is computed in place, L overwrites the strict lower triangle and D
+ * the diagonal. Memory and operations depend on the profile of the matrix.
+ */
+class FEMatrixSkyline {
+private:
+
+    // Dimension of the matrix
+    int n = 0;
+
+    // Number of stored values, profile plus diagonal
+    long nvalues = 0;
+
+    // First column of each row [0..n-1]
+    int *first = nullptr;
+
+    // Position of the first stored value of each row [0..n]
+    long *row_ptr = nullptr;
+
+    // Stored values, row by row
+    double *values = nullptr;
+
+    // Values have been factorized
+    bool factorized = false;
+
+    // Output identation
+    int disp_identation = 0;
+
+    // Return position of (i,j) within values, -1 if outside the envelope
+    long find(int i, int j) const;
+
+    // Create arrays from the first column of each row
+    void init(int n, const int *first);
+
+public:
+
+    // Constructor from the first column of each row
+    FEMatrixSkyline(int n, const int *first);
+
+    // Constructor from a sparse symmetric matrix, values are copied
+    explicit FEMatrixSkyline(const FEMatrixSparse *matrix);
+
+    // Destructor
+    ~FEMatrixSkyline();
+
+    // Fill stored values with zeros
+    void fill_zeros();
+
+    // Update value A[i][j] = val
+    void set(int i, int j, double val);
+
+    // Adds value A[i][j] += val
+    void add(int i, int j, double val);
+
+    // Returns value A[i][j], or the factorization value if factorized
+    double get(int i, int j) const;
+
+    // Return dimension of the matrix
+    int get_dimension() const;
+
+    // Return number of stored values
+    long get_nvalues() const;
+
+    // Return profile, number of stored values outside the diagonal
+    long get_profile() const;
+
+    // Return maximum row bandwidth
+    int get_bandwidth() const;
+
+    // Performs y = A * x, matrix must not be factorized
+    void multiply(const double *x, double *y) const;
+
+    // Computes L*D*L' factorization in place
+    void factorize();
+
+    // Values have been factorized
+    bool is_factorized() const;
+
+    // Return determinant of the factorized matrix
+    double det() const;
+
+    // Return logarithm of the absolute determinant, sign stores -1 or 1
+    double log_det(int *sign) const;
+
+    // Solve L*D*L'*x = b in place, x array stores b
+    void solve(double *x) const;
+
+    // Solve L*D*L'*X = B in place, B has nrhs columns stored row major
+    void solve(double *x, int nrhs) const;
+
+    // Solve system and return new matrix
+    FEMatrix *solve(const FEMatrix *b) const;
+
+    // Create new dense matrix
+    FEMatrix *to_dense() const;
+
+    // Display matrix in console
+    void disp() const;
+
+    // Set output identation
+    void set_disp_identation(int identation);
+
+};
+
+#endif // __FNELEM_MATH_FEMATRIX_SKYLINE_H
\ No newline at end of file
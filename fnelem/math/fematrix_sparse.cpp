@@ -0,0 +1,446 @@
+/**
+FNELEM-GPU SPARSE MATRIX DEFINITION
+FEMatrixSparse implements a compressed sparse row matrix, used by stiffness assembly.
+
+@package fnelem.math
+@author ppizarror
+@date 24/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "fematrix_sparse.h"
+
+/**
+ * Creates sparse matrix from pattern. Each pattern row contains the column index of the
+ * non zero values, indices can be repeated or unsorted. If matrix is symmetric, only
+ * the values of the lower triangle are kept.
+ *
+ * @param n Number of rows
+ * @param m Number of columns
+ * @param pattern Vector of rows, each one stores the column indices
+ * @param symmetric Store only lower triangle
+ */
+FEMatrixSparse::FEMatrixSparse(int n, int m, std::vector<std::vector<int>> *pattern, bool symmetric) {
+    if (n < 1 || m < 1) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Invalid matrix dimension");
+    }
+    if (symmetric && n != m) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Symmetric matrix must be square");
+    }
+    if (pattern->size() != static_cast<unsigned long>(n)) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Pattern must have the same number of rows as the matrix");
+    }
+    this->n = n;
+    this->m = m;
+    this->symmetric = symmetric;
+
+    // Sort each row and remove duplicates
+    std::vector<std::vector<int>> rows(static_cast<unsigned long>(n));
+    int i;
+    for (i = 0; i < n; i++) {
+        std::vector<int> &row = rows[i];
+        for (int j : pattern->at(static_cast<unsigned long>(i))) {
+            if (j < 0 || j >= m) {
+                throw std::logic_error("[FEMATRIX-SPARSE] Pattern column position overflow");
+            }
+            if (!symmetric || j <= i) {
+                row.push_back(j);
+            }
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        this->nnz += static_cast<int>(row.size());
+    }
+
+    // Create CSR arrays
+    this->row_ptr = new int[n + 1];
+    this->col_index = new int[this->nnz];
+    this->values = new double[this->nnz];
+    int k = 0;
+    for (i = 0; i < n; i++) {
+        this->row_ptr[i] = k;
+        for (int j : rows[i]) {
+            this->col_index[k] = j;
+            k += 1;
+        }
+    }
+    this->row_ptr[n] = k;
+    this->fill_zeros();
+}
+
+/**
+ * Destroy matrix.
+ */
+FEMatrixSparse::~FEMatrixSparse() {
+    delete[] this->row_ptr;
+    delete[] this->col_index;
+    delete[] this->values;
+}
+
+/**
+ * Fill stored values with zeros, the pattern is not modified.
+ */
+void FEMatrixSparse::fill_zeros() {
+    for (int k = 0; k < this->nnz; k++) {
+        this->values[k] = 0;
+    }
+}
+
+/**
+ * Returns position of (i,j) within values array, uses binary search over the row.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @return Position, -1 if the entry is not in the pattern
+ */
+int FEMatrixSparse::find(int i, int j) const {
+    if (i < 0 || i >= this->n || j < 0 || j >= this->m) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Column or row position overflow matrix");
+    }
+    if (this->symmetric && j > i) {
+        std::swap(i, j);
+    }
+    const int *first = this->col_index + this->row_ptr[i];
+    const int *last = this->col_index + this->row_ptr[i + 1];
+    const int *pos = std::lower_bound(first, last, j);
+    if (pos == last || *pos != j) {
+        return -1;
+    }
+    return static_cast<int>(pos - this->col_index);
+}
+
+/**
+ * Updates matrix value, position must be in the pattern.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @param val Value
+ */
+void FEMatrixSparse::set(int i, int j, double val) {
+    int k = this->find(i, j);
+    if (k < 0) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Position is not in the matrix pattern");
+    }
+    this->values[k] = val;
+}
+
+/**
+ * Adds value to matrix, position must be in the pattern.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @param val Value to add
+ */
+void FEMatrixSparse::add(int i, int j, double val) {
+    int k = this->find(i, j);
+    if (k < 0) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Position is not in the matrix pattern");
+    }
+    this->values[k] += val;
+}
+
+/**
+ * Adds a dense block (element stiffness) to the matrix, A[index[r]][index[s]] += block[r][s].
+ * Negative indices are skipped, if symmetric only the lower triangle is added. Positions
+ * must be in the pattern.
+ *
+ * @param nblock Block dimension
+ * @param index Position of each block row/column within matrix
+ * @param block Block values, row major
+ */
+void FEMatrixSparse::assemble(int nblock, const int *index, const double *block) {
+    int i, j, k;
+    for (int r = 0; r < nblock; r++) {
+        i = index[r];
+        if (i < 0) continue;
+        for (int s = 0; s < nblock; s++) {
+            j = index[s];
+            if (j < 0 || (this->symmetric && j > i)) continue;
+            k = this->find(i, j);
+            if (k < 0) {
+                throw std::logic_error("[FEMATRIX-SPARSE] Position is not in the matrix pattern");
+            }
+            this->values[k] += block[r * nblock + s];
+        }
+    }
+}
+
+/**
+ * Returns matrix value, zero if position is not in the pattern.
+ *
+ * @param i Row position
+ * @param j Column position
+ * @return Value at matrix[i][j]
+ */
+double FEMatrixSparse::get(int i, int j) const {
+    int k = this->find(i, j);
+    if (k < 0) {
+        return 0;
+    }
+    return this->values[k];
+}
+
+/**
+ * Return number of stored values.
+ *
+ * @return
+ */
+int FEMatrixSparse::get_nnz() const {
+    return this->nnz;
+}
+
+/**
+ * Return matrix dimension.
+ *
+ * @return
+ */
+int *FEMatrixSparse::size() const {
+    int *dim = new int[2];
+    dim[0] = this->n;
+    dim[1] = this->m;
+    return dim;
+}
+
+/**
+ * Returns square dimension.
+ *
+ * @return
+ */
+int FEMatrixSparse::get_square_dimension() const {
+    if (!this->is_square()) {
+        return 0;
+    } else {
+        return this->n;
+    }
+}
+
+/**
+ * Return true/false if matrix is square.
+ *
+ * @return
+ */
+bool FEMatrixSparse::is_square() const {
+    return this->n == this->m;
+}
+
+/**
+ * Matrix only stores the lower triangle.
+ *
+ * @return
+ */
+bool FEMatrixSparse::is_symmetric() const {
+    return this->symmetric;
+}
+
+/**
+ * Return row pointer array.
+ *
+ * @return
+ */
+const int *FEMatrixSparse::get_row_ptr() const {
+    return this->row_ptr;
+}
+
+/**
+ * Return column index array.
+ *
+ * @return
+ */
+const int *FEMatrixSparse::get_col_index() const {
+    return this->col_index;
+}
+
+/**
+ * Return values array.
+ *
+ * @return
+ */
+const double *FEMatrixSparse::get_values() const {
+    return this->values;
+}
+
+/**
+ * Computes the fingerprint (FNV-1a hash) of the dimension and the pattern, two matrices
+ * with the same fingerprint store the same positions.
+ *
+ * @return
+ */
+unsigned long long FEMatrixSparse::get_pattern_fingerprint() const {
+    unsigned long long h = FEMATRIX_FINGERPRINT_SEED;
+    unsigned char bytes[sizeof(int)];
+    int total = 3 + (this->n + 1) + this->nnz;
+    int v;
+    for (int k = 0; k < total; k++) {
+        if (k == 0) {
+            v = this->n;
+        } else if (k == 1) {
+            v = this->m;
+        } else if (k == 2) {
+            v = this->symmetric ? 1 : 0;
+        } else if (k < 4 + this->n) {
+            v = this->row_ptr[k - 3];
+        } else {
+            v = this->col_index[k - 4 - this->n];
+        }
+        memcpy(bytes, &v, sizeof(int));
+        for (unsigned char b : bytes) {
+            h ^= b;
+            h *= __FEMATRIX_FINGERPRINT_PRIME;
+        }
+    }
+    return h;
+}
+
+/**
+ * Performs y = A * x.
+ *
+ * @param x Array of m values
+ * @param y Array of n values
+ */
+void FEMatrixSparse::multiply(const double *x, double *y) const {
+    int i, j, k;
+    double sum;
+    for (i = 0; i < this->n; i++) {
+        y[i] = 0;
+    }
+    for (i = 0; i < this->n; i++) { // Rows
+        sum = 0;
+        for (k = this->row_ptr[i]; k < this->row_ptr[i + 1]; k++) {
+            j = this->col_index[k];
+            sum += this->values[k] * x[j];
+            if (this->symmetric && j != i) { // Upper triangle contribution
+                y[j] += this->values[k] * x[i];
+            }
+        }
+        y[i] += sum;
+    }
+}
+
+/**
+ * Multiply by a vector or matrix and return new matrix.
+ *
+ * @param matrix Matrix to multiply
+ * @return
+ */
+FEMatrix *FEMatrixSparse::operator*(const FEMatrix &matrix) const {
+    int *dim = matrix.size();
+    int b_n = dim[0], b_m = dim[1];
+    delete[] dim;
+    if (this->m != b_n) {
+        throw std::logic_error("[FEMATRIX-SPARSE] Can't multiply matrix, dimension doest not agree");
+    }
+
+    // Multiply column by column
+    double *b = matrix.get_array();
+    double *x = new double[this->m];
+    double *y = new double[this->n];
+    double *c = new double[this->n * b_m];
+    for (int j = 0; j < b_m; j++) { // Columns
+        for (int i = 0; i < this->m; i++) {
+            x[i] = b[i * b_m + j];
+        }
+        this->multiply(x, y);
+        for (int i = 0; i < this->n; i++) {
+            c[i * b_m + j] = y[i];
+        }
+    }
+    FEMatrix *newMatrix = new FEMatrix(this->n, b_m, c);
+
+    // Delete data
+    delete[] b;
+    delete[] x;
+    delete[] y;
+    delete[] c;
+
+    return newMatrix;
+}
+
+/**
+ * Creates a dense matrix, if symmetric the upper triangle is filled.
+ *
+ * @return
+ */
+FEMatrix *FEMatrixSparse::to_dense() const {
+    FEMatrix *dense = new FEMatrix();
+    this->to_dense(*dense);
+    return dense;
+}
+
+/**
+ * Stores the dense matrix in result, if symmetric the upper triangle is filled.
+ *
+ * @param dense Result matrix, storage is reused if it has enough capacity
+ */
+void FEMatrixSparse::to_dense(FEMatrix &dense) const {
+    dense.resize(this->n, this->m);
+    dense.fill_zeros();
+    int j;
+    for (int i = 0; i < this->n; i++) { // Rows
+        for (int k = this->row_ptr[i]; k < this->row_ptr[i + 1]; k++) {
+            j = this->col_index[k];
+            dense.set(i, j, this->values[k]);
+            if (this->symmetric) {
+                dense.set(j, i, this->values[k]);
+            }
+        }
+    }
+}
+
+/**
+ * Clones matrix.
+ *
+ * @return
+ */
+FEMatrixSparse *FEMatrixSparse::clone() const {
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(this->n));
+    for (int i = 0; i < this->n; i++) {
+        for (int k = this->row_ptr[i]; k < this->row_ptr[i + 1]; k++) {
+            pattern[i].push_back(this->col_index[k]);
+        }
+    }
+    FEMatrixSparse *newMatrix = new FEMatrixSparse(this->n, this->m, &pattern, this->symmetric);
+    for (int k = 0; k < this->nnz; k++) {
+        newMatrix->values[k] = this->values[k];
+    }
+    return newMatrix;
+}
+
+/**
+ * Display matrix in console, uses dense representation.
+ */
+void FEMatrixSparse::disp() const {
+    FEMatrix *dense = this->to_dense();
+    dense->set_disp_identation(this->disp_identation);
+    dense->disp();
+    delete dense;
+}
+
+/**
+ * Set output indentation.
+ *
+ * @param identation Identation level
+ */
+void FEMatrixSparse::set_disp_identation(int identation) {
+    this->disp_identation = identation;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+/**
+FNELEM-GPU SPARSE MATRIX DEFINITION
+FEMatrixSparse implements a compressed sparse row matrix, used by stiffness assembly.
+
+@package fnelem.math
+@author ppizarror
+@date 24/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_FEMATRIX_SPARSE_H
+#define __FNELEM_MATH_FEMATRIX_SPARSE_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_utils.h"
+
+// Library imports
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Sparse matrix stored in compressed sparse row format (CSR). If matrix is
+ * symmetric only the lower triangle (j <= i) is stored. Indices start from zero.
+ */
+class FEMatrixSparse {
+private:
+
+    // Number of rows
+    int n = 0;
+
+    // Number of columns
+    int m = 0;
+
+    // Number of stored non zero values
+    int nnz = 0;
+
+    // Only lower triangle is stored
+    bool symmetric = false;
+
+    // Row pointer [0..n]
+    int *row_ptr;
+
+    // Column index of each stored value [0..nnz-1]
+    int *col_index;
+
+    // Stored values [0..nnz-1]
+    double *values;
+
+    // Output identation
+    int disp_identation = 0;
+
+    // Return position of (i,j) within values, -1 if not in the pattern
+    int find(int i, int j) const;
+
+public:
+
+    // Constructor from pattern, each row stores their column indices
+    FEMatrixSparse(int n, int m, std::vector<std::vector<int>> *pattern, bool symmetric);
+
+    // Copy is not allowed, arrays are owned by the matrix, use clone
+    FEMatrixSparse(const FEMatrixSparse &matrix) = delete;
+
+    // Copy assignation is not allowed, use clone
+    FEMatrixSparse &operator=(const FEMatrixSparse &matrix) = delete;
+
+    // Destructor
+    ~FEMatrixSparse();
+
+    // Fill stored values with zeros
+    void fill_zeros();
+
+    // Update value A[i][j] = val
+    void set(int i, int j, double val);
+
+    // Adds value A[i][j] += val
+    void add(int i, int j, double val);
+
+    // Adds a dense block, A[index[r]][index[s]] += block[r][s]
+    void assemble(int nblock, const int *index, const double *block);
+
+    // Returns value A[i][j]
+    double get(int i, int j) const;
+
+    // Return number of stored values
+    int get_nnz() const;
+
+    // Return matrix dimension [N, M]
+    int *size() const;
+
+    // Get square dimension
+    int get_square_dimension() const;
+
+    // Check if matrix is square nxn
+    bool is_square() const;
+
+    // Check if matrix only stores lower triangle
+    bool is_symmetric() const;
+
+    // Return row pointer array
+    const int *get_row_ptr() const;
+
+    // Return column index array
+    const int *get_col_index() const;
+
+    // Return values array
+    const double *get_values() const;
+
+    // Return fingerprint of the dimension and the pattern, values are not used
+    unsigned long long get_pattern_fingerprint() const;
+
+    // Performs y = A * x, x and y must be arrays of m and n length
+    void multiply(const double *x, double *y) const;
+
+    // Multiply by a vector/matrix and return new matrix
+    FEMatrix *operator*(const FEMatrix &matrix) const;
+
+    // Create new dense matrix
+    FEMatrix *to_dense() const;
+
+    // Store dense matrix in result, its storage is reused
+    void to_dense(FEMatrix &dense) const;
+
+    // Create new sparse matrix
+    FEMatrixSparse *clone() const;
+
+    // Display matrix in console
+    void disp() const;
+
+    // Set output identation
+    void set_disp_identation(int identation);
+
+};
+
+#endif // __FNELEM_MATH_FEMATRIX_SPARSE_H
\ No newline at end of file
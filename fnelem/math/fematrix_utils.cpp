@@ -53,4 +53,30 @@ FEMatrix *FEMatrix_identity(int n) {
  */
 FEMatrix *FEMatrix_vector(int n) {
     return new FEMatrix(n, 1);
+}
+
+/**
+ * Computes the fingerprint (FNV-1a hash) of the matrix dimension and values, continues
+ * from a previous fingerprint. Values are hashed bit by bit, so any change of the values
+ * changes the fingerprint.
+ *
+ * @param matrix Matrix
+ * @param seed Previous fingerprint, or FEMATRIX_FINGERPRINT_SEED
+ * @return
+ */
+unsigned long long FEMatrix_fingerprint(const FEMatrix *matrix, unsigned long long seed) {
+    int *dim = matrix->size();
+    const double *values = matrix->get_data();
+    unsigned long long h = seed;
+    unsigned char bytes[sizeof(double)];
+    for (int k = -2; k < dim[0] * dim[1]; k++) {
+        double v = (k < 0) ? dim[k + 2] : values[k];
+        memcpy(bytes, &v, sizeof(double));
+        for (unsigned char b : bytes) {
+            h ^= b;
+            h *= __FEMATRIX_FINGERPRINT_PRIME;
+        }
+    }
+    delete[] dim;
+    return h;
 }
\ No newline at end of file
@@ -34,6 +34,11 @@ Utilitary functions that use FEMatrix.
 
 // Library imports
 #include "fematrix.h"
+#include <cstring>
+
+// Constant definition
+#define FEMATRIX_FINGERPRINT_SEED 14695981039346656037ULL
+#define __FEMATRIX_FINGERPRINT_PRIME 1099511628211ULL
 
 /**
  * Creates an identity matrix.
@@ -51,4 +56,14 @@ FEMatrix *FEMatrix_identity(int n);
  */
 FEMatrix *FEMatrix_vector(int n);
 
+/**
+ * Computes the fingerprint (FNV-1a hash) of the matrix dimension and values, continues
+ * from a previous fingerprint.
+ *
+ * @param matrix Matrix
+ * @param seed Previous fingerprint, or FEMATRIX_FINGERPRINT_SEED
+ * @return
+ */
+unsigned long long FEMatrix_fingerprint(const FEMatrix *matrix, unsigned long long seed);
+
 #endif // __FNELEM_MATH_FEMATRIX_UTILS_H
\ No newline at end of file
@@ -0,0 +1,219 @@
+/**
+FNELEM-GPU FIXED MATRIX
+Matrix with dimensions known at compile time, stored without heap allocations.
+
+@package fnelem.math
+@author ppizarror
+@date 07/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_FIXED_MATRIX_H
+#define __FNELEM_MATH_FIXED_MATRIX_H
+
+// Include headers
+#include "fematrix.h"
+
+/**
+ * Matrix of R rows and C columns known at compile time, used by the element kernels.
+ * Values are stored in the object (row major), so matrices live in the stack or within
+ * the element. Indices start from zero and are not checked, loops have constant bounds
+ * and can be unrolled and vectorized by the compiler.
+ */
+template<int R, int C>
+class FixedMatrix {
+private:
+
+    // Matrix data
+    double mat[R * C];
+
+    static_assert(R > 0 && C > 0, "[FIXED-MATRIX] Invalid matrix dimension");
+
+public:
+
+    // Constructor, matrix filled with zeros
+    FixedMatrix() {
+        this->fill_zeros();
+    }
+
+    // Number of rows
+    static constexpr int rows() {
+        return R;
+    }
+
+    // Number of columns
+    static constexpr int columns() {
+        return C;
+    }
+
+    // Returns value A[i][j]
+    double operator()(int i, int j) const {
+        return this->mat[i * C + j];
+    }
+
+    // Returns reference to A[i][j]
+    double &operator()(int i, int j) {
+        return this->mat[i * C + j];
+    }
+
+    // Returns value A[i][j]
+    double get(int i, int j) const {
+        return this->mat[i * C + j];
+    }
+
+    // Returns value of vector A[i]
+    double get(int i) const {
+        return this->mat[i];
+    }
+
+    // Update matrix A[i][j] = val
+    void set(int i, int j, double val) {
+        this->mat[i * C + j] = val;
+    }
+
+    // Set value for vector A[i] = val
+    void set(int i, double val) {
+        this->mat[i] = val;
+    }
+
+    // Fill matrix with value
+    void fill(double value) {
+        for (int k = 0; k < R * C; k++) {
+            this->mat[k] = value;
+        }
+    }
+
+    // Fill matrix with zeros
+    void fill_zeros() {
+        this->fill(0);
+    }
+
+    // Get matrix values, row major
+    const double *get_data() const {
+        return this->mat;
+    }
+
+    // Adds a matrix with self
+    FixedMatrix &operator+=(const FixedMatrix &matrix) {
+        for (int k = 0; k < R * C; k++) {
+            this->mat[k] += matrix.mat[k];
+        }
+        return *this;
+    }
+
+    // Substract a matrix with self
+    FixedMatrix &operator-=(const FixedMatrix &matrix) {
+        for (int k = 0; k < R * C; k++) {
+            this->mat[k] -= matrix.mat[k];
+        }
+        return *this;
+    }
+
+    // Multiply self matrix by a constant
+    FixedMatrix &operator*=(double a) {
+        for (int k = 0; k < R * C; k++) {
+            this->mat[k] *= a;
+        }
+        return *this;
+    }
+
+    // Add and return a new matrix
+    FixedMatrix operator+(const FixedMatrix &matrix) const {
+        FixedMatrix result(*this);
+        result += matrix;
+        return result;
+    }
+
+    // Substract and return a new matrix
+    FixedMatrix operator-(const FixedMatrix &matrix) const {
+        FixedMatrix result(*this);
+        result -= matrix;
+        return result;
+    }
+
+    // Multiply matrix by a constant and return new matrix
+    FixedMatrix operator*(double a) const {
+        FixedMatrix result(*this);
+        result *= a;
+        return result;
+    }
+
+    // Matrix multiplication, [RxC]x[CxK] = [RxK]
+    template<int K>
+    FixedMatrix<R, K> operator*(const FixedMatrix<C, K> &matrix) const {
+        FixedMatrix<R, K> result;
+        for (int i = 0; i < R; i++) {
+            for (int k = 0; k < C; k++) {
+                double aik = this->mat[i * C + k];
+                for (int j = 0; j < K; j++) {
+                    result(i, j) += aik * matrix(k, j);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Matrix transpose and return new
+    FixedMatrix<C, R> transpose() const {
+        FixedMatrix<C, R> result;
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                result(j, i) = this->mat[i * C + j];
+            }
+        }
+        return result;
+    }
+
+    // Copy upper triangle to the lower triangle, matrix must be square
+    void make_symmetric() {
+        static_assert(R == C, "[FIXED-MATRIX] Matrix must be square");
+        for (int i = 1; i < R; i++) {
+            for (int j = 0; j < i; j++) {
+                this->mat[i * C + j] = this->mat[j * C + i];
+            }
+        }
+    }
+
+    // Copy values to a matrix, its storage is reused
+    void to_fematrix(FEMatrix &matrix) const {
+        matrix.resize(R, C);
+        matrix.disable_origin();
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                matrix.set(i, j, this->mat[i * C + j]);
+            }
+        }
+        matrix.enable_origin();
+    }
+
+    // Create new matrix
+    FEMatrix *to_fematrix() const {
+        FEMatrix *matrix = new FEMatrix(R, C);
+        this->to_fematrix(*matrix);
+        return matrix;
+    }
+
+};
+
+#endif // __FNELEM_MATH_FIXED_MATRIX_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+/**
+FNELEM-GPU GAUSS JORDAN KERNELS
+Gauss-Jordan inversion steps shared by CUDA and host threads.
+
+@package fnelem.math
+@author ppizarror
+@date 02/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_GAUSS_JORDAN_KERNELS_H
+#define __FNELEM_MATH_GAUSS_JORDAN_KERNELS_H
+
+// Kernels are compiled for host and device if nvcc is used
+#ifdef __CUDACC__
+#define __GAUSS_JORDAN_KERNEL __host__ __device__ inline
+#else
+#define __GAUSS_JORDAN_KERNEL inline
+#endif
+
+/**
+ * Stores the pivot data of step i, applied over each x in [0, n). Array P stores 3n values,
+ * the pivot row of A, the pivot row of I and the elimination factor of each row. Update
+ * reads the pivot data instead of A and I, so all values can be updated in one pass.
+ *
+ * @param A Matrix to inverse, row major
+ * @param I Inverse matrix, row major
+ * @param P Pivot data
+ * @param n Dimension
+ * @param i Pivot position
+ * @param x Row or column position
+ */
+__GAUSS_JORDAN_KERNEL void gauss_jordan_pivot(const double *A, const double *I, double *P, int n, int i, int x) {
+    P[x] = A[i * n + x];
+    P[n + x] = I[i * n + x];
+    P[2 * n + x] = A[x * n + i] / A[i * n + i];
+}
+
+/**
+ * Performs step i of the Gauss-Jordan algorithm over value (x, y). The pivot row is
+ * normalized, the other rows are eliminated and the pivot column is set to zero, this
+ * fuses the normalize, elimination and set zero steps.
+ *
+ * @param A Matrix to inverse, row major
+ * @param I Inverse matrix, row major
+ * @param P Pivot data of step i
+ * @param n Dimension
+ * @param i Pivot position
+ * @param x Row position
+ * @param y Column position
+ */
+__GAUSS_JORDAN_KERNEL void gauss_jordan_update(double *A, double *I, const double *P, int n, int i, int x, int y) {
+    if (x == i) {
+        A[x * n + y] = P[y] / P[i];
+        I[x * n + y] = P[n + y] / P[i];
+    } else {
+        double f = P[2 * n + x];
+        A[x * n + y] = (y == i) ? 0 : A[x * n + y] - f * P[y];
+        I[x * n + y] -= f * P[n + y];
+    }
+}
+
+#endif // __FNELEM_MATH_GAUSS_JORDAN_KERNELS_H
\ No newline at end of file
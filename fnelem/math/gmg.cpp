@@ -0,0 +1,220 @@
+/**
+FNELEM-GPU GEOMETRIC MULTIGRID
+Geometric multigrid preconditioner for structured rectangular grids.
+
+@package fnelem.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "gmg.h"
+
+/**
+ * Constructor.
+ */
+GMGPreconditioner::GMGPreconditioner() = default;
+
+/**
+ * Destructor.
+ */
+GMGPreconditioner::~GMGPreconditioner() = default;
+
+/**
+ * Build hierarchy. Grid lines must be sorted, the grid has x.size() * y.size() nodes
+ * numbered row by row, each node has the same number of components.
+ *
+ * @param K Symmetric positive definite matrix
+ * @param x Vertical grid lines
+ * @param y Horizontal grid lines
+ * @param dof DOF of each node component, position (j*x.size()+i)*ncomp+c, -1 if restrained
+ */
+void GMGPreconditioner::setup(const FEMatrixSparse *K, const std::vector<double> *x, const std::vector<double> *y,
+                              const std::vector<int> *dof) {
+
+    // Check grid
+    int n = K->get_square_dimension();
+    if (n == 0) {
+        throw std::logic_error("[GMG] Matrix must be square");
+    }
+    unsigned long nnodes = x->size() * y->size();
+    if (nnodes == 0 || dof->size() % nnodes != 0) {
+        throw std::logic_error("[GMG] DOF vector must have the same number of components for each grid node");
+    }
+    int ncomp = static_cast<int>(dof->size() / nnodes);
+    std::vector<bool> used(static_cast<unsigned long>(n), false);
+    int nused = 0;
+    for (int d : *dof) {
+        if (d >= n) {
+            throw std::logic_error("[GMG] DOF position overflow matrix dimension");
+        }
+        if (d >= 0 && !used[d]) {
+            used[d] = true;
+            nused += 1;
+        }
+    }
+    if (nused != n) {
+        throw std::logic_error("[GMG] Grid DOF do not match matrix dimension");
+    }
+    this->destroy();
+
+    // Coarsen until the dimension is small
+    std::vector<double> xl = *x, yl = *y;
+    std::vector<int> dofl = *dof;
+    this->A.push_back(this->full(K));
+    while (n > this->coarse_size && static_cast<int>(this->A.size()) < this->max_levels) {
+        std::vector<double> xc = this->coarse_lines(xl);
+        std::vector<double> yc = this->coarse_lines(yl);
+        if (xc.size() == xl.size() && yc.size() == yl.size()) break; // Grid cannot be coarsened
+
+        // Prolongator and coarse matrix
+        std::vector<int> dofc;
+        int nc = 0;
+        FEMatrixSparse *Pl = this->grid_prolongator(xl, yl, dofl, n, xc, yc, ncomp, &dofc, &nc);
+        if (Pl == nullptr) break;
+        this->add_level(Pl);
+
+        // Next level
+        n = nc;
+        xl = xc;
+        yl = yc;
+        dofl = dofc;
+    }
+
+    // Factorize coarsest matrix
+    this->factorize_coarse();
+
+}
+
+/**
+ * Returns coarse grid lines, keeps even positions and the last line. Grids of one cell
+ * are not coarsened.
+ *
+ * @param lines Grid lines
+ * @return
+ */
+std::vector<double> GMGPreconditioner::coarse_lines(const std::vector<double> &lines) const {
+    if (lines.size() <= 2) {
+        return lines;
+    }
+    std::vector<double> coarse;
+    for (unsigned long i = 0; i < lines.size(); i += 2) {
+        coarse.push_back(lines[i]);
+    }
+    if (lines.size() % 2 == 0) {
+        coarse.push_back(lines.back());
+    }
+    return coarse;
+}
+
+/**
+ * Creates bilinear prolongator. Coarse lines are a subset of the fine lines, each fine
+ * node interpolates the (up to four) nodes of the coarse cell containing it.
+ *
+ * @param xf Fine vertical lines
+ * @param yf Fine horizontal lines
+ * @param dof_f DOF of each fine node component
+ * @param ndof_f Number of fine DOF
+ * @param xc Coarse vertical lines
+ * @param yc Coarse horizontal lines
+ * @param ncomp Number of components of each node
+ * @param dof_c Stores DOF of each coarse node component
+ * @param ndof_c Stores number of coarse DOF
+ * @return Prolongator, nullptr if the coarse grid has no DOF
+ */
+FEMatrixSparse *GMGPreconditioner::grid_prolongator(const std::vector<double> &xf, const std::vector<double> &yf,
+                                                    const std::vector<int> &dof_f, int ndof_f,
+                                                    const std::vector<double> &xc, const std::vector<double> &yc,
+                                                    int ncomp, std::vector<int> *dof_c, int *ndof_c) const {
+
+    // Coarse DOF are free if the fine node at the same position is free
+    int nxf = static_cast<int>(xf.size()), nxc = static_cast<int>(xc.size()), nyc = static_cast<int>(yc.size());
+    dof_c->assign(static_cast<unsigned long>(nxc * nyc * ncomp), -1);
+    int i, j, c, ic, jc;
+    *ndof_c = 0;
+    for (jc = 0; jc < nyc; jc++) {
+        j = static_cast<int>(std::lower_bound(yf.begin(), yf.end(), yc[jc]) - yf.begin());
+        for (ic = 0; ic < nxc; ic++) {
+            i = static_cast<int>(std::lower_bound(xf.begin(), xf.end(), xc[ic]) - xf.begin());
+            for (c = 0; c < ncomp; c++) {
+                if (dof_f[(j * nxf + i) * ncomp + c] >= 0) {
+                    dof_c->at(static_cast<unsigned long>((jc * nxc + ic) * ncomp + c)) = *ndof_c;
+                    *ndof_c += 1;
+                }
+            }
+        }
+    }
+    if (*ndof_c == 0 || *ndof_c >= ndof_f) {
+        return nullptr;
+    }
+
+    // Linear interpolation weights of each line
+    auto weights = [](const std::vector<double> &coarse, double v, int *pos, double *w) {
+        int k = static_cast<int>(std::lower_bound(coarse.begin(), coarse.end(), v) - coarse.begin());
+        if (coarse[k] == v) {
+            pos[0] = k;
+            w[0] = 1;
+            return 1;
+        }
+        pos[0] = k - 1;
+        pos[1] = k;
+        w[1] = (v - coarse[k - 1]) / (coarse[k] - coarse[k - 1]);
+        w[0] = 1 - w[1];
+        return 2;
+    };
+
+    // Interpolate each fine DOF
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(ndof_f));
+    std::vector<std::vector<double>> rows(static_cast<unsigned long>(ndof_f));
+    int px[2], py[2], npx, npy, row, col;
+    double wx[2], wy[2];
+    for (j = 0; j < static_cast<int>(yf.size()); j++) {
+        npy = weights(yc, yf[j], py, wy);
+        for (i = 0; i < nxf; i++) {
+            npx = weights(xc, xf[i], px, wx);
+            for (c = 0; c < ncomp; c++) {
+                row = dof_f[(j * nxf + i) * ncomp + c];
+                if (row < 0) continue;
+                for (int b = 0; b < npy; b++) {
+                    for (int a = 0; a < npx; a++) {
+                        col = dof_c->at(static_cast<unsigned long>((py[b] * nxc + px[a]) * ncomp + c));
+                        if (col < 0) continue; // Restrained coarse DOF
+                        pattern[row].push_back(col);
+                        rows[row].push_back(wx[a] * wy[b]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Create matrix
+    FEMatrixSparse *Pl = new FEMatrixSparse(ndof_f, *ndof_c, &pattern, false);
+    for (row = 0; row < ndof_f; row++) {
+        for (unsigned long s = 0; s < pattern[row].size(); s++) {
+            Pl->set(row, pattern[row][s], rows[row][s]);
+        }
+    }
+    return Pl;
+
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/**
+FNELEM-GPU GEOMETRIC MULTIGRID
+Geometric multigrid preconditioner for structured rectangular grids.
+
+@package fnelem.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_GMG_H
+#define __FNELEM_MATH_GMG_H
+
+// Include headers
+#include "multigrid.h"
+
+/**
+ * Geometric multigrid preconditioner for structured rectangular grids. The grid is given
+ * by their vertical (x) and horizontal (y) lines and the DOF of each grid node. Coarse
+ * grids keep every other line (and the last one), so each coarse cell merges a patch of
+ * 2x2 cells; the prolongator is the bilinear interpolation of the coarse nodes, which is
+ * exact for the bilinear membrane, thus P'*K*P equals the stiffness of the merged cells.
+ * Restrained DOF of the fine grid are also restrained in the coarse grid.
+ */
+class GMGPreconditioner : public Multigrid {
+private:
+
+    // Returns coarse grid lines, keeps even positions and the last line
+    std::vector<double> coarse_lines(const std::vector<double> &lines) const;
+
+    // Creates bilinear prolongator from the coarse grid to the fine grid
+    FEMatrixSparse *grid_prolongator(const std::vector<double> &xf, const std::vector<double> &yf,
+                                     const std::vector<int> &dof_f, int ndof_f, const std::vector<double> &xc,
+                                     const std::vector<double> &yc, int ncomp, std::vector<int> *dof_c,
+                                     int *ndof_c) const;
+
+public:
+
+    // Constructor
+    GMGPreconditioner();
+
+    // Destructor
+    ~GMGPreconditioner() override;
+
+    // Build hierarchy, dof stores the DOF of each node component ((j*nx+i)*ncomp+c), -1 if restrained
+    void setup(const FEMatrixSparse *K, const std::vector<double> *x, const std::vector<double> *y,
+               const std::vector<int> *dof);
+
+};
+
+#endif // __FNELEM_MATH_GMG_H
\ No newline at end of file
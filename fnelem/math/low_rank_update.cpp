@@ -0,0 +1,204 @@
+/**
+FNELEM-GPU LOW-RANK UPDATE
+Sherman-Morrison-Woodbury update of a factorized matrix.
+
+@package fnelem.math
+@author ppizarror
+@date 04/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "low_rank_update.h"
+
+/**
+ * Constructor.
+ */
+LowRankUpdate::LowRankUpdate() = default;
+
+/**
+ * Destructor.
+ */
+LowRankUpdate::~LowRankUpdate() {
+    this->destroy();
+}
+
+/**
+ * Delete update data.
+ */
+void LowRankUpdate::destroy() {
+    delete[] this->delta;
+    delete[] this->W;
+    delete this->capacitance;
+    this->delta = nullptr;
+    this->W = nullptr;
+    this->capacitance = nullptr;
+    this->index.clear();
+    this->n = 0;
+}
+
+/**
+ * Computes the update of a factorized matrix. Each updated row is solved using the original
+ * factorization, and the capacitance matrix I + D*E'*W is factorized using LU.
+ *
+ * @param n Dimension of the matrix
+ * @param rows Updated rows, must not be repeated
+ * @param values Change of the matrix values within the updated rows, s*s row major
+ * @param solve Solves the original system in place
+ */
+void LowRankUpdate::update(int n, const std::vector<int> &rows, const double *values, const LowRankSolve &solve) {
+    this->destroy();
+    int s = static_cast<int>(rows.size());
+    if (n < 1) {
+        throw std::logic_error("[LOW-RANK-UPDATE] Invalid matrix dimension");
+    }
+    for (int k = 0; k < s; k++) {
+        if (rows[k] < 0 || rows[k] >= n) {
+            throw std::logic_error("[LOW-RANK-UPDATE] Updated row overflow matrix dimension");
+        }
+    }
+    if (s == 0) {
+        return;
+    }
+    int i, j, k;
+
+    // Solve the original system for each updated row, W = inv(A)*E
+    double *W = new double[n * s];
+    std::fill(W, W + n * s, 0);
+    for (k = 0; k < s; k++) {
+        W[rows[k] * s + k] = 1;
+    }
+    solve(W, s);
+
+    // Capacitance matrix, C = I + D*E'*W
+    FEMatrix *C = new FEMatrix(s, s);
+    double sum;
+    for (i = 0; i < s; i++) {
+        for (j = 0; j < s; j++) {
+            sum = (i == j) ? 1 : 0;
+            for (k = 0; k < s; k++) {
+                sum += values[i * s + k] * W[rows[k] * s + j];
+            }
+            C->set(i, j, sum);
+        }
+    }
+    FEMatrixFactorization *capacitance = new FEMatrixFactorization();
+    try {
+        capacitance->lu(C);
+    } catch (const std::logic_error &e) {
+        delete C;
+        delete capacitance;
+        delete[] W;
+        throw std::logic_error("[LOW-RANK-UPDATE] Updated matrix is singular");
+    }
+    delete C;
+
+    // Store update
+    this->n = n;
+    this->index = rows;
+    this->delta = new double[s * s];
+    std::copy(values, values + s * s, this->delta);
+    this->W = W;
+    this->capacitance = capacitance;
+}
+
+/**
+ * Correct solutions of the original system, x = x0 - W*inv(C)*D*E'*x0.
+ *
+ * @param x Array of n*nrhs values row major, stores the original solution and returns the updated one
+ * @param nrhs Number of right hand sides
+ */
+void LowRankUpdate::solve(double *x, int nrhs) const {
+    int s = this->get_rank();
+    if (s == 0) {
+        return;
+    }
+    int i, k, r;
+
+    // y = inv(C)*D*E'*x0
+    std::vector<double> y(static_cast<unsigned long>(s * nrhs), 0);
+    const double *xk;
+    for (i = 0; i < s; i++) {
+        for (k = 0; k < s; k++) {
+            xk = x + this->index[k] * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                y[i * nrhs + r] += this->delta[i * s + k] * xk[r];
+            }
+        }
+    }
+    this->capacitance->solve(y.data(), nrhs);
+
+    // x = x0 - W*y
+    const double *wi;
+    double *xi;
+    for (i = 0; i < this->n; i++) {
+        wi = this->W + i * s;
+        xi = x + i * nrhs;
+        for (k = 0; k < s; k++) {
+            if (wi[k] == 0) continue;
+            for (r = 0; r < nrhs; r++) {
+                xi[r] -= wi[k] * y[k * nrhs + r];
+            }
+        }
+    }
+}
+
+/**
+ * Discard update, solutions of the original system are not corrected.
+ */
+void LowRankUpdate::clear() {
+    this->destroy();
+}
+
+/**
+ * Update has been computed.
+ *
+ * @return
+ */
+bool LowRankUpdate::is_active() const {
+    return this->capacitance != nullptr;
+}
+
+/**
+ * Return number of updated rows, the rank of the update is lower or equal.
+ *
+ * @return
+ */
+int LowRankUpdate::get_rank() const {
+    return static_cast<int>(this->index.size());
+}
+
+/**
+ * Return logarithm of the absolute determinant of the capacitance matrix. The determinant
+ * of the updated matrix is det(A)*det(C).
+ *
+ * @param sign Sign of the determinant, -1 or 1
+ * @return
+ */
+double LowRankUpdate::log_det(int *sign) const {
+    if (!this->is_active()) {
+        *sign = 1;
+        return 0;
+    }
+    return this->capacitance->log_det(sign);
+}
\ No newline at end of file
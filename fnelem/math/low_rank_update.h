@@ -0,0 +1,110 @@
+/**
+FNELEM-GPU LOW-RANK UPDATE
+Sherman-Morrison-Woodbury update of a factorized matrix.
+
+@package fnelem.math
+@author ppizarror
+@date 04/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_LOW_RANK_UPDATE_H
+#define __FNELEM_MATH_LOW_RANK_UPDATE_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_factorization.h"
+
+// Library imports
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Solves A*X = B in place using an existing factorization, B has nrhs columns stored row major.
+ */
+typedef std::function<void(double *x, int nrhs)> LowRankSolve;
+
+/**
+ * Sherman-Morrison-Woodbury update of a factorized matrix. The updated matrix is
+ * A + E*D*E', where E selects the s updated rows (columns of the identity) and D is the
+ * dense s*s change of the matrix values within those rows. The solution of the updated
+ * system is obtained from the solution x0 of the original one:
+ *
+ *      x = x0 - W * inv(I + D*E'*W) * D*E'*x0, W = inv(A)*E
+ *
+ * W requires s solves with the original factorization, then each right hand side only
+ * costs O(n*s) operations, the original factorization is not modified.
+ */
+class LowRankUpdate {
+private:
+
+    // Dimension of the matrix
+    int n = 0;
+
+    // Updated rows
+    std::vector<int> index;
+
+    // Change of the values within the updated rows, s*s row major
+    double *delta = nullptr;
+
+    // Solution of the original system for each updated row, n*s row major
+    double *W = nullptr;
+
+    // Capacitance matrix factorization, I + D*E'*W
+    FEMatrixFactorization *capacitance = nullptr;
+
+    // Delete update data
+    void destroy();
+
+public:
+
+    // Constructor
+    LowRankUpdate();
+
+    // Destructor
+    ~LowRankUpdate();
+
+    // Computes update of the factorized matrix, values store the change within the updated rows
+    void update(int n, const std::vector<int> &rows, const double *values, const LowRankSolve &solve);
+
+    // Correct solutions of the original system in place, x has nrhs columns stored row major
+    void solve(double *x, int nrhs) const;
+
+    // Discard update
+    void clear();
+
+    // Update has been computed
+    bool is_active() const;
+
+    // Return number of updated rows
+    int get_rank() const;
+
+    // Return logarithm of the absolute determinant of the capacitance matrix, sign stores -1 or 1
+    double log_det(int *sign) const;
+
+};
+
+#endif // __FNELEM_MATH_LOW_RANK_UPDATE_H
\ No newline at end of file
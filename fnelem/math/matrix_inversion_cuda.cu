@@ -34,83 +34,42 @@ Based on: https://github.com/ZhengzhongSun/Matrix-Inversion-with-CUDA
 #include <stdio.h>
 #include <iostream>
 
+// Include headers
+#include "gauss_jordan_kernels.h"
+
 // Constants
 #define __MATRIX_INVERSION_CUDA_BLOCKSIZE 8
 
 /**
- * NODIAG normalize diagonal matrix (CUDA).
- *
- * @param A Matrix
- * @param I Matrix
- * @param n Dimension
- * @param i Position
- */
-__global__ void nodiag_normalize(double *A, double *I, int n, int i) {
-    int x = blockIdx.x * blockDim.x + threadIdx.x;
-    int y = blockIdx.y * blockDim.y + threadIdx.y;
-    if (x < n && y < n)
-        if (x == i && x != y) {
-            I[x * n + y] /= A[i * n + i];
-            A[x * n + y] /= A[i * n + i];
-        }
-}
-
-/**
- * DIAG normalize diagonal matrix (CUDA).
- *
- * @param A Matrix
- * @param I Matrix
- * @param n Dimension
- * @param i Position
- */
-__global__ void diag_normalize(double *A, double *I, int n, int i) {
-    int x = blockIdx.x * blockDim.x + threadIdx.x;
-    int y = blockIdx.y * blockDim.y + threadIdx.y;
-    if (x < n && y < n)
-        if (x == y && x == i) {
-            I[x * n + y] /= A[i * n + i];
-            A[x * n + y] /= A[i * n + i];
-        }
-}
-
-/**
- * Performs Gauss Jordan algorithm (CUDA).
+ * Stores pivot data of step i (CUDA).
  *
  * @param A Matrix
  * @param I Matrix
+ * @param P Pivot data
  * @param n Dimension
  * @param i Position
  */
-__global__ void gaussjordan(double *A, double *I, int n, int i) {
+__global__ void gauss_jordan_pivot_kernel(double *A, double *I, double *P, int n, int i) {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
-    int y = blockIdx.y * blockDim.y + threadIdx.y;
-    if (x < n && y < n) {
-        if (x != i) {
-            I[x * n + y] -= I[i * n + y] * A[x * n + i];
-            if (y != i) {
-                A[x * n + y] -= A[i * n + y] * A[x * n + i];
-            }
-        }
+    if (x < n) {
+        gauss_jordan_pivot(A, I, P, n, i, x);
     }
 }
 
 /**
- * Set zero on matrix (CUDA).
+ * Performs Gauss Jordan step i, normalizes pivot row and eliminates the other rows (CUDA).
  *
  * @param A Matrix
  * @param I Matrix
+ * @param P Pivot data
  * @param n Dimension
  * @param i Position
  */
-__global__ void set_zero(double *A, int n, int i) {
+__global__ void gauss_jordan_update_kernel(double *A, double *I, double *P, int n, int i) {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
     int y = blockIdx.y * blockDim.y + threadIdx.y;
     if (x < n && y < n) {
-        if (x != i) {
-            if (y == i) {
-                A[x * n + y] = 0;
-            }
-        }
+        gauss_jordan_update(A, I, P, n, i, x, y);
     }
 }
 
@@ -138,7 +97,7 @@ FEMatrix *matrix_inverse_cuda(FEMatrix *feMatrix) {
     double *iMatrix = new double[n * n];
 
     // Create auxiliar matrices
-    double *d_A, *I, *dI;
+    double *d_A, *I, *dI, *dP;
 
     // Time of computation
     float time;
@@ -166,6 +125,10 @@ FEMatrix *matrix_inverse_cuda(FEMatrix *feMatrix) {
     if (err != cudaSuccess) {
         std::cout << cudaGetErrorString(err) << " in " << __FILE__ << " at line " << __LINE__ << std::endl;
     }
+    err = cudaMalloc((void **) &dP, 3 * n * sizeof(double));
+    if (err != cudaSuccess) {
+        std::cout << cudaGetErrorString(err) << " in " << __FILE__ << " at line " << __LINE__ << std::endl;
+    }
 
     // Creates identify matrix
     I = new double[n * n];
@@ -189,12 +152,11 @@ FEMatrix *matrix_inverse_cuda(FEMatrix *feMatrix) {
     // Timer start
     cudaEventRecord(start, 0);
 
-    // L^(-1)
+    // L^(-1), pivot data is stored and then all values are updated in one pass
+    int pivotBlocks = (n + __MATRIX_INVERSION_CUDA_BLOCKSIZE - 1) / __MATRIX_INVERSION_CUDA_BLOCKSIZE;
     for (int i = 0; i < n; i++) {
-        nodiag_normalize << < numBlocks, threadsPerBlock >> > (d_A, dI, n, i);
-        diag_normalize << < numBlocks, threadsPerBlock >> > (d_A, dI, n, i);
-        gaussjordan << < numBlocks, threadsPerBlock >> > (d_A, dI, n, i);
-        set_zero << < numBlocks, threadsPerBlock >> > (d_A, n, i);
+        gauss_jordan_pivot_kernel << < pivotBlocks, __MATRIX_INVERSION_CUDA_BLOCKSIZE >> > (d_A, dI, dP, n, i);
+        gauss_jordan_update_kernel << < numBlocks, threadsPerBlock >> > (d_A, dI, dP, n, i);
     }
 
     // Record cuda events
@@ -218,6 +180,7 @@ FEMatrix *matrix_inverse_cuda(FEMatrix *feMatrix) {
     // Free memory
     cudaFree(d_A);
     cudaFree(dI);
+    cudaFree(dP);
     delete[] I;
 
     // Generate matrix
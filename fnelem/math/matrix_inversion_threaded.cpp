@@ -0,0 +1,102 @@
+/**
+FNELEM-GPU THREADED MATRIX INVERSION
+Performs matrix inversion using Gauss Jordan algorithm by host threads.
+
+@package fnelem.math
+@author ppizarror
+@date 02/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include headers
+#include "matrix_inversion_threaded.h"
+
+/**
+ * Performs Gauss-Jordan algorithm by host threads. For each pivot the pivot data is
+ * gathered and then all rows are updated in parallel, rows whose elimination factor is
+ * zero are not modified. Pivoting is not used, as in CUDA inversion.
+ *
+ * @param A Matrix to inverse, row major
+ * @param I Identity matrix, row major
+ * @param n Dimension
+ * @param pool Thread pool, if null the algorithm is serial
+ */
+void gauss_jordan_host(double *A, double *I, int n, ThreadPool *pool) {
+    std::vector<double> pivot_data(static_cast<unsigned long>(3 * n));
+    double *P = pivot_data.data();
+    std::function<void(int, int)> update;
+    for (int i = 0; i < n; i++) {
+
+        // Check pivot
+        double pivot = A[i * n + i];
+        if (pivot == 0 || !std::isfinite(pivot)) {
+            throw std::logic_error("[MATRIX-INVERSION] Matrix is singular, zero pivot at row " + std::to_string(i));
+        }
+
+        // Gather pivot data
+        for (int x = 0; x < n; x++) {
+            gauss_jordan_pivot(A, I, P, n, i, x);
+        }
+
+        // Fused update of all rows
+        update = [A, I, P, n, i](int begin, int end) {
+            for (int x = begin; x < end; x++) {
+                if (x != i && P[2 * n + x] == 0) continue;
+                for (int y = 0; y < n; y++) {
+                    gauss_jordan_update(A, I, P, n, i, x, y);
+                }
+            }
+        };
+        if (pool == nullptr) {
+            update(0, n);
+        } else {
+            pool->parallel_for(n, update);
+        }
+
+    }
+}
+
+/**
+ * Matrix inversion, uses host threads.
+ *
+ * @param matrix Matrix to inverse
+ * @param pool Thread pool, if null the inversion is serial
+ * @return Inverse matrix
+ */
+FEMatrix *matrix_inverse_threaded(FEMatrix *matrix, ThreadPool *pool) {
+    if (!matrix->is_square()) {
+        throw std::logic_error("[MATRIX-INVERSION] Matrix to inverse is not square");
+    }
+    int n = matrix->get_square_dimension();
+
+    // Creates identity matrix
+    std::vector<double> A(matrix->get_data(), matrix->get_data() + n * n);
+    std::vector<double> I(static_cast<unsigned long>(n * n), 0);
+    for (int i = 0; i < n; i++) {
+        I[i * n + i] = 1;
+    }
+
+    // Inverse
+    gauss_jordan_host(A.data(), I.data(), n, pool);
+    return new FEMatrix(n, n, I.data());
+}
\ No newline at end of file
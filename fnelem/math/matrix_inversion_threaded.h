@@ -1,10 +1,10 @@
 /**
-FNELEM-GPU - TEST MATH
-Force cuda as CPU inversion.
+FNELEM-GPU THREADED MATRIX INVERSION
+Performs matrix inversion using Gauss Jordan algorithm by host threads.
 
-@package test.math
+@package fnelem.math
 @author ppizarror
-@date 22/12/2018
+@date 02/01/2019
 @license
 	MIT License
 	Copyright (c) 2018 Pablo Pizarro R.
@@ -28,15 +28,39 @@ Force cuda as CPU inversion.
 	SOFTWARE.
 */
 
-#include "../../fnelem/math/matrix_inversion_cpu.h"
+// Init header file
+#ifndef __FNELEM_MATH_MATRIX_INVERSION_THREADED_H
+#define __FNELEM_MATH_MATRIX_INVERSION_THREADED_H
+
+// Include headers
+#include "fematrix.h"
+#include "gauss_jordan_kernels.h"
+#include "thread_pool.h"
+
+// Library imports
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 /**
- * Performs CPU matrix inversion using Gauss-Jordan elimination algorithm with CUDA, when run
- * by CPU forces CPU function. This is intented to used by CPU tests suite.
+ * Performs Gauss-Jordan algorithm by host threads, it uses the same kernels as CUDA
+ * inversion. A is replaced by the identity and I by the inverse.
+ *
+ * @param A Matrix to inverse, row major
+ * @param I Identity matrix, row major
+ * @param n Dimension
+ * @param pool Thread pool, if null the algorithm is serial
+ */
+void gauss_jordan_host(double *A, double *I, int n, ThreadPool *pool);
+
+/**
+ * Matrix inversion, uses host threads.
  *
  * @param matrix Matrix to inverse
+ * @param pool Thread pool, if null the inversion is serial
  * @return Inverse matrix
  */
-FEMatrix *matrix_inverse_cuda(FEMatrix *feMatrix) {
-    return matrix_inverse_cpu(feMatrix);
-}
\ No newline at end of file
+FEMatrix *matrix_inverse_threaded(FEMatrix *matrix, ThreadPool *pool);
+
+#endif // __FNELEM_MATH_MATRIX_INVERSION_THREADED_H
\ No newline at end of file
@@ -0,0 +1,214 @@
+/**
+FNELEM-GPU MATRIX ORDERING
+Graph orderings used to reduce bandwidth, profile and fill-in of sparse matrices.
+
+@package fnelem.math
+@author ppizarror
+@date 28/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "matrix_ordering.h"
+
+/**
+ * Creates a clean adjacency list, removes self loops and repeated vertices.
+ *
+ * @param graph Adjacency list
+ * @return
+ */
+std::vector<std::vector<int>> ordering_clean_graph(std::vector<std::vector<int>> *graph) {
+    int n = static_cast<int>(graph->size());
+    std::vector<std::vector<int>> adj(static_cast<unsigned long>(n));
+    for (int v = 0; v < n; v++) {
+        for (int w : graph->at(static_cast<unsigned long>(v))) {
+            if (w < 0 || w >= n) {
+                throw std::logic_error("[ORDERING] Graph vertex overflow");
+            }
+            if (w != v) adj[v].push_back(w);
+        }
+        std::sort(adj[v].begin(), adj[v].end());
+        adj[v].erase(std::unique(adj[v].begin(), adj[v].end()), adj[v].end());
+    }
+    return adj;
+}
+
+/**
+ * Computes level structure from a root vertex, only non ordered vertices are visited.
+ *
+ * @param adj Adjacency list
+ * @param root Root vertex
+ * @param ordered Vertex has been ordered
+ * @param level Level of each vertex, must be -1 for non visited vertices, restored at the end
+ * @param last Returns vertices of the last level
+ * @return Number of levels (eccentricity + 1)
+ */
+int ordering_level_structure(std::vector<std::vector<int>> &adj, int root, std::vector<bool> &ordered,
+                             std::vector<int> &level, std::vector<int> &last) {
+    std::vector<int> visited;
+    visited.push_back(root);
+    level[root] = 0;
+    int nlevels = 1;
+    for (unsigned long k = 0; k < visited.size(); k++) {
+        int v = visited[k];
+        for (int w : adj[v]) {
+            if (!ordered[w] && level[w] == -1) {
+                level[w] = level[v] + 1;
+                nlevels = std::max(nlevels, level[w] + 1);
+                visited.push_back(w);
+            }
+        }
+    }
+
+    // Store last level and restore levels
+    last.clear();
+    for (int v : visited) {
+        if (level[v] == nlevels - 1) last.push_back(v);
+        level[v] = -1;
+    }
+    return nlevels;
+}
+
+/**
+ * Reverse Cuthill-McKee ordering.
+ *
+ * @param graph Adjacency list of each vertex
+ * @return Permutation
+ */
+std::vector<int> *ordering_rcm(std::vector<std::vector<int>> *graph) {
+    std::vector<std::vector<int>> adj = ordering_clean_graph(graph);
+    int n = static_cast<int>(adj.size());
+    std::vector<int> *perm = new std::vector<int>();
+    perm->reserve(static_cast<unsigned long>(n));
+    std::vector<bool> ordered(static_cast<unsigned long>(n), false);
+    std::vector<int> level(static_cast<unsigned long>(n), -1);
+    std::vector<int> last;
+
+    // Compares vertices by degree
+    auto by_degree = [&adj](int a, int b) {
+        if (adj[a].size() != adj[b].size()) return adj[a].size() < adj[b].size();
+        return a < b;
+    };
+
+    for (int s = 0; s < n; s++) {
+        if (ordered[s]) continue;
+
+        // Find pseudo-peripheral vertex of the component (George-Liu)
+        int root = s;
+        int nlevels = ordering_level_structure(adj, root, ordered, level, last);
+        while (true) {
+            int candidate = *std::min_element(last.begin(), last.end(), by_degree);
+            std::vector<int> candidate_last;
+            int candidate_levels = ordering_level_structure(adj, candidate, ordered, level, candidate_last);
+            if (candidate_levels <= nlevels) break;
+            root = candidate;
+            nlevels = candidate_levels;
+            last = candidate_last;
+        }
+
+        // Cuthill-McKee from root, neighbours are visited by increasing degree
+        unsigned long first = perm->size();
+        perm->push_back(root);
+        ordered[root] = true;
+        std::vector<int> nbrs;
+        for (unsigned long k = first; k < perm->size(); k++) {
+            nbrs.clear();
+            for (int w : adj[perm->at(k)]) {
+                if (!ordered[w]) {
+                    nbrs.push_back(w);
+                    ordered[w] = true;
+                }
+            }
+            std::sort(nbrs.begin(), nbrs.end(), by_degree);
+            perm->insert(perm->end(), nbrs.begin(), nbrs.end());
+        }
+    }
+
+    // Reverse order
+    std::reverse(perm->begin(), perm->end());
+    return perm;
+}
+
+/**
+ * Minimum degree ordering, eliminates the vertex with the lowest degree and connects
+ * all their neighbours.
+ *
+ * @param graph Adjacency list of each vertex
+ * @return Permutation
+ */
+std::vector<int> *ordering_minimum_degree(std::vector<std::vector<int>> *graph) {
+    std::vector<std::vector<int>> clean = ordering_clean_graph(graph);
+    int n = static_cast<int>(clean.size());
+    std::vector<int> *perm = new std::vector<int>();
+    perm->reserve(static_cast<unsigned long>(n));
+
+    // Elimination graph and degree queue
+    std::vector<std::set<int>> adj(static_cast<unsigned long>(n));
+    std::set<std::pair<int, int>> queue;
+    for (int v = 0; v < n; v++) {
+        adj[v].insert(clean[v].begin(), clean[v].end());
+        queue.insert(std::make_pair(static_cast<int>(adj[v].size()), v));
+    }
+
+    std::vector<int> nbrs;
+    while (!queue.empty()) {
+        int v = queue.begin()->second;
+        queue.erase(queue.begin());
+        perm->push_back(v);
+
+        // Remove vertex from neighbours, then connect them as a clique
+        nbrs.assign(adj[v].begin(), adj[v].end());
+        for (int u : nbrs) {
+            queue.erase(std::make_pair(static_cast<int>(adj[u].size()), u));
+            adj[u].erase(v);
+        }
+        for (int u : nbrs) {
+            for (int w : nbrs) {
+                if (w != u) adj[u].insert(w);
+            }
+        }
+        for (int u : nbrs) {
+            queue.insert(std::make_pair(static_cast<int>(adj[u].size()), u));
+        }
+        adj[v].clear();
+    }
+
+    return perm;
+}
+
+/**
+ * Check permutation is valid.
+ *
+ * @param perm Permutation
+ * @param n Number of vertices
+ * @return
+ */
+bool ordering_is_permutation(std::vector<int> *perm, int n) {
+    if (perm->size() != static_cast<unsigned long>(n)) return false;
+    std::vector<bool> found(static_cast<unsigned long>(n), false);
+    for (int v : *perm) {
+        if (v < 0 || v >= n || found[v]) return false;
+        found[v] = true;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+/**
+FNELEM-GPU MATRIX ORDERING
+Graph orderings used to reduce bandwidth, profile and fill-in of sparse matrices.
+
+@package fnelem.math
+@author ppizarror
+@date 28/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_MATRIX_ORDERING_H
+#define __FNELEM_MATH_MATRIX_ORDERING_H
+
+// Library imports
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Reverse Cuthill-McKee ordering of a symmetric graph, reduces bandwidth and profile.
+ * Each connected component starts from a pseudo-peripheral vertex.
+ *
+ * @param graph Adjacency list of each vertex, self loops are ignored
+ * @return Permutation, perm[k] is the vertex located at new position k
+ */
+std::vector<int> *ordering_rcm(std::vector<std::vector<int>> *graph);
+
+/**
+ * Minimum degree ordering of a symmetric graph, reduces fill-in of sparse factorization.
+ * Eliminated vertices connect all their neighbours (elimination graph).
+ *
+ * @param graph Adjacency list of each vertex, self loops are ignored
+ * @return Permutation, perm[k] is the vertex located at new position k
+ */
+std::vector<int> *ordering_minimum_degree(std::vector<std::vector<int>> *graph);
+
+/**
+ * Check permutation is valid, each vertex must appear once.
+ *
+ * @param perm Permutation
+ * @param n Number of vertices
+ * @return
+ */
+bool ordering_is_permutation(std::vector<int> *perm, int n);
+
+#endif // __FNELEM_MATH_MATRIX_ORDERING_H
\ No newline at end of file
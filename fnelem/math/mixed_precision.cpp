@@ -0,0 +1,260 @@
+/**
+FNELEM-GPU MIXED PRECISION SOLVER
+Single precision factorization with double precision iterative refinement.
+
+@package fnelem.math
+@author ppizarror
+@date 01/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "mixed_precision.h"
+
+/**
+ * Constructor.
+ */
+MixedPrecisionSolver::MixedPrecisionSolver() {
+    this->single = new SparseLDL();
+    this->single->set_single_precision(true);
+}
+
+/**
+ * Destructor.
+ */
+MixedPrecisionSolver::~MixedPrecisionSolver() {
+    delete this->single;
+    delete this->full;
+}
+
+/**
+ * Set relative residual tolerance.
+ *
+ * @param tol Tolerance, ||b - A*x|| / ||b||
+ */
+void MixedPrecisionSolver::set_tolerance(double tol) {
+    if (tol <= 0) {
+        throw std::logic_error("[MIXED-PRECISION] Tolerance must be greater than zero");
+    }
+    this->tolerance = tol;
+}
+
+/**
+ * Set max number of refinement steps.
+ *
+ * @param steps Number of steps, zero uses the single precision solution
+ */
+void MixedPrecisionSolver::set_max_steps(int steps) {
+    if (steps < 0) {
+        throw std::logic_error("[MIXED-PRECISION] Number of steps cannot be negative");
+    }
+    this->max_steps = steps;
+}
+
+/**
+ * Factorize matrix in single precision, falls back to double precision if a pivot is
+ * too small for single precision.
+ *
+ * @param K Symmetric positive definite matrix
+ */
+void MixedPrecisionSolver::factorize(const FEMatrixSparse *K) {
+    this->A = K;
+    this->fallback = false;
+    delete this->full;
+    this->full = nullptr;
+    try {
+        this->single->factorize(K);
+    } catch (const std::logic_error &e) {
+        std::cout << "[MIXED-PRECISION] Single precision factorization failed, using double precision" << std::endl;
+        this->factorize_double();
+    }
+}
+
+/**
+ * Factorize matrix in double precision.
+ */
+void MixedPrecisionSolver::factorize_double() {
+    delete this->full;
+    this->full = new SparseLDL();
+    this->full->factorize(this->A);
+    this->fallback = true;
+}
+
+/**
+ * Computes residual r = b - A*x of each column.
+ *
+ * @param b Right hand side, row major (n x nrhs)
+ * @param x Solution, row major (n x nrhs)
+ * @param r Stores residual, row major (n x nrhs)
+ * @param nrhs Number of right hand sides
+ * @return Max relative residual of the columns
+ */
+double MixedPrecisionSolver::compute_residual(const double *b, const double *x, double *r, int nrhs) const {
+    int n = this->A->get_square_dimension();
+    std::vector<double> xc(static_cast<unsigned long>(n)), yc(static_cast<unsigned long>(n));
+    double res = 0, rnorm, bnorm;
+    for (int j = 0; j < nrhs; j++) {
+        for (int i = 0; i < n; i++) {
+            xc[i] = x[i * nrhs + j];
+        }
+        this->A->multiply(xc.data(), yc.data());
+        rnorm = 0;
+        bnorm = 0;
+        for (int i = 0; i < n; i++) {
+            r[i * nrhs + j] = b[i * nrhs + j] - yc[i];
+            rnorm += r[i * nrhs + j] * r[i * nrhs + j];
+            bnorm += b[i * nrhs + j] * b[i * nrhs + j];
+        }
+        if (bnorm == 0) bnorm = 1;
+        res = std::max(res, sqrt(rnorm / bnorm));
+    }
+    return res;
+}
+
+/**
+ * Solve A*X = B in place. Each refinement step solves the correction of all columns, it
+ * stops if the residual reaches the tolerance; if it does not converge or the residual
+ * stagnates, the matrix is factorized in double precision and the system is solved again.
+ *
+ * @param b Right hand side, stores the solution. Row major (n x nrhs)
+ * @param nrhs Number of right hand sides
+ */
+void MixedPrecisionSolver::solve(double *b, int nrhs) {
+    if (this->A == nullptr) {
+        throw std::logic_error("[MIXED-PRECISION] Matrix has not been factorized");
+    }
+    this->steps = 0;
+    if (this->fallback) {
+        this->full->solve(b, nrhs);
+        this->residual = 0;
+        return;
+    }
+
+    // Single precision solution
+    int n = this->A->get_square_dimension();
+    std::vector<double> rhs(b, b + n * nrhs);
+    std::vector<double> r(static_cast<unsigned long>(n * nrhs));
+    this->single->solve(b, nrhs);
+    this->residual = this->compute_residual(rhs.data(), b, r.data(), nrhs);
+
+    // Refinement, x += inv(LDL')*r
+    double last;
+    while (this->residual > this->tolerance && this->steps < this->max_steps) {
+        this->single->solve(r.data(), nrhs);
+        for (int i = 0; i < n * nrhs; i++) {
+            b[i] += r[i];
+        }
+        this->steps += 1;
+        last = this->residual;
+        this->residual = this->compute_residual(rhs.data(), b, r.data(), nrhs);
+        if (this->residual >= last) break; // Stagnation
+    }
+
+    // Fall back to double precision
+    if (this->residual > this->tolerance) {
+        std::cout << "[MIXED-PRECISION] Iterative refinement did not converge after " << this->steps
+                  << " steps, relative residual " << this->residual << ", using double precision" << std::endl;
+        this->factorize_double();
+        for (int i = 0; i < n * nrhs; i++) {
+            b[i] = rhs[i];
+        }
+        this->full->solve(b, nrhs);
+        this->residual = 0;
+    }
+}
+
+/**
+ * Solve system and return new matrix.
+ *
+ * @param b Right hand side vector, or matrix with one right hand side per column
+ * @return Solution
+ */
+FEMatrix *MixedPrecisionSolver::solve(const FEMatrix *b) {
+    if (this->A == nullptr) {
+        throw std::logic_error("[MIXED-PRECISION] Matrix has not been factorized");
+    }
+    int *dim = b->size();
+    if (dim[0] != this->A->get_square_dimension()) {
+        delete[] dim;
+        throw std::logic_error("[MIXED-PRECISION] Right hand side must have the matrix dimension");
+    }
+    double *x = b->get_array();
+    this->solve(x, dim[1]);
+    FEMatrix *sol = new FEMatrix(dim[0], dim[1], x);
+    delete[] dim;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Return refinement steps of the last solve.
+ *
+ * @return
+ */
+int MixedPrecisionSolver::get_refinement_steps() const {
+    return this->steps;
+}
+
+/**
+ * Return relative residual of the last solve, zero if double precision is used.
+ *
+ * @return
+ */
+double MixedPrecisionSolver::get_residual() const {
+    return this->residual;
+}
+
+/**
+ * Double precision factorization is used.
+ *
+ * @return
+ */
+bool MixedPrecisionSolver::is_fallback() const {
+    return this->fallback;
+}
+
+/**
+ * Return logarithm of the absolute determinant, uses the double precision factors if the
+ * solver fell back to them, else, the single precision ones.
+ *
+ * @param sign Sign of the determinant, -1 or 1
+ * @return
+ */
+double MixedPrecisionSolver::log_det(int *sign) const {
+    if (this->fallback) {
+        return this->full->log_det(sign);
+    }
+    return this->single->log_det(sign);
+}
+
+/**
+ * Return memory used by factor values in bytes.
+ *
+ * @return
+ */
+long MixedPrecisionSolver::get_factor_bytes() const {
+    if (this->fallback) {
+        return this->single->get_factor_bytes() + this->full->get_factor_bytes();
+    }
+    return this->single->get_factor_bytes();
+}
\ No newline at end of file
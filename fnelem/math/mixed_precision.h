@@ -0,0 +1,132 @@
+/**
+FNELEM-GPU MIXED PRECISION SOLVER
+Single precision factorization with double precision iterative refinement.
+
+@package fnelem.math
+@author ppizarror
+@date 01/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_MIXED_PRECISION_H
+#define __FNELEM_MATH_MIXED_PRECISION_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_sparse.h"
+#include "sparse_ldl.h"
+
+// Library imports
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Constant definition
+#define __MIXED_PRECISION_DEFAULT_TOLERANCE 1e-12
+#define __MIXED_PRECISION_DEFAULT_MAX_STEPS 10
+
+/**
+ * Mixed precision direct solver. The matrix is factorized in single precision (sparse
+ * LDL'), which halves the memory of the factors, and the solution is improved by
+ * iterative refinement: the residual r = b - A*x is computed in double precision and the
+ * correction is solved using the single precision factors. If the factorization fails or
+ * the refinement does not reach the tolerance, the matrix is factorized again in double
+ * precision.
+ */
+class MixedPrecisionSolver {
+private:
+
+    // Factorized matrix, not owned
+    const FEMatrixSparse *A = nullptr;
+
+    // Single precision factorization
+    SparseLDL *single = nullptr;
+
+    // Double precision factorization, used as fallback
+    SparseLDL *full = nullptr;
+
+    // Relative residual tolerance
+    double tolerance = __MIXED_PRECISION_DEFAULT_TOLERANCE;
+
+    // Max number of refinement steps
+    int max_steps = __MIXED_PRECISION_DEFAULT_MAX_STEPS;
+
+    // Refinement steps of the last solve
+    int steps = 0;
+
+    // Relative residual of the last solve
+    double residual = 0;
+
+    // Double precision factorization is used
+    bool fallback = false;
+
+    // Factorize matrix in double precision
+    void factorize_double();
+
+    // Return max relative residual of the columns, r = b - A*x
+    double compute_residual(const double *b, const double *x, double *r, int nrhs) const;
+
+public:
+
+    // Constructor
+    MixedPrecisionSolver();
+
+    // Destructor
+    ~MixedPrecisionSolver();
+
+    // Set relative residual tolerance
+    void set_tolerance(double tol);
+
+    // Set max number of refinement steps
+    void set_max_steps(int steps);
+
+    // Factorize matrix in single precision, matrix must exist while solving
+    void factorize(const FEMatrixSparse *K);
+
+    // Solve A*X = B in place, B has nrhs columns stored row major
+    void solve(double *b, int nrhs);
+
+    // Solve system and return new matrix, B can be a vector or a matrix
+    FEMatrix *solve(const FEMatrix *b);
+
+    // Return refinement steps of the last solve
+    int get_refinement_steps() const;
+
+    // Return relative residual of the last solve
+    double get_residual() const;
+
+    // Double precision factorization is used
+    bool is_fallback() const;
+
+    // Return logarithm of the absolute determinant, sign stores -1 or 1
+    double log_det(int *sign) const;
+
+    // Return memory used by factor values in bytes
+    long get_factor_bytes() const;
+
+};
+
+#endif // __FNELEM_MATH_MIXED_PRECISION_H
\ No newline at end of file
@@ -0,0 +1,405 @@
+/**
+FNELEM-GPU MULTIGRID
+Multigrid hierarchy and V-cycle, shared by algebraic and geometric multigrid.
+
+@package fnelem.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "multigrid.h"
+
+/**
+ * Constructor.
+ */
+Multigrid::Multigrid() = default;
+
+/**
+ * Destructor.
+ */
+Multigrid::~Multigrid() {
+    this->destroy();
+}
+
+/**
+ * Delete hierarchy.
+ */
+void Multigrid::destroy() {
+    for (auto &M : this->A) {
+        delete M;
+    }
+    for (auto &M : this->P) {
+        delete M;
+    }
+    this->A.clear();
+    this->P.clear();
+    delete this->coarse;
+    this->coarse = nullptr;
+    this->work_r.clear();
+    this->work_z.clear();
+    this->work_res.clear();
+}
+
+/**
+ * Set max number of levels.
+ *
+ * @param levels Number of levels, one uses the direct solver
+ */
+void Multigrid::set_max_levels(int levels) {
+    if (levels < 1) {
+        throw std::logic_error("[MULTIGRID] Number of levels must be greater than zero");
+    }
+    this->max_levels = levels;
+}
+
+/**
+ * Set coarsest level dimension.
+ *
+ * @param size Coarsening stops if the level dimension is not greater than this value
+ */
+void Multigrid::set_coarse_size(int size) {
+    if (size < 1) {
+        throw std::logic_error("[MULTIGRID] Coarse size must be greater than zero");
+    }
+    this->coarse_size = size;
+}
+
+/**
+ * Set number of pre and post smoothing sweeps.
+ *
+ * @param steps Number of sweeps
+ */
+void Multigrid::set_smoothing_steps(int steps) {
+    if (steps < 1) {
+        throw std::logic_error("[MULTIGRID] Number of smoothing steps must be greater than zero");
+    }
+    this->smoothing_steps = steps;
+}
+
+/**
+ * Creates matrix storing both triangles, the smoother and products need each full row.
+ *
+ * @param M Matrix
+ * @return
+ */
+FEMatrixSparse *Multigrid::full(const FEMatrixSparse *M) const {
+    if (!M->is_symmetric()) {
+        return M->clone();
+    }
+    int n = M->get_square_dimension();
+    const int *row_ptr = M->get_row_ptr();
+    const int *col_index = M->get_col_index();
+    const double *values = M->get_values();
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(n));
+    int i, j, k;
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            j = col_index[k];
+            pattern[i].push_back(j);
+            pattern[j].push_back(i);
+        }
+    }
+    FEMatrixSparse *F = new FEMatrixSparse(n, n, &pattern, false);
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            j = col_index[k];
+            F->set(i, j, values[k]);
+            F->set(j, i, values[k]);
+        }
+    }
+    return F;
+}
+
+/**
+ * Creates sparse product M*N, both matrices must store their full rows.
+ *
+ * @param M Left matrix
+ * @param N Right matrix
+ * @return
+ */
+FEMatrixSparse *Multigrid::product(const FEMatrixSparse *M, const FEMatrixSparse *N) const {
+    int *mdim = M->size();
+    int *ndim = N->size();
+    int n = mdim[0], m = ndim[1];
+    delete[] mdim;
+    delete[] ndim;
+    const int *m_ptr = M->get_row_ptr(), *m_col = M->get_col_index();
+    const int *n_ptr = N->get_row_ptr(), *n_col = N->get_col_index();
+    const double *m_val = M->get_values(), *n_val = N->get_values();
+
+    // Row by row using a dense accumulator
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(n));
+    std::vector<std::vector<double>> rows(static_cast<unsigned long>(n));
+    std::vector<double> acc(static_cast<unsigned long>(m), 0);
+    std::vector<int> marker(static_cast<unsigned long>(m), -1);
+    int i, j, k, l, c;
+    for (i = 0; i < n; i++) {
+        for (k = m_ptr[i]; k < m_ptr[i + 1]; k++) {
+            j = m_col[k];
+            for (l = n_ptr[j]; l < n_ptr[j + 1]; l++) {
+                c = n_col[l];
+                if (marker[c] != i) {
+                    marker[c] = i;
+                    pattern[i].push_back(c);
+                }
+                acc[c] += m_val[k] * n_val[l];
+            }
+        }
+        for (int col : pattern[i]) {
+            rows[i].push_back(acc[col]);
+            acc[col] = 0;
+        }
+    }
+
+    // Create matrix
+    FEMatrixSparse *R = new FEMatrixSparse(n, m, &pattern, false);
+    for (i = 0; i < n; i++) {
+        for (unsigned long t = 0; t < pattern[i].size(); t++) {
+            R->set(i, pattern[i][t], rows[i][t]);
+        }
+    }
+    return R;
+}
+
+/**
+ * Creates sparse transpose.
+ *
+ * @param M Matrix storing full rows
+ * @return
+ */
+FEMatrixSparse *Multigrid::transpose(const FEMatrixSparse *M) const {
+    int *dim = M->size();
+    int n = dim[0], m = dim[1];
+    delete[] dim;
+    const int *row_ptr = M->get_row_ptr();
+    const int *col_index = M->get_col_index();
+    const double *values = M->get_values();
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(m));
+    int i, k;
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            pattern[col_index[k]].push_back(i);
+        }
+    }
+    FEMatrixSparse *T = new FEMatrixSparse(m, n, &pattern, false);
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            T->set(col_index[k], i, values[k]);
+        }
+    }
+    return T;
+}
+
+/**
+ * Adds coarse level, the coarse matrix is computed as P'*A*P (Galerkin).
+ *
+ * @param Pl Prolongator from the new level to the current coarsest level
+ */
+void Multigrid::add_level(FEMatrixSparse *Pl) {
+    FEMatrixSparse *AP = this->product(this->A.back(), Pl);
+    FEMatrixSparse *PT = this->transpose(Pl);
+    FEMatrixSparse *Ac = this->product(PT, AP);
+    delete AP;
+    delete PT;
+    this->P.push_back(Pl);
+    this->A.push_back(Ac);
+}
+
+/**
+ * Factorize coarsest matrix and create work vectors, falls back to LU if Cholesky fails.
+ */
+void Multigrid::factorize_coarse() {
+    FEMatrix *dense = this->A.back()->to_dense();
+    this->coarse = new FEMatrixFactorization();
+    try {
+        this->coarse->cholesky(dense);
+    } catch (const std::logic_error &e) {
+        this->coarse->lu(dense);
+    }
+    delete dense;
+    for (auto &M : this->A) {
+        unsigned long nl = static_cast<unsigned long>(M->get_square_dimension());
+        this->work_r.emplace_back(nl);
+        this->work_z.emplace_back(nl);
+        this->work_res.emplace_back(nl);
+    }
+}
+
+/**
+ * Gauss-Seidel sweep over M*z = r, z is updated in place.
+ *
+ * @param M Matrix storing full rows
+ * @param r Right hand side
+ * @param z Solution
+ * @param forward Sweep order
+ */
+void Multigrid::gauss_seidel(const FEMatrixSparse *M, const double *r, double *z, bool forward) const {
+    int n = M->get_square_dimension();
+    const int *row_ptr = M->get_row_ptr();
+    const int *col_index = M->get_col_index();
+    const double *values = M->get_values();
+    int i, j, k;
+    double sum, d;
+    for (int s = 0; s < n; s++) {
+        i = forward ? s : n - 1 - s;
+        sum = r[i];
+        d = 0;
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            j = col_index[k];
+            if (j == i) {
+                d = values[k];
+            } else {
+                sum -= values[k] * z[j];
+            }
+        }
+        z[i] = sum / d;
+    }
+}
+
+/**
+ * Applies V-cycle, forward Gauss-Seidel before the coarse correction and backward after
+ * it, so the cycle is symmetric.
+ *
+ * @param level Level
+ * @param r Right hand side
+ * @param z Solution
+ */
+void Multigrid::cycle(int level, const double *r, double *z) const {
+    const FEMatrixSparse *M = this->A[level];
+    int n = M->get_square_dimension();
+    int i, k;
+
+    // Coarsest level
+    if (level == static_cast<int>(this->A.size()) - 1) {
+        for (i = 0; i < n; i++) {
+            z[i] = r[i];
+        }
+        this->coarse->solve(z, 1);
+        return;
+    }
+
+    // Pre smoothing
+    for (i = 0; i < n; i++) {
+        z[i] = 0;
+    }
+    for (k = 0; k < this->smoothing_steps; k++) {
+        this->gauss_seidel(M, r, z, true);
+    }
+
+    // Restrict residual, rc = P'*(r - A*z)
+    double *res = this->work_res[level].data();
+    double *rc = this->work_r[level + 1].data();
+    double *zc = this->work_z[level + 1].data();
+    M->multiply(z, res);
+    for (i = 0; i < n; i++) {
+        res[i] = r[i] - res[i];
+    }
+    const FEMatrixSparse *Pl = this->P[level];
+    const int *row_ptr = Pl->get_row_ptr();
+    const int *col_index = Pl->get_col_index();
+    const double *values = Pl->get_values();
+    int nc = this->A[level + 1]->get_square_dimension();
+    for (i = 0; i < nc; i++) {
+        rc[i] = 0;
+    }
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            rc[col_index[k]] += values[k] * res[i];
+        }
+    }
+
+    // Coarse correction, z += P*zc
+    this->cycle(level + 1, rc, zc);
+    for (i = 0; i < n; i++) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            z[i] += values[k] * zc[col_index[k]];
+        }
+    }
+
+    // Post smoothing
+    for (k = 0; k < this->smoothing_steps; k++) {
+        this->gauss_seidel(M, r, z, false);
+    }
+}
+
+/**
+ * Applies preconditioner z = inv(M)*r.
+ *
+ * @param r Residual
+ * @param z Preconditioned residual
+ */
+void Multigrid::apply(const double *r, double *z) const {
+    if (!this->is_setup()) {
+        throw std::logic_error("[MULTIGRID] Hierarchy has not been built");
+    }
+    this->cycle(0, r, z);
+}
+
+/**
+ * Hierarchy has been built.
+ *
+ * @return
+ */
+bool Multigrid::is_setup() const {
+    return this->coarse != nullptr;
+}
+
+/**
+ * Return number of levels.
+ *
+ * @return
+ */
+int Multigrid::get_levels() const {
+    return static_cast<int>(this->A.size());
+}
+
+/**
+ * Return dimension of a level.
+ *
+ * @param level Level, zero is the finest
+ * @return
+ */
+int Multigrid::get_level_dimension(int level) const {
+    if (level < 0 || level >= this->get_levels()) {
+        throw std::logic_error("[MULTIGRID] Level position overflow");
+    }
+    return this->A[level]->get_square_dimension();
+}
+
+/**
+ * Return operator complexity, stored values of all levels over the finest one.
+ *
+ * @return
+ */
+double Multigrid::get_operator_complexity() const {
+    if (this->A.empty()) {
+        return 0;
+    }
+    double nnz = 0;
+    for (auto &M : this->A) {
+        nnz += M->get_nnz();
+    }
+    return nnz / this->A[0]->get_nnz();
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+FNELEM-GPU MULTIGRID
+Multigrid hierarchy and V-cycle, shared by algebraic and geometric multigrid.
+
+@package fnelem.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_MULTIGRID_H
+#define __FNELEM_MATH_MULTIGRID_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_factorization.h"
+#include "fematrix_sparse.h"
+
+// Library imports
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Constant definition
+#define __MULTIGRID_DEFAULT_MAX_LEVELS 10
+#define __MULTIGRID_DEFAULT_COARSE_SIZE 100
+#define __MULTIGRID_DEFAULT_SMOOTHING_STEPS 1
+
+/**
+ * Multigrid hierarchy and V-cycle. Each level stores its matrix and the prolongator from
+ * the next (coarser) level, coarse matrices are computed as P'*A*P and the coarsest one
+ * is factorized. The V-cycle uses forward Gauss-Seidel before the coarse correction and
+ * backward Gauss-Seidel after it, so it is symmetric and can precondition PCG. Derived
+ * classes define how the prolongators are built.
+ */
+class Multigrid {
+protected:
+
+    // Max number of levels
+    int max_levels = __MULTIGRID_DEFAULT_MAX_LEVELS;
+
+    // Dimension of the coarsest level, coarsening stops below this value
+    int coarse_size = __MULTIGRID_DEFAULT_COARSE_SIZE;
+
+    // Number of pre and post smoothing sweeps
+    int smoothing_steps = __MULTIGRID_DEFAULT_SMOOTHING_STEPS;
+
+    // Matrix of each level, full storage
+    std::vector<FEMatrixSparse *> A;
+
+    // Prolongator from level l+1 to level l
+    std::vector<FEMatrixSparse *> P;
+
+    // Factorization of the coarsest matrix
+    FEMatrixFactorization *coarse = nullptr;
+
+    // Right hand side, solution and residual of each level
+    mutable std::vector<std::vector<double>> work_r, work_z, work_res;
+
+    // Delete hierarchy
+    void destroy();
+
+    // Create matrix storing both triangles
+    FEMatrixSparse *full(const FEMatrixSparse *M) const;
+
+    // Creates sparse product M*N
+    FEMatrixSparse *product(const FEMatrixSparse *M, const FEMatrixSparse *N) const;
+
+    // Creates sparse transpose
+    FEMatrixSparse *transpose(const FEMatrixSparse *M) const;
+
+    // Adds coarse level from the prolongator
+    void add_level(FEMatrixSparse *Pl);
+
+    // Factorize coarsest level
+    void factorize_coarse();
+
+    // Gauss-Seidel sweep, forward or backward
+    void gauss_seidel(const FEMatrixSparse *M, const double *r, double *z, bool forward) const;
+
+    // Applies V-cycle starting at level
+    void cycle(int level, const double *r, double *z) const;
+
+public:
+
+    // Constructor
+    Multigrid();
+
+    // Destructor
+    virtual ~Multigrid();
+
+    // Set max number of levels
+    void set_max_levels(int levels);
+
+    // Set coarsest level dimension
+    void set_coarse_size(int size);
+
+    // Set number of smoothing sweeps
+    void set_smoothing_steps(int steps);
+
+    // Applies preconditioner z = inv(M)*r
+    void apply(const double *r, double *z) const;
+
+    // Hierarchy has been built
+    bool is_setup() const;
+
+    // Return number of levels
+    int get_levels() const;
+
+    // Return dimension of a level
+    int get_level_dimension(int level) const;
+
+    // Return operator complexity, stored values of all levels over the finest one
+    double get_operator_complexity() const;
+
+};
+
+#endif // __FNELEM_MATH_MULTIGRID_H
\ No newline at end of file
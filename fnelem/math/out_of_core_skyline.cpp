@@ -0,0 +1,505 @@
+/**
+FNELEM-GPU OUT-OF-CORE SKYLINE
+Skyline LDL' factorization stored in memory-mapped panels of a file.
+
+@package fnelem.math
+@author ppizarror
+@date 05/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "out_of_core_skyline.h"
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+/**
+ * Creates out of core skyline matrix from a sparse symmetric matrix. The envelope is
+ * defined by the first stored column of each row, rows are grouped into panels so that two
+ * panels fit within the memory budget (a panel has at least one row). Values are written
+ * to a new file within the directory, the file is deleted from the directory as soon as it
+ * is created, so it is removed when the matrix is destroyed or the process ends.
+ *
+ * @param matrix Sparse symmetric matrix
+ * @param memory Memory budget of the mapped panels in bytes
+ * @param directory Directory of the factor file, should be on a local disk. If empty the
+ *                  temporary directory of the platform is used
+ */
+OutOfCoreSkyline::OutOfCoreSkyline(const FEMatrixSparse *matrix, long memory, const std::string &directory) {
+    if (!matrix->is_symmetric()) {
+        throw std::logic_error("[OUT-OF-CORE] Sparse matrix must be symmetric");
+    }
+    if (memory <= 0) {
+        throw std::logic_error("[OUT-OF-CORE] Memory budget must be greater than zero");
+    }
+    this->n = matrix->get_square_dimension();
+    this->memory = memory;
+    this->page = sysconf(_SC_PAGESIZE);
+    const int *ap = matrix->get_row_ptr();
+    const int *ai = matrix->get_col_index();
+    const double *ax = matrix->get_values();
+    int i, p;
+
+    // Envelope, columns are sorted so the first stored column defines it
+    this->first = new int[this->n];
+    this->row_ptr = new long[this->n + 1];
+    this->row_ptr[0] = 0;
+    for (i = 0; i < this->n; i++) {
+        this->first[i] = (ap[i] < ap[i + 1]) ? ai[ap[i]] : i;
+        this->row_ptr[i + 1] = this->row_ptr[i] + i - this->first[i] + 1;
+    }
+    this->nvalues = this->row_ptr[this->n];
+    this->diagonal.assign(static_cast<unsigned long>(this->n), 0);
+
+    // Panels, two of them must fit within the budget
+    long panel_bytes = std::max(memory / 2 - 2 * this->page, 8L);
+    this->panel_row.push_back(0);
+    for (i = 1; i < this->n; i++) {
+        if (8 * (this->row_ptr[i + 1] - this->row_ptr[this->panel_row.back()]) > panel_bytes) {
+            this->panel_row.push_back(i);
+        }
+    }
+    this->panel_row.push_back(this->n);
+    int npanels = this->get_panels();
+    this->panel_base.assign(static_cast<unsigned long>(npanels), nullptr);
+    this->panel_length.assign(static_cast<unsigned long>(npanels), 0);
+    this->panel_values.assign(static_cast<unsigned long>(npanels), nullptr);
+
+    // Create factor file
+    std::string folder = directory.empty() ? OutOfCoreSkyline::get_default_directory() : directory;
+    std::string path = folder + "/fnelem-out-of-core-XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    this->fd = mkstemp(name.data());
+    if (this->fd < 0) {
+        delete[] this->first;
+        delete[] this->row_ptr;
+        throw std::logic_error("[OUT-OF-CORE] Cannot create factor file within " + folder);
+    }
+    unlink(name.data());
+    if (ftruncate(this->fd, static_cast<off_t>(8 * this->nvalues)) != 0) {
+        close(this->fd);
+        delete[] this->first;
+        delete[] this->row_ptr;
+        throw std::logic_error("[OUT-OF-CORE] Cannot allocate factor file of " + std::to_string(8 * this->nvalues) +
+                               " bytes within " + folder);
+    }
+
+    // Write values panel by panel, the file is created filled with zeros
+    double *row_i;
+    try {
+        for (p = 0; p < npanels; p++) {
+            this->map(p, true);
+            for (i = this->panel_row[p]; i < this->panel_row[p + 1]; i++) {
+                row_i = this->get_row(p, i);
+                for (int k = ap[i]; k < ap[i + 1]; k++) {
+                    row_i[ai[k]] = ax[k];
+                }
+            }
+            this->unmap(p);
+        }
+    } catch (const std::logic_error &e) { // Destructor is not called
+        for (p = 0; p < npanels; p++) {
+            this->unmap(p);
+        }
+        close(this->fd);
+        delete[] this->first;
+        delete[] this->row_ptr;
+        throw;
+    }
+}
+
+/**
+ * Destroy matrix, mapped panels are released and the factor file is closed.
+ */
+OutOfCoreSkyline::~OutOfCoreSkyline() {
+    for (int p = 0; p < this->get_panels(); p++) {
+        this->unmap(p);
+    }
+    if (this->fd >= 0) {
+        close(this->fd);
+    }
+    delete[] this->first;
+    delete[] this->row_ptr;
+}
+
+/**
+ * Map panel in memory, the mapping starts at the page that contains the first value.
+ *
+ * @param p Panel
+ * @param write Values are modified
+ */
+void OutOfCoreSkyline::map(int p, bool write) {
+    if (this->panel_base[p] != nullptr) {
+        return;
+    }
+    long offset = 8 * this->row_ptr[this->panel_row[p]];
+    long end = 8 * this->row_ptr[this->panel_row[p + 1]];
+    long aligned = offset - offset % this->page;
+    size_t length = static_cast<size_t>(end - aligned);
+    void *base = mmap(nullptr, length, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, this->fd,
+                      static_cast<off_t>(aligned));
+    if (base == MAP_FAILED) {
+        throw std::logic_error("[OUT-OF-CORE] Cannot map panel " + std::to_string(p));
+    }
+    this->panel_base[p] = base;
+    this->panel_length[p] = length;
+    this->panel_values[p] = reinterpret_cast<double *>(static_cast<char *>(base) + (offset - aligned));
+    this->mapped += static_cast<long>(length);
+    this->peak = std::max(this->peak, this->mapped);
+    this->loads += 1;
+}
+
+/**
+ * Unmap panel, modified values are written back to the file by the operating system.
+ *
+ * @param p Panel
+ */
+void OutOfCoreSkyline::unmap(int p) {
+    if (this->panel_base[p] == nullptr) {
+        return;
+    }
+    munmap(this->panel_base[p], this->panel_length[p]);
+    this->mapped -= static_cast<long>(this->panel_length[p]);
+    this->panel_base[p] = nullptr;
+    this->panel_length[p] = 0;
+    this->panel_values[p] = nullptr;
+}
+
+/**
+ * Request the panel values to the operating system, the file is read in the background
+ * while the current panel is used.
+ *
+ * @param p Panel, nothing is done if it does not exist
+ */
+void OutOfCoreSkyline::prefetch(int p) const {
+    if (p < 0 || p >= this->get_panels()) {
+        return;
+    }
+    long offset = 8 * this->row_ptr[this->panel_row[p]];
+    long end = 8 * this->row_ptr[this->panel_row[p + 1]];
+#ifdef POSIX_FADV_WILLNEED
+    posix_fadvise(this->fd, static_cast<off_t>(offset), static_cast<off_t>(end - offset), POSIX_FADV_WILLNEED);
+#endif
+}
+
+/**
+ * Return panel that contains a row.
+ *
+ * @param row Row
+ * @return
+ */
+int OutOfCoreSkyline::get_panel(int row) const {
+    return static_cast<int>(std::upper_bound(this->panel_row.begin(), this->panel_row.end(), row) -
+                            this->panel_row.begin()) - 1;
+}
+
+/**
+ * Return pointer to row values, the panel must be mapped.
+ *
+ * @param p Panel of the row
+ * @param i Row
+ * @return Pointer, row[j] is the value of column j for j within first(i) and i
+ */
+double *OutOfCoreSkyline::get_row(int p, int i) const {
+    return this->panel_values[p] + (this->row_ptr[i] - this->row_ptr[this->panel_row[p]]) - this->first[i];
+}
+
+/**
+ * Computes L*D*L' factorization panel by panel. Rows of panel p first subtract the
+ * contribution of each previous panel q within their envelope, g(i,j) = a(i,j) - sum
+ * g(i,k)*l(j,k) for the rows j of q, only p and q are mapped. Then the rows within p are
+ * completed as in FEMatrixSkyline, l(i,j) = g(i,j)/d(j) and d(i) = a(i,i) - sum g(i,j)*l(i,j).
+ */
+void OutOfCoreSkyline::factorize() {
+    if (this->factorized) {
+        throw std::logic_error("[OUT-OF-CORE] Matrix has already been factorized");
+    }
+    int i, j, k, kmin, a, b, fi, q;
+    double *row_i, *row_j, sum, dii, aii, lij;
+    for (int p = 0; p < this->get_panels(); p++) {
+        a = this->panel_row[p];
+        b = this->panel_row[p + 1];
+        this->map(p, true);
+
+        // Previous panels within the envelope of the panel
+        fi = a;
+        for (i = a; i < b; i++) {
+            fi = std::min(fi, this->first[i]);
+        }
+        for (q = this->get_panel(fi); q < p; q++) {
+            this->prefetch(q + 1);
+            this->map(q, false);
+            for (i = a; i < b; i++) {
+                row_i = this->get_row(p, i);
+                for (j = std::max(this->first[i], this->panel_row[q]); j < this->panel_row[q + 1]; j++) {
+                    row_j = this->get_row(q, j);
+                    kmin = std::max(this->first[i], this->first[j]);
+                    sum = 0;
+                    for (k = kmin; k < j; k++) {
+                        sum += row_i[k] * row_j[k];
+                    }
+                    row_i[j] -= sum;
+                }
+            }
+            this->unmap(q);
+        }
+        this->prefetch(p + 1);
+
+        // Rows within the panel
+        for (i = a; i < b; i++) {
+            row_i = this->get_row(p, i);
+            for (j = std::max(this->first[i], a); j < i; j++) {
+                row_j = this->get_row(p, j);
+                kmin = std::max(this->first[i], this->first[j]);
+                sum = 0;
+                for (k = kmin; k < j; k++) {
+                    sum += row_i[k] * row_j[k];
+                }
+                row_i[j] -= sum;
+            }
+
+            // Compute l(i,j) and d(i)
+            aii = row_i[i];
+            dii = aii;
+            for (j = this->first[i]; j < i; j++) {
+                lij = row_i[j] / this->diagonal[j];
+                dii -= lij * row_i[j];
+                row_i[j] = lij;
+            }
+            if (fabs(dii) <= __OUT_OF_CORE_SKYLINE_PIVOT_TOLERANCE * fabs(aii) || dii == 0) {
+                this->unmap(p);
+                throw std::logic_error("[OUT-OF-CORE] Matrix is singular, zero pivot at row " + std::to_string(i));
+            }
+            row_i[i] = dii;
+            this->diagonal[i] = dii;
+        }
+        this->unmap(p);
+    }
+    this->factorized = true;
+}
+
+/**
+ * Values have been factorized.
+ *
+ * @return
+ */
+bool OutOfCoreSkyline::is_factorized() const {
+    return this->factorized;
+}
+
+/**
+ * Solve L*D*L'*x = b in place.
+ *
+ * @param x Array of n values, stores b and returns the solution
+ */
+void OutOfCoreSkyline::solve(double *x) {
+    this->solve(x, 1);
+}
+
+/**
+ * Solve L*D*L'*X = B in place. The forward substitution streams the panels from the first
+ * to the last one, the backward substitution from the last to the first one.
+ *
+ * @param x Array of n*nrhs values row major, stores B and returns the solution
+ * @param nrhs Number of right hand sides
+ */
+void OutOfCoreSkyline::solve(double *x, int nrhs) {
+    if (!this->factorized) {
+        throw std::logic_error("[OUT-OF-CORE] Matrix has not been factorized");
+    }
+    int i, j, r, p;
+    const double *row_i;
+    double lij, *xi, *xj;
+    int npanels = this->get_panels();
+
+    // Solve L*Y = B, row by row
+    this->prefetch(0);
+    for (p = 0; p < npanels; p++) {
+        this->map(p, false);
+        this->prefetch(p + 1);
+        for (i = this->panel_row[p]; i < this->panel_row[p + 1]; i++) {
+            row_i = this->get_row(p, i);
+            xi = x + i * nrhs;
+            for (j = this->first[i]; j < i; j++) {
+                lij = row_i[j];
+                xj = x + j * nrhs;
+                for (r = 0; r < nrhs; r++) {
+                    xi[r] -= lij * xj[r];
+                }
+            }
+        }
+        if (p < npanels - 1) { // Last panel is used by the backward substitution
+            this->unmap(p);
+        }
+    }
+
+    // Solve D*Z = Y
+    for (i = 0; i < this->n; i++) {
+        xi = x + i * nrhs;
+        for (r = 0; r < nrhs; r++) {
+            xi[r] /= this->diagonal[i];
+        }
+    }
+
+    // Solve L'*X = Z, column by column
+    for (p = npanels - 1; p >= 0; p--) {
+        this->map(p, false);
+        this->prefetch(p - 1);
+        for (i = this->panel_row[p + 1] - 1; i >= this->panel_row[p]; i--) {
+            row_i = this->get_row(p, i);
+            xi = x + i * nrhs;
+            for (j = this->first[i]; j < i; j++) {
+                lij = row_i[j];
+                xj = x + j * nrhs;
+                for (r = 0; r < nrhs; r++) {
+                    xj[r] -= lij * xi[r];
+                }
+            }
+        }
+        this->unmap(p);
+    }
+}
+
+/**
+ * Solve system and return new matrix.
+ *
+ * @param b Right hand side vector, or matrix with one right hand side per column
+ * @return Solution
+ */
+FEMatrix *OutOfCoreSkyline::solve(const FEMatrix *b) {
+    int *dim = b->size();
+    if (dim[0] != this->n) {
+        delete[] dim;
+        throw std::logic_error("[OUT-OF-CORE] Right hand side must have the matrix dimension");
+    }
+    double *x = b->get_array();
+    this->solve(x, dim[1]);
+    FEMatrix *sol = new FEMatrix(dim[0], dim[1], x);
+    delete[] dim;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Return logarithm of the absolute determinant, D is kept in memory.
+ *
+ * @param sign Sign of the determinant, -1 or 1
+ * @return
+ */
+double OutOfCoreSkyline::log_det(int *sign) const {
+    if (!this->factorized) {
+        throw std::logic_error("[OUT-OF-CORE] Matrix has not been factorized");
+    }
+    double logdet = 0;
+    *sign = 1;
+    for (int i = 0; i < this->n; i++) {
+        logdet += log(fabs(this->diagonal[i]));
+        if (this->diagonal[i] < 0) *sign = -*sign;
+    }
+    return logdet;
+}
+
+/**
+ * Return dimension of the matrix.
+ *
+ * @return
+ */
+int OutOfCoreSkyline::get_dimension() const {
+    return this->n;
+}
+
+/**
+ * Return number of stored values, profile plus diagonal.
+ *
+ * @return
+ */
+long OutOfCoreSkyline::get_nvalues() const {
+    return this->nvalues;
+}
+
+/**
+ * Return number of panels.
+ *
+ * @return
+ */
+int OutOfCoreSkyline::get_panels() const {
+    return static_cast<int>(this->panel_row.size()) - 1;
+}
+
+/**
+ * Return memory budget of the mapped panels in bytes.
+ *
+ * @return
+ */
+long OutOfCoreSkyline::get_memory() const {
+    return this->memory;
+}
+
+/**
+ * Return size of the factor file in bytes.
+ *
+ * @return
+ */
+long OutOfCoreSkyline::get_file_bytes() const {
+    return 8 * this->nvalues;
+}
+
+/**
+ * Return max bytes mapped at the same time, it can exceed the budget only if a single row
+ * does not fit within half of it.
+ *
+ * @return
+ */
+long OutOfCoreSkyline::get_peak_memory() const {
+    return this->peak;
+}
+
+/**
+ * Return number of panels mapped since the matrix was created, measures the file traffic.
+ *
+ * @return
+ */
+long OutOfCoreSkyline::get_panel_loads() const {
+    return this->loads;
+}
+
+/**
+ * Return temporary directory of the platform, TMPDIR if it is defined, otherwise the
+ * default directory of the C library.
+ *
+ * @return
+ */
+std::string OutOfCoreSkyline::get_default_directory() {
+    const char *tmpdir = std::getenv("TMPDIR");
+    if (tmpdir != nullptr && tmpdir[0] != '\0') {
+        return tmpdir;
+    }
+#ifdef P_tmpdir
+    return P_tmpdir;
+#else
+    return "/tmp";
+#endif
+}
+
+#endif // FNELEM_OUT_OF_CORE_SKYLINE
\ No newline at end of file
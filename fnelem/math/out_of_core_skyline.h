@@ -0,0 +1,192 @@
+/**
+FNELEM-GPU OUT-OF-CORE SKYLINE
+Skyline LDL' factorization stored in memory-mapped panels of a file.
+
+@package fnelem.math
+@author ppizarror
+@date 05/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_OUT_OF_CORE_SKYLINE_H
+#define __FNELEM_MATH_OUT_OF_CORE_SKYLINE_H
+
+// Out of core factorization is only available if POSIX memory-mapped files are supported
+#if defined(__unix__) || defined(__APPLE__)
+#define FNELEM_OUT_OF_CORE_SKYLINE
+#endif
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_sparse.h"
+
+// Library imports
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+// Constant definition
+#define __OUT_OF_CORE_SKYLINE_DEFAULT_MEMORY 67108864   // Memory budget of the mapped panels, 64 MB
+#define __OUT_OF_CORE_SKYLINE_PIVOT_TOLERANCE 1e-14
+
+/**
+ * Skyline LDL' factorization stored out of core. The envelope of the matrix is written to
+ * a file (deleted when closed) and split into panels of consecutive rows, only two panels
+ * are mapped in memory at the same time, so the factor size is not limited by the memory.
+ * Each panel is factorized against the previous panels within their envelope one panel at
+ * a time (row oriented Crout, the same operations of FEMatrixSkyline), and the triangular
+ * solves stream the panels forward and backward. The next panel is prefetched while the
+ * current one is used. D is kept in memory.
+ */
+class OutOfCoreSkyline {
+private:
+
+    // Dimension of the matrix
+    int n = 0;
+
+    // Number of stored values, profile plus diagonal
+    long nvalues = 0;
+
+    // First column of each row [0..n-1]
+    int *first = nullptr;
+
+    // Position of the first stored value of each row [0..n]
+    long *row_ptr = nullptr;
+
+    // Diagonal of the factorization
+    std::vector<double> diagonal;
+
+    // First row of each panel, last value is the dimension
+    std::vector<int> panel_row;
+
+    // Mapped address of each panel, aligned to page size, nullptr if not mapped
+    std::vector<void *> panel_base;
+
+    // Mapped length of each panel in bytes
+    std::vector<size_t> panel_length;
+
+    // Values of each mapped panel, starts from the first value of the first row
+    std::vector<double *> panel_values;
+
+    // Memory budget of the mapped panels in bytes
+    long memory = __OUT_OF_CORE_SKYLINE_DEFAULT_MEMORY;
+
+    // Factor file descriptor
+    int fd = -1;
+
+    // Memory page size
+    long page = 0;
+
+    // Bytes currently mapped
+    long mapped = 0;
+
+    // Max bytes mapped at the same time
+    long peak = 0;
+
+    // Number of panels mapped
+    long loads = 0;
+
+    // Values have been factorized
+    bool factorized = false;
+
+    // Map panel in memory
+    void map(int p, bool write);
+
+    // Unmap panel
+    void unmap(int p);
+
+    // Request the panel to the operating system before it is used
+    void prefetch(int p) const;
+
+    // Return panel of a row
+    int get_panel(int row) const;
+
+    // Return pointer to row values within their mapped panel, row[j] is the value of column j
+    double *get_row(int p, int i) const;
+
+public:
+
+    // Constructor from a sparse symmetric matrix, values are written to the factor file
+    OutOfCoreSkyline(const FEMatrixSparse *matrix, long memory, const std::string &directory);
+
+    // Destructor, factor file is deleted
+    ~OutOfCoreSkyline();
+
+    // Computes L*D*L' factorization within the factor file
+    void factorize();
+
+    // Values have been factorized
+    bool is_factorized() const;
+
+    // Solve L*D*L'*x = b in place, x array stores b
+    void solve(double *x);
+
+    // Solve L*D*L'*X = B in place, B has nrhs columns stored row major
+    void solve(double *x, int nrhs);
+
+    // Solve system and return new matrix
+    FEMatrix *solve(const FEMatrix *b);
+
+    // Return logarithm of the absolute determinant, sign stores -1 or 1
+    double log_det(int *sign) const;
+
+    // Return dimension of the matrix
+    int get_dimension() const;
+
+    // Return number of stored values
+    long get_nvalues() const;
+
+    // Return number of panels
+    int get_panels() const;
+
+    // Return memory budget in bytes
+    long get_memory() const;
+
+    // Return size of the factor file in bytes
+    long get_file_bytes() const;
+
+    // Return max bytes mapped at the same time
+    long get_peak_memory() const;
+
+    // Return number of panels mapped since the matrix was created
+    long get_panel_loads() const;
+
+    // Return temporary directory of the platform, used if no directory is given
+    static std::string get_default_directory();
+
+};
+
+#endif // FNELEM_OUT_OF_CORE_SKYLINE
+
+#endif // __FNELEM_MATH_OUT_OF_CORE_SKYLINE_H
\ No newline at end of file
@@ -0,0 +1,302 @@
+/**
+FNELEM-GPU PRECONDITIONED CONJUGATE GRADIENT
+Iterative solver for symmetric positive definite sparse matrices.
+
+@package fnelem.math
+@author ppizarror
+@date 27/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "pcg.h"
+
+/**
+ * Constructor.
+ */
+PCGSolver::PCGSolver() = default;
+
+/**
+ * Destructor.
+ */
+PCGSolver::~PCGSolver() = default;
+
+/**
+ * Set relative residual tolerance.
+ *
+ * @param tol Tolerance
+ */
+void PCGSolver::set_tolerance(double tol) {
+    if (tol <= 0) {
+        throw std::logic_error("[PCG] Tolerance must be greater than zero");
+    }
+    this->tolerance = tol;
+}
+
+/**
+ * Set max number of iterations, if zero the dimension of the matrix is used.
+ *
+ * @param maxiter Max iterations
+ */
+void PCGSolver::set_max_iterations(int maxiter) {
+    if (maxiter < 0) {
+        throw std::logic_error("[PCG] Max iterations cannot be negative");
+    }
+    this->max_iterations = maxiter;
+}
+
+/**
+ * Get relative residual tolerance.
+ *
+ * @return
+ */
+double PCGSolver::get_tolerance() const {
+    return this->tolerance;
+}
+
+/**
+ * Get max number of iterations.
+ *
+ * @return
+ */
+int PCGSolver::get_max_iterations() const {
+    return this->max_iterations;
+}
+
+/**
+ * Solve A*x = b using preconditioned conjugate gradient.
+ *
+ * @param A Symmetric positive definite matrix
+ * @param b Right hand side array
+ * @param x Initial guess, returns solution
+ */
+void PCGSolver::solve(const FEMatrixSparse *A, const double *b, double *x) {
+
+    // Check matrix
+    if (!A->is_square()) {
+        throw std::logic_error("[PCG] Matrix not square");
+    }
+    int n = A->get_square_dimension();
+    std::vector<double> diagonal(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        diagonal[i] = A->get(i, i);
+    }
+    this->solve(n, [A](const double *v, double *av) { A->multiply(v, av); }, diagonal.data(), b, x);
+
+}
+
+/**
+ * Solve A*x = b using preconditioned conjugate gradient and Jacobi preconditioner.
+ *
+ * @param n Dimension
+ * @param A Symmetric positive definite operator
+ * @param diagonal Diagonal of A
+ * @param b Right hand side array
+ * @param x Initial guess, returns solution
+ */
+void PCGSolver::solve(int n, const PCGOperator &A, const double *diagonal, const double *b, double *x) {
+
+    // Create Jacobi preconditioner
+    std::vector<double> dinv(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        if (fabs(diagonal[i]) < __FEMATRIX_ZERO_TOL) {
+            throw std::logic_error("[PCG] Matrix has zero diagonal at row " + std::to_string(i));
+        }
+        dinv[i] = 1 / diagonal[i];
+    }
+    this->solve(n, A, [&dinv, n](const double *r, double *z) {
+        for (int i = 0; i < n; i++) {
+            z[i] = dinv[i] * r[i];
+        }
+    }, b, x);
+
+}
+
+/**
+ * Solve A*x = b using preconditioned conjugate gradient.
+ *
+ * @param n Dimension
+ * @param A Symmetric positive definite operator
+ * @param M Preconditioner, computes z = inv(M)*r
+ * @param b Right hand side array
+ * @param x Initial guess, returns solution
+ */
+void PCGSolver::solve(int n, const PCGOperator &A, const PCGOperator &M, const double *b, double *x) {
+
+    // Check dimension
+    if (n < 1) {
+        throw std::logic_error("[PCG] Invalid dimension");
+    }
+    int maxiter = this->max_iterations;
+    if (maxiter == 0) maxiter = n;
+
+    // Restart history
+    this->history.clear();
+    this->iterations = 0;
+    this->converged = false;
+
+    // Create auxiliar vectors
+    double *r = new double[n];
+    double *z = new double[n];
+    double *p = new double[n];
+    double *ap = new double[n];
+    int i;
+
+    // Initial residual r = b - A*x
+    double bnorm = 0;
+    A(x, ap);
+    for (i = 0; i < n; i++) {
+        r[i] = b[i] - ap[i];
+        bnorm += b[i] * b[i];
+    }
+    bnorm = sqrt(bnorm);
+    if (bnorm < __FEMATRIX_ZERO_TOL) {
+        bnorm = 1;
+    }
+
+    // First direction
+    double rz = 0, rznew, pap, alpha, beta, rnorm = 0;
+    M(r, z);
+    for (i = 0; i < n; i++) {
+        p[i] = z[i];
+        rz += r[i] * z[i];
+        rnorm += r[i] * r[i];
+    }
+    this->history.push_back(sqrt(rnorm) / bnorm);
+    this->converged = this->history.back() < this->tolerance;
+
+    // Iterate
+    while (!this->converged && this->iterations < maxiter) {
+        A(p, ap);
+        pap = 0;
+        for (i = 0; i < n; i++) {
+            pap += p[i] * ap[i];
+        }
+        if (fabs(pap) < __FEMATRIX_ZERO_TOL * __FEMATRIX_ZERO_TOL) {
+            break; // Breakdown, direction has no energy
+        }
+        alpha = rz / pap;
+        rnorm = 0;
+        for (i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * ap[i];
+            rnorm += r[i] * r[i];
+        }
+        this->iterations += 1;
+        this->history.push_back(sqrt(rnorm) / bnorm);
+        if (this->history.back() < this->tolerance) {
+            this->converged = true;
+            break;
+        }
+
+        // Update direction
+        M(r, z);
+        rznew = 0;
+        for (i = 0; i < n; i++) {
+            rznew += r[i] * z[i];
+        }
+        beta = rznew / rz;
+        rz = rznew;
+        for (i = 0; i < n; i++) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+
+    if (!this->converged) {
+        std::cout << "[PCG] Solver did not converge after " << this->iterations << " iterations, relative residual "
+                  << this->history.back() << std::endl;
+    }
+
+    // Delete data
+    delete[] r;
+    delete[] z;
+    delete[] p;
+    delete[] ap;
+
+}
+
+/**
+ * Solve system using zero initial guess and return new matrix.
+ *
+ * @param A Symmetric positive definite matrix
+ * @param b Right hand side vector
+ * @return Solution vector
+ */
+FEMatrix *PCGSolver::solve(const FEMatrixSparse *A, const FEMatrix *b) {
+    int n = A->get_square_dimension();
+    if (!b->is_vector() || b->length() != n) {
+        throw std::logic_error("[PCG] Right hand side must be a vector with matrix dimension");
+    }
+    double *barr = b->get_array();
+    double *x = new double[n];
+    for (int i = 0; i < n; i++) {
+        x[i] = 0;
+    }
+    this->solve(A, barr, x);
+    FEMatrix *sol = new FEMatrix(n, 1, x);
+    delete[] barr;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Number of iterations of the last solve.
+ *
+ * @return
+ */
+int PCGSolver::get_iterations() const {
+    return this->iterations;
+}
+
+/**
+ * Last solve has converged.
+ *
+ * @return
+ */
+bool PCGSolver::has_converged() const {
+    return this->converged;
+}
+
+/**
+ * Return relative residual of each iteration, first value is the initial residual.
+ *
+ * @return
+ */
+std::vector<double> PCGSolver::get_history() const {
+    return this->history;
+}
+
+/**
+ * Display convergence history to console.
+ */
+void PCGSolver::disp() const {
+    std::cout << "PCG solver information:" << std::endl;
+    std::cout << "\tTolerance:\t\t" << this->tolerance << std::endl;
+    std::cout << "\tMax iterations:\t" << this->max_iterations << std::endl;
+    std::cout << "\tIterations:\t\t" << this->iterations << std::endl;
+    std::cout << "\tConverged:\t\t" << (this->converged ? "yes" : "no") << std::endl;
+    std::cout << "\tResidual history:" << std::endl;
+    for (unsigned long i = 0; i < this->history.size(); i++) {
+        std::cout << "\t\t" << i << "\t" << this->history[i] << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+FNELEM-GPU PRECONDITIONED CONJUGATE GRADIENT
+Iterative solver for symmetric positive definite sparse matrices.
+
+@package fnelem.math
+@author ppizarror
+@date 27/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_PCG_H
+#define __FNELEM_MATH_PCG_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_sparse.h"
+
+// Library imports
+#include <functional>
+#include <iostream>
+#include <vector>
+
+// Constant definition
+#define __PCG_DEFAULT_TOLERANCE 1e-10
+#define __PCG_DEFAULT_MAX_ITERATIONS 0 // Zero uses matrix dimension
+
+// Linear operator y = A*x, x and y are arrays of the operator dimension
+typedef std::function<void(const double *, double *)> PCGOperator;
+
+/**
+ * Preconditioned conjugate gradient iterative solver for symmetric positive definite
+ * matrices, uses Jacobi (diagonal) preconditioner. Matrix and preconditioner can also
+ * be given as operators, so the matrix does not need to be assembled.
+ */
+class PCGSolver {
+private:
+
+    // Relative residual tolerance
+    double tolerance = __PCG_DEFAULT_TOLERANCE;
+
+    // Max number of iterations
+    int max_iterations = __PCG_DEFAULT_MAX_ITERATIONS;
+
+    // Number of iterations of the last solve
+    int iterations = 0;
+
+    // Last solve has converged
+    bool converged = false;
+
+    // Relative residual of each iteration
+    std::vector<double> history;
+
+public:
+
+    // Constructor
+    PCGSolver();
+
+    // Destructor
+    ~PCGSolver();
+
+    // Set relative residual tolerance
+    void set_tolerance(double tol);
+
+    // Set max number of iterations
+    void set_max_iterations(int maxiter);
+
+    // Get relative residual tolerance
+    double get_tolerance() const;
+
+    // Get max number of iterations
+    int get_max_iterations() const;
+
+    // Solve A*x = b, x array stores initial guess and returns solution
+    void solve(const FEMatrixSparse *A, const double *b, double *x);
+
+    // Solve A*x = b using operators, M applies the preconditioner z = inv(M)*r
+    void solve(int n, const PCGOperator &A, const PCGOperator &M, const double *b, double *x);
+
+    // Solve A*x = b using an operator and the Jacobi preconditioner from the diagonal of A
+    void solve(int n, const PCGOperator &A, const double *diagonal, const double *b, double *x);
+
+    // Solve system and return new matrix
+    FEMatrix *solve(const FEMatrixSparse *A, const FEMatrix *b);
+
+    // Number of iterations of the last solve
+    int get_iterations() const;
+
+    // Last solve has converged
+    bool has_converged() const;
+
+    // Return relative residual of each iteration
+    std::vector<double> get_history() const;
+
+    // Display convergence history to console
+    void disp() const;
+
+};
+
+#endif // __FNELEM_MATH_PCG_H
\ No newline at end of file
@@ -0,0 +1,443 @@
+/**
+FNELEM-GPU SUBSTRUCTURING SOLVER
+Domain decomposition direct solver using the Schur complement of the interface.
+
+@package fnelem.math
+@author ppizarror
+@date 01/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "schur_solver.h"
+
+/**
+ * Constructor.
+ *
+ * @param n Dimension of the system
+ * @param ndomains Number of domains
+ */
+SchurSolver::SchurSolver(int n, int ndomains) {
+    if (n < 1) {
+        throw std::logic_error("[SCHUR] Invalid dimension");
+    }
+    if (ndomains < 1) {
+        throw std::logic_error("[SCHUR] Number of domains must be greater than zero");
+    }
+    this->n = n;
+    this->ndomains = ndomains;
+    this->index_ptr.assign(static_cast<unsigned long>(ndomains), std::vector<long>(1, 0));
+    this->index.resize(static_cast<unsigned long>(ndomains));
+    this->values.resize(static_cast<unsigned long>(ndomains));
+}
+
+/**
+ * Destructor.
+ */
+SchurSolver::~SchurSolver() {
+    this->destroy();
+}
+
+/**
+ * Delete factorization.
+ */
+void SchurSolver::destroy() {
+    for (auto &f : this->ldl) {
+        delete f;
+    }
+    this->ldl.clear();
+    this->condensed.clear();
+    this->interior.clear();
+    this->boundary.clear();
+    this->interface.clear();
+    delete this->schur;
+    this->schur = nullptr;
+    this->factorized = false;
+}
+
+/**
+ * Adds element to domain.
+ *
+ * @param domain Domain of the element
+ * @param nblock Element dimension
+ * @param index Position of each element row/column within the system, negative values are skipped
+ * @param block Element values, row major
+ */
+void SchurSolver::add_element(int domain, int nblock, const int *index, const double *block) {
+    if (domain < 0 || domain >= this->ndomains) {
+        throw std::logic_error("[SCHUR] Domain position overflow");
+    }
+    for (int r = 0; r < nblock; r++) {
+        if (index[r] >= this->n) {
+            throw std::logic_error("[SCHUR] Element position overflow system dimension");
+        }
+    }
+    for (int r = 0; r < nblock; r++) {
+        this->index[domain].push_back(index[r]);
+    }
+    for (int k = 0; k < nblock * nblock; k++) {
+        this->values[domain].push_back(block[k]);
+    }
+    this->index_ptr[domain].push_back(static_cast<long>(this->index[domain].size()));
+    this->factorized = false;
+}
+
+/**
+ * Set pool used to process domains in parallel.
+ *
+ * @param pool Thread pool, nullptr processes domains serially
+ */
+void SchurSolver::set_thread_pool(ThreadPool *pool) {
+    this->pool = pool;
+}
+
+/**
+ * Runs function for each domain, in parallel if a pool is defined. Functions of different
+ * domains must not write the same data.
+ *
+ * @param f Function, receives the domain
+ */
+void SchurSolver::for_each_domain(const std::function<void(int)> &f) const {
+    if (this->pool == nullptr || this->ndomains == 1) {
+        for (int d = 0; d < this->ndomains; d++) {
+            f(d);
+        }
+        return;
+    }
+    this->pool->parallel_for(this->ndomains, [&](int begin, int end) {
+        for (int d = begin; d < end; d++) {
+            f(d);
+        }
+    });
+}
+
+/**
+ * Classify DOF into interior and interface, condense each domain onto its interface and
+ * factorize the interface system.
+ */
+void SchurSolver::factorize() {
+    this->destroy();
+
+    // Owner of each DOF, -2 if it belongs to several domains
+    std::vector<int> owner(static_cast<unsigned long>(this->n), -1);
+    int d;
+    for (d = 0; d < this->ndomains; d++) {
+        for (int i : this->index[d]) {
+            if (i < 0) continue;
+            if (owner[i] == -1) {
+                owner[i] = d;
+            } else if (owner[i] != d) {
+                owner[i] = -2;
+            }
+        }
+    }
+
+    // Interior and interface DOF
+    this->interior.resize(static_cast<unsigned long>(this->ndomains));
+    std::vector<int> interface_pos(static_cast<unsigned long>(this->n), -1);
+    for (int i = 0; i < this->n; i++) {
+        if (owner[i] == -1) {
+            throw std::logic_error("[SCHUR] DOF does not belong to any element");
+        } else if (owner[i] == -2) {
+            interface_pos[i] = static_cast<int>(this->interface.size());
+            this->interface.push_back(i);
+        } else {
+            this->interior[owner[i]].push_back(i);
+        }
+    }
+
+    // Interface DOF of each domain
+    this->boundary.resize(static_cast<unsigned long>(this->ndomains));
+    for (d = 0; d < this->ndomains; d++) {
+        for (int i : this->index[d]) {
+            if (i >= 0 && interface_pos[i] >= 0) {
+                this->boundary[d].push_back(interface_pos[i]);
+            }
+        }
+        std::sort(this->boundary[d].begin(), this->boundary[d].end());
+        this->boundary[d].erase(std::unique(this->boundary[d].begin(), this->boundary[d].end()),
+                                this->boundary[d].end());
+    }
+
+    // Condense each domain
+    this->ldl.assign(static_cast<unsigned long>(this->ndomains), nullptr);
+    this->condensed.resize(static_cast<unsigned long>(this->ndomains));
+    std::vector<std::vector<double>> S(static_cast<unsigned long>(this->ndomains));
+    this->for_each_domain([&](int domain) { this->condense(domain, &S[domain]); });
+
+    // Assemble and factorize interface system
+    int ng = static_cast<int>(this->interface.size());
+    if (ng > 0) {
+        FEMatrix *Sg = new FEMatrix(ng, ng);
+        int nb, a, b;
+        for (d = 0; d < this->ndomains; d++) {
+            nb = static_cast<int>(this->boundary[d].size());
+            for (a = 0; a < nb; a++) {
+                for (b = 0; b < nb; b++) {
+                    Sg->set(this->boundary[d][a], this->boundary[d][b],
+                            Sg->get(this->boundary[d][a], this->boundary[d][b]) + S[d][a * nb + b]);
+                }
+            }
+        }
+        this->schur = new FEMatrixFactorization();
+        try {
+            this->schur->cholesky(Sg);
+        } catch (const std::logic_error &e) {
+            this->schur->lu(Sg);
+        }
+        delete Sg;
+    }
+    this->factorized = true;
+}
+
+/**
+ * Factorize interior stiffness and compute the Schur complement of a domain,
+ * S = Kgg - Kgi*inv(Kii)*Kig. The matrix inv(Kii)*Kig is kept to condense the forces and
+ * recover the interior displacements.
+ *
+ * @param d Domain
+ * @param S Stores Schur complement, row major
+ */
+void SchurSolver::condense(int d, std::vector<double> *S) {
+    int ni = static_cast<int>(this->interior[d].size());
+    int nb = static_cast<int>(this->boundary[d].size());
+
+    // Local position, interior values are positive and interface values are -(k+1)
+    std::unordered_map<int, int> local;
+    int k;
+    for (k = 0; k < ni; k++) {
+        local[this->interior[d][k]] = k;
+    }
+    for (k = 0; k < nb; k++) {
+        local[this->interface[this->boundary[d][k]]] = -(k + 1);
+    }
+
+    // Local position of element DOF, interior pattern
+    std::vector<int> loc(this->index[d].size(), 0);
+    for (unsigned long t = 0; t < this->index[d].size(); t++) {
+        loc[t] = this->index[d][t] < 0 ? -(nb + 1) : local.at(this->index[d][t]); // Restrained DOF are skipped
+    }
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(ni));
+    long e, r, s, nblock, ne = static_cast<long>(this->index_ptr[d].size()) - 1;
+    for (e = 0; e < ne; e++) {
+        for (r = this->index_ptr[d][e]; r < this->index_ptr[d][e + 1]; r++) {
+            if (loc[r] < 0) continue;
+            for (s = this->index_ptr[d][e]; s < this->index_ptr[d][e + 1]; s++) {
+                if (loc[s] >= 0) pattern[loc[r]].push_back(loc[s]);
+            }
+        }
+    }
+
+    // Assemble interior, coupling and interface blocks
+    FEMatrixSparse *Kii = ni > 0 ? new FEMatrixSparse(ni, ni, &pattern, true) : nullptr;
+    std::vector<double> Kib(static_cast<unsigned long>(ni * nb), 0);
+    S->assign(static_cast<unsigned long>(nb * nb), 0);
+    long vpos = 0, i0;
+    int lr, ls;
+    double v;
+    for (e = 0; e < ne; e++) {
+        i0 = this->index_ptr[d][e];
+        nblock = this->index_ptr[d][e + 1] - i0;
+        for (r = 0; r < nblock; r++) {
+            lr = loc[i0 + r];
+            if (lr < -nb) continue;
+            for (s = 0; s < nblock; s++) {
+                ls = loc[i0 + s];
+                if (ls < -nb) continue;
+                v = this->values[d][vpos + r * nblock + s];
+                if (lr >= 0 && ls >= 0) {
+                    if (ls <= lr) Kii->add(lr, ls, v);
+                } else if (lr >= 0) {
+                    Kib[lr * nb - ls - 1] += v;
+                } else if (ls < 0) {
+                    S->at(static_cast<unsigned long>((-lr - 1) * nb - ls - 1)) += v;
+                }
+            }
+        }
+        vpos += nblock * nblock;
+    }
+
+    // Condense, X = inv(Kii)*Kib and S -= Kib'*X
+    if (ni > 0) {
+        this->ldl[d] = new SparseLDL();
+        this->ldl[d]->factorize(Kii);
+        delete Kii;
+        std::vector<double> X = Kib;
+        if (nb > 0) {
+            this->ldl[d]->solve(X.data(), nb);
+        }
+        for (k = 0; k < ni; k++) {
+            for (int a = 0; a < nb; a++) {
+                v = Kib[k * nb + a];
+                if (v == 0) continue;
+                for (int b = 0; b < nb; b++) {
+                    S->at(static_cast<unsigned long>(a * nb + b)) -= v * X[k * nb + b];
+                }
+            }
+        }
+        this->condensed[d] = X;
+    }
+}
+
+/**
+ * Solve K*X = B in place. Forces are condensed onto the interface, the interface system
+ * is solved and then the interior displacements of each domain are recovered.
+ *
+ * @param b Right hand side, stores solution. Row major (n x nrhs)
+ * @param nrhs Number of right hand sides
+ */
+void SchurSolver::solve(double *b, int nrhs) const {
+    if (!this->factorized) {
+        throw std::logic_error("[SCHUR] System has not been factorized");
+    }
+    int ng = static_cast<int>(this->interface.size());
+    std::vector<double> g(static_cast<unsigned long>(ng * nrhs));
+    int i, j, k;
+    for (i = 0; i < ng; i++) {
+        for (j = 0; j < nrhs; j++) {
+            g[i * nrhs + j] = b[this->interface[i] * nrhs + j];
+        }
+    }
+
+    // Interior solution with fixed interface and condensed forces, gd = X'*fi
+    std::vector<std::vector<double>> y(static_cast<unsigned long>(this->ndomains));
+    std::vector<std::vector<double>> gd(static_cast<unsigned long>(this->ndomains));
+    this->for_each_domain([&](int d) {
+        int ni = static_cast<int>(this->interior[d].size());
+        int nb = static_cast<int>(this->boundary[d].size());
+        if (ni == 0) return;
+        y[d].resize(static_cast<unsigned long>(ni * nrhs));
+        gd[d].assign(static_cast<unsigned long>(nb * nrhs), 0);
+        const std::vector<double> &X = this->condensed[d];
+        double f;
+        for (int r = 0; r < ni; r++) {
+            for (int c = 0; c < nrhs; c++) {
+                f = b[this->interior[d][r] * nrhs + c];
+                y[d][r * nrhs + c] = f;
+                for (int a = 0; a < nb; a++) {
+                    gd[d][a * nrhs + c] += X[r * nb + a] * f;
+                }
+            }
+        }
+        this->ldl[d]->solve(y[d].data(), nrhs);
+    });
+
+    // Interface system
+    int nb;
+    for (int d = 0; d < this->ndomains; d++) {
+        nb = static_cast<int>(gd[d].size()) / nrhs;
+        for (k = 0; k < nb; k++) {
+            for (j = 0; j < nrhs; j++) {
+                g[this->boundary[d][k] * nrhs + j] -= gd[d][k * nrhs + j];
+            }
+        }
+    }
+    if (ng > 0) {
+        this->schur->solve(g.data(), nrhs);
+    }
+
+    // Recover interior displacements, ui = y - X*ug
+    this->for_each_domain([&](int d) {
+        int ni = static_cast<int>(this->interior[d].size());
+        int nbd = static_cast<int>(this->boundary[d].size());
+        const std::vector<double> &X = this->condensed[d];
+        double u;
+        for (int r = 0; r < ni; r++) {
+            for (int c = 0; c < nrhs; c++) {
+                u = y[d][r * nrhs + c];
+                for (int a = 0; a < nbd; a++) {
+                    u -= X[r * nbd + a] * g[this->boundary[d][a] * nrhs + c];
+                }
+                b[this->interior[d][r] * nrhs + c] = u;
+            }
+        }
+    });
+    for (i = 0; i < ng; i++) {
+        for (j = 0; j < nrhs; j++) {
+            b[this->interface[i] * nrhs + j] = g[i * nrhs + j];
+        }
+    }
+}
+
+/**
+ * Solve system and return new matrix.
+ *
+ * @param b Right hand side, vector or matrix of n rows
+ * @return Solution
+ */
+FEMatrix *SchurSolver::solve(const FEMatrix *b) const {
+    int *dim = b->size();
+    if (dim[0] != this->n) {
+        delete[] dim;
+        throw std::logic_error("[SCHUR] Right hand side must have the system dimension");
+    }
+    double *x = b->get_array();
+    this->solve(x, dim[1]);
+    FEMatrix *sol = new FEMatrix(dim[0], dim[1], x);
+    delete[] dim;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Interface system has been factorized.
+ *
+ * @return
+ */
+bool SchurSolver::is_factorized() const {
+    return this->factorized;
+}
+
+/**
+ * Return number of domains.
+ *
+ * @return
+ */
+int SchurSolver::get_domains() const {
+    return this->ndomains;
+}
+
+/**
+ * Return number of interface DOF.
+ *
+ * @return
+ */
+int SchurSolver::get_interface_dimension() const {
+    return static_cast<int>(this->interface.size());
+}
+
+/**
+ * Return number of interior DOF of a domain.
+ *
+ * @param domain Domain
+ * @return
+ */
+int SchurSolver::get_interior_dimension(int domain) const {
+    if (domain < 0 || domain >= this->ndomains) {
+        throw std::logic_error("[SCHUR] Domain position overflow");
+    }
+    if (this->interior.empty()) {
+        return 0;
+    }
+    return static_cast<int>(this->interior[domain].size());
+}
\ No newline at end of file
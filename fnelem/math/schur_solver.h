@@ -0,0 +1,146 @@
+/**
+FNELEM-GPU SUBSTRUCTURING SOLVER
+Domain decomposition direct solver using the Schur complement of the interface.
+
+@package fnelem.math
+@author ppizarror
+@date 01/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_SCHUR_SOLVER_H
+#define __FNELEM_MATH_SCHUR_SOLVER_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_factorization.h"
+#include "fematrix_sparse.h"
+#include "sparse_ldl.h"
+#include "thread_pool.h"
+
+// Library imports
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Substructuring (domain decomposition) direct solver. Elements are grouped into domains,
+ * a DOF is interior if it only belongs to elements of one domain, else it is an interface
+ * DOF. The interior stiffness of each domain is factorized (sparse LDL') and condensed
+ * onto its interface, S = Kgg - Kgi*inv(Kii)*Kig, the interface system gathers the Schur
+ * complement of all domains and it is solved using a dense Cholesky factorization. Then,
+ * interior displacements are recovered domain by domain. Domains are independent, so they
+ * are condensed and recovered in parallel if a thread pool is given.
+ */
+class SchurSolver {
+private:
+
+    // Dimension of the system
+    int n = 0;
+
+    // Number of domains
+    int ndomains = 0;
+
+    // Position of each element within index array of each domain
+    std::vector<std::vector<long>> index_ptr;
+
+    // DOF position of the elements of each domain, negative values are skipped
+    std::vector<std::vector<int>> index;
+
+    // Element stiffness values of each domain, row major
+    std::vector<std::vector<double>> values;
+
+    // Interior DOF of each domain
+    std::vector<std::vector<int>> interior;
+
+    // Interface position of the interface DOF of each domain
+    std::vector<std::vector<int>> boundary;
+
+    // Interface DOF
+    std::vector<int> interface;
+
+    // Factorization of the interior stiffness of each domain
+    std::vector<SparseLDL *> ldl;
+
+    // inv(Kii)*Kig of each domain, row major
+    std::vector<std::vector<double>> condensed;
+
+    // Schur complement of the interface
+    FEMatrixFactorization *schur = nullptr;
+
+    // Thread pool, not owned
+    ThreadPool *pool = nullptr;
+
+    // Interface system has been factorized
+    bool factorized = false;
+
+    // Delete factorization
+    void destroy();
+
+    // Runs function for each domain, in parallel if a pool is defined
+    void for_each_domain(const std::function<void(int)> &f) const;
+
+    // Factorize interior and compute the Schur complement of a domain
+    void condense(int d, std::vector<double> *S);
+
+public:
+
+    // Constructor
+    SchurSolver(int n, int ndomains);
+
+    // Destructor
+    ~SchurSolver();
+
+    // Adds element to domain, K[index[r]][index[s]] += block[r][s]
+    void add_element(int domain, int nblock, const int *index, const double *block);
+
+    // Set pool used to process domains in parallel
+    void set_thread_pool(ThreadPool *pool);
+
+    // Classify DOF, condense each domain and factorize interface system
+    void factorize();
+
+    // Solve K*X = B in place, B has nrhs columns stored row major
+    void solve(double *b, int nrhs) const;
+
+    // Solve system and return new matrix, B can be a vector or a matrix
+    FEMatrix *solve(const FEMatrix *b) const;
+
+    // Interface system has been factorized
+    bool is_factorized() const;
+
+    // Return number of domains
+    int get_domains() const;
+
+    // Return number of interface DOF
+    int get_interface_dimension() const;
+
+    // Return number of interior DOF of a domain
+    int get_interior_dimension(int domain) const;
+
+};
+
+#endif // __FNELEM_MATH_SCHUR_SOLVER_H
\ No newline at end of file
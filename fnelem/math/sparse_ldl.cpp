@@ -0,0 +1,495 @@
+/**
+FNELEM-GPU SPARSE LDL FACTORIZATION
+Performs sparse LDL' factorization of symmetric matrices.
+Based on: Timothy A. Davis, Algorithm 849: A concise sparse Cholesky factorization package.
+
+@package fnelem.math
+@author ppizarror
+@date 26/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "sparse_ldl.h"
+
+/**
+ * Constructor.
+ */
+SparseLDL::SparseLDL() = default;
+
+/**
+ * Destructor.
+ */
+SparseLDL::~SparseLDL() {
+    this->destroy();
+}
+
+/**
+ * Delete symbolic and numeric data.
+ */
+void SparseLDL::destroy() {
+    delete[] this->parent;
+    delete[] this->lp;
+    delete[] this->lnz;
+    delete[] this->li;
+    delete[] this->lx;
+    delete[] this->d;
+    delete[] this->lxf;
+    delete[] this->df;
+    this->parent = nullptr;
+    this->lp = nullptr;
+    this->lnz = nullptr;
+    this->li = nullptr;
+    this->lx = nullptr;
+    this->d = nullptr;
+    this->lxf = nullptr;
+    this->df = nullptr;
+    this->analyzed = false;
+    this->factorized = false;
+}
+
+/**
+ * Check matrix is square and stores the lower triangle.
+ *
+ * @param A Matrix
+ */
+void SparseLDL::check_matrix(const FEMatrixSparse *A) const {
+    if (!A->is_square()) {
+        throw std::logic_error("[SPARSE-LDL] Matrix not square, cannot be factorized");
+    }
+    if (!A->is_symmetric()) {
+        throw std::logic_error("[SPARSE-LDL] Matrix must be symmetric");
+    }
+}
+
+/**
+ * Check matrix has the pattern used by symbolic factorization, the number of non zeros
+ * and the pattern fingerprint must be the same.
+ *
+ * @param A Matrix
+ * @return
+ */
+bool SparseLDL::same_pattern(const FEMatrixSparse *A) const {
+    return this->analyzed && A->get_square_dimension() == this->n && A->get_nnz() == this->annz &&
+           A->get_pattern_fingerprint() == this->pattern;
+}
+
+/**
+ * Computes the elimination tree and the number of non zeros of each column of L, only
+ * the pattern of the lower triangle is used.
+ *
+ * @param n Matrix dimension
+ * @param ap Row pointer of the lower triangle
+ * @param ai Column index of the lower triangle
+ * @param parent Parent of each column, -1 if root, array of n values
+ * @param lnz Number of non zeros of each column of L, array of n values
+ */
+void SparseLDL::elimination_tree(int n, const int *ap, const int *ai, int *parent, int *lnz) {
+    int *flag = new int[n];
+    int i, k, p;
+    for (k = 0; k < n; k++) {
+        parent[k] = -1;
+        flag[k] = k;
+        lnz[k] = 0;
+        for (p = ap[k]; p < ap[k + 1]; p++) {
+            i = ai[p];
+            if (i < k) {
+
+                // Follow path from i to the root of the etree, stop at flagged node
+                for (; flag[i] != k; i = parent[i]) {
+                    if (parent[i] == -1) parent[i] = k;
+                    lnz[i] += 1; // L(k,i) is non zero
+                    flag[i] = k;
+                }
+
+            }
+        }
+    }
+    delete[] flag;
+}
+
+/**
+ * Symbolic factorization. Computes the elimination tree and the column counts of L. As
+ * matrix stores the lower triangle by rows, row k contains A(j,k) for j <= k, that is,
+ * the upper part of the column k.
+ *
+ * @param A Symmetric matrix
+ */
+void SparseLDL::symbolic(const FEMatrixSparse *A) {
+    this->check_matrix(A);
+    this->destroy();
+    this->n = A->get_square_dimension();
+
+    this->parent = new int[this->n];
+    this->lnz = new int[this->n];
+    this->lp = new int[this->n + 1];
+    SparseLDL::elimination_tree(this->n, A->get_row_ptr(), A->get_col_index(), this->parent, this->lnz);
+
+    // Construct column pointers of L
+    this->lp[0] = 0;
+    for (int k = 0; k < this->n; k++) {
+        this->lp[k + 1] = this->lp[k] + this->lnz[k];
+    }
+    this->lnnz = this->lp[this->n];
+    this->annz = A->get_nnz();
+    this->pattern = A->get_pattern_fingerprint();
+    this->li = new int[this->lnnz];
+    if (this->single) {
+        this->lxf = new float[this->lnnz];
+        this->df = new float[this->n];
+    } else {
+        this->lx = new double[this->lnnz];
+        this->d = new double[this->n];
+    }
+    this->analyzed = true;
+}
+
+/**
+ * Numeric factorization, computes row k of L by solving a sparse triangular system
+ * whose pattern is given by the elimination tree.
+ *
+ * @param A Symmetric matrix, must have the same pattern used by symbolic
+ */
+void SparseLDL::numeric(const FEMatrixSparse *A) {
+    if (!this->analyzed) {
+        throw std::logic_error("[SPARSE-LDL] Symbolic factorization must be done first");
+    }
+    this->check_matrix(A);
+    if (A->get_square_dimension() != this->n) {
+        throw std::logic_error("[SPARSE-LDL] Matrix dimension does not agree with symbolic factorization");
+    }
+    if (!this->same_pattern(A)) {
+        throw std::logic_error("[SPARSE-LDL] Matrix pattern does not agree with symbolic factorization");
+    }
+    this->factorized = false;
+    if (this->single) {
+        this->numeric_factor<float>(A, this->lxf, this->df, __SPARSE_LDL_PIVOT_TOLERANCE_SINGLE);
+    } else {
+        this->numeric_factor<double>(A, this->lx, this->d, __SPARSE_LDL_PIVOT_TOLERANCE);
+    }
+    this->factorized = true;
+}
+
+/**
+ * Computes L and D values using the given precision, the work row also uses it.
+ *
+ * @tparam T Value type
+ * @param A Symmetric matrix
+ * @param lx L values
+ * @param d D values
+ * @param tol Pivot tolerance relative to the matrix diagonal
+ */
+template<typename T>
+void SparseLDL::numeric_factor(const FEMatrixSparse *A, T *lx, T *d, double tol) {
+    const int *ap = A->get_row_ptr();
+    const int *ai = A->get_col_index();
+    const double *ax = A->get_values();
+
+    T *y = new T[this->n];
+    int *pattern = new int[this->n];
+    int *flag = new int[this->n];
+
+    int i, k, p, p2, len, top;
+    T yi, l_ki;
+    double akk;
+    for (k = 0; k < this->n; k++) {
+
+        // Compute nonzero pattern of k-th row of L, in topological order
+        y[k] = 0;
+        top = this->n;
+        flag[k] = k;
+        this->lnz[k] = 0;
+        akk = 0;
+        for (p = ap[k]; p < ap[k + 1]; p++) {
+            i = ai[p];
+            y[i] += static_cast<T>(ax[p]); // Scatter A(i,k) into y
+            if (i == k) akk = ax[p];
+            for (len = 0; flag[i] != k; i = this->parent[i]) {
+                pattern[len++] = i; // L(k,i) is non zero
+                flag[i] = k;
+            }
+            while (len > 0) pattern[--top] = pattern[--len];
+        }
+
+        // Compute numerical values of k-th row of L (sparse triangular solve)
+        d[k] = y[k];
+        y[k] = 0;
+        for (; top < this->n; top++) {
+            i = pattern[top];
+            yi = y[i];
+            y[i] = 0;
+            p2 = this->lp[i] + this->lnz[i];
+            for (p = this->lp[i]; p < p2; p++) {
+                y[this->li[p]] -= lx[p] * yi;
+            }
+            l_ki = yi / d[i];
+            d[k] -= l_ki * yi;
+            this->li[p] = k;
+            lx[p] = l_ki;
+            this->lnz[i] += 1;
+        }
+
+        // Check pivot
+        if (!std::isfinite(d[k]) || fabs(d[k]) <= tol * fabs(akk)) {
+            delete[] y;
+            delete[] pattern;
+            delete[] flag;
+            throw std::logic_error("[SPARSE-LDL] Matrix is singular, zero pivot at row " + std::to_string(k));
+        }
+
+    }
+
+    delete[] y;
+    delete[] pattern;
+    delete[] flag;
+}
+
+/**
+ * Performs factorization, symbolic is only computed if it has not been done before or
+ * if the pattern of the matrix has changed.
+ *
+ * @param A Symmetric matrix
+ */
+void SparseLDL::factorize(const FEMatrixSparse *A) {
+    if (!this->same_pattern(A)) {
+        this->symbolic(A);
+    }
+    this->numeric(A);
+}
+
+/**
+ * Solve L*D*L'*x = b in place.
+ *
+ * @param x Array of n values, stores b and returns the solution
+ */
+void SparseLDL::solve(double *x) const {
+    this->solve(x, 1);
+}
+
+/**
+ * Solve L*D*L'*X = B in place for several right hand sides, each value of L is applied
+ * to all the columns of B within the same pass.
+ *
+ * @param x Array of n*nrhs values row major, stores B and returns the solution
+ * @param nrhs Number of right hand sides
+ */
+void SparseLDL::solve(double *x, int nrhs) const {
+    if (!this->factorized) {
+        throw std::logic_error("[SPARSE-LDL] Matrix has not been factorized");
+    }
+    if (this->single) {
+        this->solve_factor<float>(this->lxf, this->df, x, nrhs);
+    } else {
+        this->solve_factor<double>(this->lx, this->d, x, nrhs);
+    }
+}
+
+/**
+ * Triangular solves using factor values of the given precision, right hand sides are
+ * kept in double precision.
+ *
+ * @tparam T Value type
+ * @param lx L values
+ * @param d D values
+ * @param x Array of n*nrhs values row major, stores B and returns the solution
+ * @param nrhs Number of right hand sides
+ */
+template<typename T>
+void SparseLDL::solve_factor(const T *lx, const T *d, double *x, int nrhs) const {
+    int j, p, r;
+    double l, *xi, *xj;
+
+    // Solve L*Y = B
+    for (j = 0; j < this->n; j++) {
+        xj = x + j * nrhs;
+        for (p = this->lp[j]; p < this->lp[j + 1]; p++) {
+            l = lx[p];
+            xi = x + this->li[p] * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                xi[r] -= l * xj[r];
+            }
+        }
+    }
+
+    // Solve D*Z = Y
+    for (j = 0; j < this->n; j++) {
+        xj = x + j * nrhs;
+        for (r = 0; r < nrhs; r++) {
+            xj[r] /= d[j];
+        }
+    }
+
+    // Solve L'*X = Z
+    for (j = this->n - 1; j >= 0; j--) {
+        xj = x + j * nrhs;
+        for (p = this->lp[j]; p < this->lp[j + 1]; p++) {
+            l = lx[p];
+            xi = x + this->li[p] * nrhs;
+            for (r = 0; r < nrhs; r++) {
+                xj[r] -= l * xi[r];
+            }
+        }
+    }
+}
+
+/**
+ * Solve system and return new matrix.
+ *
+ * @param b Right hand side vector, or matrix with one right hand side per column
+ * @return Solution
+ */
+FEMatrix *SparseLDL::solve(const FEMatrix *b) const {
+    int *dim = b->size();
+    if (dim[0] != this->n) {
+        delete[] dim;
+        throw std::logic_error("[SPARSE-LDL] Right hand side must have the matrix dimension");
+    }
+    double *x = b->get_array();
+    this->solve(x, dim[1]);
+    FEMatrix *sol = new FEMatrix(dim[0], dim[1], x);
+    delete[] dim;
+    delete[] x;
+    return sol;
+}
+
+/**
+ * Symbolic factorization has been done.
+ *
+ * @return
+ */
+bool SparseLDL::is_analyzed() const {
+    return this->analyzed;
+}
+
+/**
+ * Numeric factorization has been done.
+ *
+ * @return
+ */
+bool SparseLDL::is_factorized() const {
+    return this->factorized;
+}
+
+/**
+ * Return number of non zeros of L.
+ *
+ * @return
+ */
+int SparseLDL::get_factor_nnz() const {
+    return this->lnnz;
+}
+
+/**
+ * Return dimension of the factorized matrix.
+ *
+ * @return
+ */
+int SparseLDL::get_dimension() const {
+    return this->n;
+}
+
+/**
+ * Return elimination tree, -1 if column is a root.
+ *
+ * @return
+ */
+const int *SparseLDL::get_elimination_tree() const {
+    return this->parent;
+}
+
+/**
+ * Return D values, nullptr if factors are stored in single precision.
+ *
+ * @return
+ */
+const double *SparseLDL::get_diagonal() const {
+    return this->d;
+}
+
+/**
+ * Return determinant of the factorized matrix, product of D values.
+ *
+ * @return
+ */
+double SparseLDL::det() const {
+    if (!this->factorized) {
+        throw std::logic_error("[SPARSE-LDL] Matrix has not been factorized");
+    }
+    double det = 1;
+    for (int k = 0; k < this->n; k++) {
+        det *= this->single ? this->df[k] : this->d[k];
+    }
+    return det;
+}
+
+/**
+ * Return logarithm of the absolute determinant, it does not overflow for large matrices.
+ *
+ * @param sign Sign of the determinant, -1 or 1
+ * @return
+ */
+double SparseLDL::log_det(int *sign) const {
+    if (!this->factorized) {
+        throw std::logic_error("[SPARSE-LDL] Matrix has not been factorized");
+    }
+    double logdet = 0;
+    double dk;
+    *sign = 1;
+    for (int k = 0; k < this->n; k++) {
+        dk = this->single ? this->df[k] : this->d[k];
+        logdet += log(fabs(dk));
+        if (dk < 0) *sign = -*sign;
+    }
+    return logdet;
+}
+
+/**
+ * Store factors in single precision, symbolic factorization must be done again.
+ *
+ * @param enabled Single precision factors
+ */
+void SparseLDL::set_single_precision(bool enabled) {
+    if (this->single != enabled) {
+        this->destroy();
+    }
+    this->single = enabled;
+}
+
+/**
+ * Factors are stored in single precision.
+ *
+ * @return
+ */
+bool SparseLDL::is_single_precision() const {
+    return this->single;
+}
+
+/**
+ * Return memory used by L and D values.
+ *
+ * @return Number of bytes
+ */
+long SparseLDL::get_factor_bytes() const {
+    long size = this->single ? sizeof(float) : sizeof(double);
+    return (static_cast<long>(this->lnnz) + this->n) * size;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+FNELEM-GPU SPARSE LDL FACTORIZATION
+Performs sparse LDL' factorization of symmetric matrices.
+
+@package fnelem.math
+@author ppizarror
+@date 26/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_SPARSE_LDL_H
+#define __FNELEM_MATH_SPARSE_LDL_H
+
+// Include headers
+#include "fematrix.h"
+#include "fematrix_sparse.h"
+
+// Library imports
+#include <cmath>
+#include <string>
+
+// Constant definition
+#define __SPARSE_LDL_PIVOT_TOLERANCE 1e-14
+#define __SPARSE_LDL_PIVOT_TOLERANCE_SINGLE 1e-6
+
+/**
+ * Sparse LDL' factorization of a symmetric matrix. Symbolic factorization computes the
+ * elimination tree and the number of non zeros of each column of L, numeric factorization
+ * computes L and D values using the same pattern.
+ */
+class SparseLDL {
+private:
+
+    // Dimension of the matrix
+    int n = 0;
+
+    // Number of non zeros of L
+    int lnnz = 0;
+
+    // Number of non zeros of the matrix used by symbolic factorization
+    int annz = 0;
+
+    // Pattern fingerprint of the matrix used by symbolic factorization
+    unsigned long long pattern = 0;
+
+    // Elimination tree, parent of each column
+    int *parent = nullptr;
+
+    // Column pointer of L
+    int *lp = nullptr;
+
+    // Number of non zeros of each column of L
+    int *lnz = nullptr;
+
+    // Row index of L values
+    int *li = nullptr;
+
+    // L values, unit diagonal is not stored
+    double *lx = nullptr;
+
+    // D values
+    double *d = nullptr;
+
+    // L values, single precision
+    float *lxf = nullptr;
+
+    // D values, single precision
+    float *df = nullptr;
+
+    // Factors are stored in single precision
+    bool single = false;
+
+    // Symbolic factorization has been done
+    bool analyzed = false;
+
+    // Numeric factorization has been done
+    bool factorized = false;
+
+    // Check matrix can be factorized
+    void check_matrix(const FEMatrixSparse *A) const;
+
+    // Check matrix has the pattern used by symbolic factorization
+    bool same_pattern(const FEMatrixSparse *A) const;
+
+    // Delete symbolic and numeric data
+    void destroy();
+
+    // Compute L and D values using the given precision
+    template<typename T>
+    void numeric_factor(const FEMatrixSparse *A, T *lx, T *d, double tol);
+
+    // Triangular solves using factors of the given precision
+    template<typename T>
+    void solve_factor(const T *lx, const T *d, double *x, int nrhs) const;
+
+public:
+
+    // Constructor
+    SparseLDL();
+
+    // Destructor
+    ~SparseLDL();
+
+    // Compute elimination tree and column counts of L from the pattern of the lower triangle
+    static void elimination_tree(int n, const int *ap, const int *ai, int *parent, int *lnz);
+
+    // Compute elimination tree and the pattern of L
+    void symbolic(const FEMatrixSparse *A);
+
+    // Compute L and D values, symbolic must be done first
+    void numeric(const FEMatrixSparse *A);
+
+    // Performs symbolic (if not done or pattern changed) and numeric factorization
+    void factorize(const FEMatrixSparse *A);
+
+    // Solve L*D*L'*x = b in place, x array stores b
+    void solve(double *x) const;
+
+    // Solve L*D*L'*X = B in place, B has nrhs columns stored row major
+    void solve(double *x, int nrhs) const;
+
+    // Solve system and return new matrix
+    FEMatrix *solve(const FEMatrix *b) const;
+
+    // Symbolic factorization has been done
+    bool is_analyzed() const;
+
+    // Numeric factorization has been done
+    bool is_factorized() const;
+
+    // Return number of non zeros of L
+    int get_factor_nnz() const;
+
+    // Return dimension of the factorized matrix
+    int get_dimension() const;
+
+    // Return elimination tree
+    const int *get_elimination_tree() const;
+
+    // Return D values
+    const double *get_diagonal() const;
+
+    // Return determinant of the factorized matrix
+    double det() const;
+
+    // Return logarithm of the absolute determinant, sign stores -1 or 1
+    double log_det(int *sign) const;
+
+    // Store factors in single precision
+    void set_single_precision(bool enabled);
+
+    // Factors are stored in single precision
+    bool is_single_precision() const;
+
+    // Return memory used by factor values in bytes
+    long get_factor_bytes() const;
+
+};
+
+#endif // __FNELEM_MATH_SPARSE_LDL_H
\ No newline at end of file
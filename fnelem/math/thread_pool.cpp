@@ -0,0 +1,160 @@
+/**
+FNELEM-GPU THREAD POOL
+Thread pool used to run parallel loops.
+
+@package fnelem.math
+@author ppizarror
+@date 30/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include header
+#include "thread_pool.h"
+
+/**
+ * Constructor.
+ *
+ * @param nthreads Number of threads including the calling one, zero uses hardware concurrency
+ */
+ThreadPool::ThreadPool(int nthreads) {
+    if (nthreads < 0) {
+        throw std::logic_error("[THREAD-POOL] Number of threads cannot be negative");
+    }
+    if (nthreads == 0) {
+        nthreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    this->nthreads = nthreads;
+    this->workers.reserve(static_cast<unsigned long>(nthreads - 1));
+    for (int i = 1; i < nthreads; i++) {
+        this->workers.emplace_back(&ThreadPool::worker, this, i);
+    }
+}
+
+/**
+ * Destructor, waits for the workers.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->cv_start.notify_all();
+    for (auto &thread : this->workers) {
+        thread.join();
+    }
+}
+
+/**
+ * Worker loop, waits for a task and processes their chunk.
+ *
+ * @param id Thread number, chunk position
+ */
+void ThreadPool::worker(int id) {
+    long seen = 0;
+    int nthreads = this->nthreads;
+    while (true) {
+        const std::function<void(int, int)> *fn;
+        int n;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->cv_start.wait(lock, [&] { return this->stop || this->generation != seen; });
+            if (this->stop) return;
+            seen = this->generation;
+            fn = this->task;
+            n = this->task_n;
+        }
+
+        // Process chunk
+        std::exception_ptr err = nullptr;
+        try {
+            int begin = static_cast<int>(static_cast<long>(n) * id / nthreads);
+            int end = static_cast<int>(static_cast<long>(n) * (id + 1) / nthreads);
+            if (begin < end) (*fn)(begin, end);
+        } catch (...) {
+            err = std::current_exception();
+        }
+
+        // Notify
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            if (err != nullptr && this->error == nullptr) this->error = err;
+            this->pending -= 1;
+            if (this->pending == 0) this->cv_done.notify_one();
+        }
+    }
+}
+
+/**
+ * Return number of threads, including calling thread.
+ *
+ * @return
+ */
+int ThreadPool::get_threads() const {
+    return this->nthreads;
+}
+
+/**
+ * Apply function over chunks of [0, n), each thread receives one chunk. Blocks until all
+ * chunks are processed, if a chunk throws an exception it is thrown again.
+ *
+ * @param n Range length
+ * @param fn Function receiving the chunk range [begin, end)
+ */
+void ThreadPool::parallel_for(int n, const std::function<void(int, int)> &fn) {
+    int nthreads = this->nthreads;
+    if (nthreads == 1 || n < 2) {
+        if (n > 0) fn(0, n);
+        return;
+    }
+
+    // Start workers
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->task = &fn;
+        this->task_n = n;
+        this->pending = nthreads - 1;
+        this->error = nullptr;
+        this->generation += 1;
+    }
+    this->cv_start.notify_all();
+
+    // First chunk is processed by the calling thread
+    std::exception_ptr err = nullptr;
+    try {
+        int end = static_cast<int>(static_cast<long>(n) / nthreads);
+        if (end > 0) fn(0, end);
+    } catch (...) {
+        err = std::current_exception();
+    }
+
+    // Wait workers
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->cv_done.wait(lock, [&] { return this->pending == 0; });
+        this->task = nullptr;
+        if (err == nullptr) err = this->error;
+    }
+    if (err != nullptr) {
+        std::rethrow_exception(err);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+FNELEM-GPU THREAD POOL
+Thread pool used to run parallel loops.
+
+@package fnelem.math
+@author ppizarror
+@date 30/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Init header file
+#ifndef __FNELEM_MATH_THREAD_POOL_H
+#define __FNELEM_MATH_THREAD_POOL_H
+
+// Library imports
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed size thread pool performing fork-join parallel loops. The range of a loop is split
+ * in one chunk per thread, the calling thread processes the first chunk and waits for
+ * the workers. Threads are created once and are reused by every loop.
+ */
+class ThreadPool {
+private:
+
+    // Number of threads, including calling thread
+    int nthreads = 1;
+
+    // Worker threads, calling thread is not included
+    std::vector<std::thread> workers;
+
+    // Protects task data
+    std::mutex mutex;
+
+    // Notifies workers a new task is available
+    std::condition_variable cv_start;
+
+    // Notifies calling thread workers have finished
+    std::condition_variable cv_done;
+
+    // Current task, receives the chunk range [begin, end)
+    const std::function<void(int, int)> *task = nullptr;
+
+    // Task range length
+    int task_n = 0;
+
+    // Task number, used by workers to detect new tasks
+    long generation = 0;
+
+    // Number of workers processing the task
+    int pending = 0;
+
+    // First exception thrown by a worker
+    std::exception_ptr error = nullptr;
+
+    // Workers must finish
+    bool stop = false;
+
+    // Worker loop
+    void worker(int id);
+
+public:
+
+    // Constructor, zero threads uses hardware concurrency
+    explicit ThreadPool(int nthreads);
+
+    // Destructor
+    ~ThreadPool();
+
+    // Return number of threads, including calling thread
+    int get_threads() const;
+
+    // Apply fn over chunks of [0, n), blocks until all chunks are done
+    void parallel_for(int n, const std::function<void(int, int)> &fn);
+
+};
+
+#endif // __FNELEM_MATH_THREAD_POOL_H
\ No newline at end of file
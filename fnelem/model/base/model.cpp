@@ -74,6 +74,7 @@ void Model::initialize() {
  */
 void Model::add_nodes(std::vector<Node *> *node) {
     this->nodes = node;
+    this->revision += 1;
 }
 
 /**
@@ -92,6 +93,7 @@ std::vector<Node *> *Model::get_nodes() const {
  */
 void Model::add_elements(std::vector<Element *> *element) {
     this->elements = element;
+    this->revision += 1;
 }
 
 /**
@@ -109,6 +111,7 @@ std::vector<Element *> *Model::get_elements() const {
  */
 void Model::add_restraints(std::vector<Restraint *> *restraint) {
     this->restraints = restraint;
+    this->revision += 1;
 }
 
 /**
@@ -138,6 +141,23 @@ std::vector<LoadPattern *> *Model::get_load_patterns() const {
     return this->loadpatterns;
 }
 
+/**
+ * Notify elements, materials or restraints have changed. Analysis data computed from the
+ * model stiffness, as a factorization, must be computed again.
+ */
+void Model::invalidate() {
+    this->revision += 1;
+}
+
+/**
+ * Return number of changes of the model components.
+ *
+ * @return
+ */
+int Model::get_revision() const {
+    return this->revision;
+}
+
 /**
  * Apply model restraints.
  */
@@ -156,6 +176,30 @@ void Model::apply_load_patterns() const {
     }
 }
 
+/**
+ * Apply a single load pattern, used to solve load patterns as independent load cases.
+ *
+ * @param i Load pattern position
+ */
+void Model::apply_load_pattern(int i) const {
+    if (i < 0 || i >= static_cast<int>(this->loadpatterns->size())) {
+        throw std::logic_error("[MODEL] Load pattern position overflow");
+    }
+    this->loadpatterns->at(static_cast<unsigned long>(i))->apply();
+}
+
+/**
+ * Remove applied loads, node reactions and element equivalent forces are set to zero.
+ */
+void Model::reset_loads() const {
+    for (auto &node : *this->nodes) {
+        node->reset_reactions();
+    }
+    for (auto &element : *this->elements) {
+        element->reset_equivalent_force();
+    }
+}
+
 /**
  * Update model after solve is done, needs node displacements vector.
  *
@@ -66,6 +66,9 @@ private:
     // Load pattern vector
     std::vector<LoadPattern *> *loadpatterns = nullptr;
 
+    // Number of changes of the model components
+    int revision = 0;
+
     // Write title header to file
     void write_file_title(std::ofstream &plik, std::string title) const;
 
@@ -110,12 +113,24 @@ public:
     // Get load patterns
     std::vector<LoadPattern *> *get_load_patterns() const;
 
+    // Notify elements, materials or restraints have changed
+    void invalidate();
+
+    // Return number of changes of the model components
+    int get_revision() const;
+
     // Apply model restraints
     void apply_restraints() const;
 
     // Apply load patterns
     void apply_load_patterns() const;
 
+    // Apply a single load pattern
+    void apply_load_pattern(int i) const;
+
+    // Remove applied loads from nodes and elements
+    void reset_loads() const;
+
     // Update model components after solve method is done
     void update(FEMatrix *u);
 
@@ -88,6 +88,15 @@ FEMatrix *Element::get_dofid() const {
     return this->dofid->clone();
 }
 
+/**
+ * Get DOFID associated with the element, the storage of the given matrix is reused.
+ *
+ * @param dofid Matrix that stores the DOFID
+ */
+void Element::get_dofid(FEMatrix &dofid) const {
+    dofid = *this->dofid;
+}
+
 /**
  * Get local stiffness matrix.
  *
@@ -106,6 +115,15 @@ FEMatrix *Element::get_stiffness_global() const {
     return this->stiffness_global->clone();
 }
 
+/**
+ * Get global stiffness matrix, the storage of the given matrix is reused.
+ *
+ * @param stiffness Matrix that stores the stiffness
+ */
+void Element::get_stiffness_global(FEMatrix &stiffness) const {
+    stiffness = *this->stiffness_global;
+}
+
 /**
  * Get local resistant force.
  *
@@ -82,12 +82,18 @@ public:
     // Get ID degrees of freedom associated with the element
     FEMatrix *get_dofid() const;
 
+    // Get ID degrees of freedom, stored in a given matrix
+    void get_dofid(FEMatrix &dofid) const;
+
     // Get local stiffness matrix
     FEMatrix *get_stiffness_local() const;
 
     // Get global stiffness matrix
     FEMatrix *get_stiffness_global() const;
 
+    // Get global stiffness matrix, stored in a given matrix
+    void get_stiffness_global(FEMatrix &stiffness) const;
+
     // Get local resistant force
     virtual FEMatrix *get_force_local() const;
 
@@ -109,6 +115,9 @@ public:
     // Add resistant force to reaction
     virtual void add_force_to_reaction() {};
 
+    // Set equivalent forces of applied loads to zero
+    virtual void reset_equivalent_force() {};
+
     // Update element after analysis
     virtual void update() {};
 
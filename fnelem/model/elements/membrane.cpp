@@ -66,12 +66,7 @@ Membrane::Membrane(std::string tag, Node *n1, Node *n2, Node *n3, Node *n4,
 
     // Generate constitutive matrix
     this->constitutive = new FEMatrix(3, 3);
-    this->constitutive->set(0, 0, 1 / (1 - poisson * poisson));
-    this->constitutive->set(0, 1, poisson / (1 - poisson * poisson));
-    this->constitutive->set(1, 0, poisson / (1 - poisson * poisson));
-    this->constitutive->set(1, 1, 1 / (1 - poisson * poisson));
-    this->constitutive->set(2, 2, 1 / (2 + 2 * poisson));
-    (*this->constitutive) *= this->E;
+    this->generate_constitutive();
 
     // Calculates dimension
     //     4 ------------- 3
@@ -141,75 +136,134 @@ double Membrane::get_height() const {
     return 2 * this->h;
 }
 
+/**
+ * Return thickness of the section.
+ *
+ * @return
+ */
+double Membrane::get_thickness() const {
+    return this->t;
+}
+
+/**
+ * Return elasticity modulus of the section.
+ *
+ * @return
+ */
+double Membrane::get_elasticity() const {
+    return this->E;
+}
+
+/**
+ * Update thickness of the section, stiffness matrices are computed again.
+ *
+ * @param thickness Thickness of the section
+ */
+void Membrane::set_thickness(double thickness) {
+    if (thickness <= 0) {
+        throw std::logic_error("[MEMBRANE] Thickness must be greater than zero");
+    }
+    this->t = thickness;
+    this->generate_local_stiffness();
+    this->generate_global_stiffness();
+}
+
+/**
+ * Update elasticity modulus of the section, constitutive and stiffness matrices are
+ * computed again.
+ *
+ * @param E Elasticity modulus of the section
+ */
+void Membrane::set_elasticity(double E) {
+    if (E <= 0) {
+        throw std::logic_error("[MEMBRANE] Elasticity modulus must be greater than zero");
+    }
+    this->E = E;
+    this->generate_constitutive();
+    this->generate_local_stiffness();
+    this->generate_global_stiffness();
+}
+
+/**
+ * Calculate constitutive matrix, plane stress.
+ */
+void Membrane::generate_constitutive() {
+    double poisson = this->poisson;
+    this->D.fill_zeros();
+    this->D.set(0, 0, 1 / (1 - poisson * poisson));
+    this->D.set(0, 1, poisson / (1 - poisson * poisson));
+    this->D.set(1, 0, poisson / (1 - poisson * poisson));
+    this->D.set(1, 1, 1 / (1 - poisson * poisson));
+    this->D.set(2, 2, 1 / (2 + 2 * poisson));
+    this->D *= this->E;
+    this->D.to_fematrix(*this->constitutive);
+}
+
 /**
  * Calculate local stiffness matrix
  */
 void Membrane::generate_local_stiffness() {
 
     // Init A-vector
-    FEMatrix *A = FEMatrix_vector(6);
-    A->set_origin(1);
+    FixedMatrix<6, 1> A;
 
     // Calculate constitutive relationship
-    A->set(1, (this->t * this->h * this->constitutive->get(0, 0)) / (6 * this->b));
-    A->set(2, (this->t * this->b * this->constitutive->get(1, 1)) / (6 * this->h));
-    A->set(3, (this->t * this->constitutive->get(0, 1)) / 4);
-    A->set(4, (this->t * this->b * this->constitutive->get(2, 2)) / (6 * this->h));
-    A->set(5, (this->t * this->h * this->constitutive->get(2, 2)) / (6 * this->b));
-    A->set(6, (this->t * this->constitutive->get(2, 2)) / 4);
-
-    // Generates local stiffness matrix
-    this->stiffness_local->set_origin(1);
-    this->stiffness_local->set(1, 1, 2 * this->k_aij(A, 1, 4));
-    this->stiffness_local->set(1, 2, this->k_aij(A, 3, 6));
-    this->stiffness_local->set(1, 3, this->k_cij(A, 4, 1));
-    this->stiffness_local->set(1, 4, this->k_bij(A, 3, 6));
-    this->stiffness_local->set(1, 5, -this->k_aij(A, 1, 4));
-    this->stiffness_local->set(1, 6, -this->k_aij(A, 3, 6));
-    this->stiffness_local->set(1, 7, this->k_cij(A, 1, 4));
-    this->stiffness_local->set(1, 8, this->k_bij(A, 6, 3));
-
-    this->stiffness_local->set(2, 2, 2 * this->k_aij(A, 2, 4));
-    this->stiffness_local->set(2, 3, this->k_bij(A, 6, 3));
-    this->stiffness_local->set(2, 4, this->k_cij(A, 2, 5));
-    this->stiffness_local->set(2, 5, -this->k_aij(A, 3, 6));
-    this->stiffness_local->set(2, 6, -this->k_aij(A, 2, 5));
-    this->stiffness_local->set(2, 7, this->k_bij(A, 3, 6));
-    this->stiffness_local->set(2, 8, this->k_cij(A, 5, 2));
-
-    this->stiffness_local->set(3, 3, 2 * this->k_aij(A, 1, 4));
-    this->stiffness_local->set(3, 4, -this->k_aij(A, 3, 6));
-    this->stiffness_local->set(3, 5, this->k_cij(A, 1, 4));
-    this->stiffness_local->set(3, 6, this->k_bij(A, 3, 6));
-    this->stiffness_local->set(3, 7, -this->k_aij(A, 1, 4));
-    this->stiffness_local->set(3, 8, this->k_aij(A, 6, 3));
-
-    this->stiffness_local->set(4, 4, 2 * this->k_aij(A, 2, 4));
-    this->stiffness_local->set(4, 5, this->k_bij(A, 6, 3));
-    this->stiffness_local->set(4, 6, this->k_cij(A, 5, 2));
-    this->stiffness_local->set(4, 7, this->k_aij(A, 3, 6));
-    this->stiffness_local->set(4, 8, -this->k_aij(A, 5, 2));
-
-    this->stiffness_local->set(5, 5, 2 * this->k_aij(A, 1, 4));
-    this->stiffness_local->set(5, 6, this->k_aij(A, 3, 6));
-    this->stiffness_local->set(5, 7, this->k_cij(A, 4, 1));
-    this->stiffness_local->set(5, 8, -this->k_bij(A, 6, 3));
-
-    this->stiffness_local->set(6, 6, 2 * this->k_aij(A, 2, 4));
-    this->stiffness_local->set(6, 7, this->k_bij(A, 6, 3));
-    this->stiffness_local->set(6, 8, this->k_cij(A, 2, 5));
-
-    this->stiffness_local->set(7, 7, 2 * this->k_aij(A, 1, 4));
-    this->stiffness_local->set(7, 8, -this->k_aij(A, 3, 6));
-
-    this->stiffness_local->set(8, 8, 2 * this->k_aij(A, 2, 4));
+    A.set(0, (this->t * this->h * this->D(0, 0)) / (6 * this->b));
+    A.set(1, (this->t * this->b * this->D(1, 1)) / (6 * this->h));
+    A.set(2, (this->t * this->D(0, 1)) / 4);
+    A.set(3, (this->t * this->b * this->D(2, 2)) / (6 * this->h));
+    A.set(4, (this->t * this->h * this->D(2, 2)) / (6 * this->b));
+    A.set(5, (this->t * this->D(2, 2)) / 4);
+
+    // Generates local stiffness matrix, upper triangle
+    this->K.fill_zeros();
+    this->K.set(0, 0, 2 * this->k_aij(A, 1, 4));
+    this->K.set(0, 1, this->k_aij(A, 3, 6));
+    this->K.set(0, 2, this->k_cij(A, 4, 1));
+    this->K.set(0, 3, this->k_bij(A, 3, 6));
+    this->K.set(0, 4, -this->k_aij(A, 1, 4));
+    this->K.set(0, 5, -this->k_aij(A, 3, 6));
+    this->K.set(0, 6, this->k_cij(A, 1, 4));
+    this->K.set(0, 7, this->k_bij(A, 6, 3));
+
+    this->K.set(1, 1, 2 * this->k_aij(A, 2, 4));
+    this->K.set(1, 2, this->k_bij(A, 6, 3));
+    this->K.set(1, 3, this->k_cij(A, 2, 5));
+    this->K.set(1, 4, -this->k_aij(A, 3, 6));
+    this->K.set(1, 5, -this->k_aij(A, 2, 5));
+    this->K.set(1, 6, this->k_bij(A, 3, 6));
+    this->K.set(1, 7, this->k_cij(A, 5, 2));
+
+    this->K.set(2, 2, 2 * this->k_aij(A, 1, 4));
+    this->K.set(2, 3, -this->k_aij(A, 3, 6));
+    this->K.set(2, 4, this->k_cij(A, 1, 4));
+    this->K.set(2, 5, this->k_bij(A, 3, 6));
+    this->K.set(2, 6, -this->k_aij(A, 1, 4));
+    this->K.set(2, 7, this->k_aij(A, 6, 3));
+
+    this->K.set(3, 3, 2 * this->k_aij(A, 2, 4));
+    this->K.set(3, 4, this->k_bij(A, 6, 3));
+    this->K.set(3, 5, this->k_cij(A, 5, 2));
+    this->K.set(3, 6, this->k_aij(A, 3, 6));
+    this->K.set(3, 7, -this->k_aij(A, 5, 2));
+
+    this->K.set(4, 4, 2 * this->k_aij(A, 1, 4));
+    this->K.set(4, 5, this->k_aij(A, 3, 6));
+    this->K.set(4, 6, this->k_cij(A, 4, 1));
+    this->K.set(4, 7, -this->k_bij(A, 6, 3));
+
+    this->K.set(5, 5, 2 * this->k_aij(A, 2, 4));
+    this->K.set(5, 6, this->k_bij(A, 6, 3));
+    this->K.set(5, 7, this->k_cij(A, 2, 5));
+
+    this->K.set(6, 6, 2 * this->k_aij(A, 1, 4));
+    this->K.set(6, 7, -this->k_aij(A, 3, 6));
+
+    this->K.set(7, 7, 2 * this->k_aij(A, 2, 4));
 
     // Extends matrix transpose
-    this->stiffness_local->make_symmetric();
-    this->stiffness_local->set_origin(0);
-
-    // Variable deletion
-    delete A;
+    this->K.make_symmetric();
+    this->K.to_fematrix(*this->stiffness_local);
 
 }
 
@@ -219,7 +273,7 @@ void Membrane::generate_local_stiffness() {
 void Membrane::generate_global_stiffness() {
 
     // As membrane does not have any rotation local and global matrices are the same
-    (*this->stiffness_global) = this->stiffness_local;
+    (*this->stiffness_global) = *this->stiffness_local;
 
 }
 
@@ -227,36 +281,36 @@ void Membrane::generate_global_stiffness() {
  * Return Aij stiffness modifier.
  *
  * @param A Matrix
- * @param i Position-i
- * @param j Position-j
+ * @param i Position-i, starts from one
+ * @param j Position-j, starts from one
  * @return
  */
-double Membrane::k_aij(FEMatrix *A, int i, int j) const {
-    return A->get(i) + A->get(j);
+double Membrane::k_aij(const FixedMatrix<6, 1> &A, int i, int j) const {
+    return A.get(i - 1) + A.get(j - 1);
 }
 
 /**
  * Return Aij stiffness modifier.
  *
  * @param A Matrix
- * @param i Position-i
- * @param j Position-j
+ * @param i Position-i, starts from one
+ * @param j Position-j, starts from one
  * @return
  */
-double Membrane::k_bij(FEMatrix *A, int i, int j) const {
-    return A->get(i) - A->get(j);
+double Membrane::k_bij(const FixedMatrix<6, 1> &A, int i, int j) const {
+    return A.get(i - 1) - A.get(j - 1);
 }
 
 /**
  * Return Cij stiffness modifier.
  *
  * @param A Matrix
- * @param i Position-i
- * @param j Position-j
+ * @param i Position-i, starts from one
+ * @param j Position-j, starts from one
  * @return
  */
-double Membrane::k_cij(FEMatrix *A, int i, int j) const {
-    return A->get(i) - 2 * A->get(j);
+double Membrane::k_cij(const FixedMatrix<6, 1> &A, int i, int j) const {
+    return A.get(i - 1) - 2 * A.get(j - 1);
 }
 
 /**
@@ -354,16 +408,13 @@ void Membrane::validate_xy(double x, double y) const {
 }
 
 /**
- * Get displacement vector from (x,y) point inside membrane.
+ * Calculate displacement of (x,y) point inside membrane, N * d.
  *
  * @param x X-position
  * @param y Y-position
  * @return
  */
-FEMatrix *Membrane::get_displacement(double x, double y) const {
-
-    // Check point is valid
-    this->validate_xy(x, y);
+FixedMatrix<2, 1> Membrane::calculate_displacement(double x, double y) const {
 
     // Generate N matrix
     double N1 = (this->b - x) * (this->h - y) / (4 * this->b * this->h);
@@ -371,42 +422,78 @@ FEMatrix *Membrane::get_displacement(double x, double y) const {
     double N3 = (this->b + x) * (this->h + y) / (4 * this->b * this->h);
     double N4 = (this->b - x) * (this->h + y) / (4 * this->b * this->h);
 
-    FEMatrix *N = new FEMatrix(2, 8);
-    N->set(0, 0, N1);
-    N->set(0, 2, N2);
-    N->set(0, 4, N3);
-    N->set(0, 6, N4);
-    N->set(1, 1, N1);
-    N->set(1, 3, N2);
-    N->set(1, 5, N3);
-    N->set(1, 7, N4);
+    FixedMatrix<2, 8> N;
+    N.set(0, 0, N1);
+    N.set(0, 2, N2);
+    N.set(0, 4, N3);
+    N.set(0, 6, N4);
+    N.set(1, 1, N1);
+    N.set(1, 3, N2);
+    N.set(1, 5, N3);
+    N.set(1, 7, N4);
 
     // Get node displacements
-    Node *n1 = this->nodes->at(0);
-    Node *n2 = this->nodes->at(1);
-    Node *n3 = this->nodes->at(2);
-    Node *n4 = this->nodes->at(3);
-
-    FEMatrix *d = FEMatrix_vector(8);
-    d->set(0, n1->get_displacement(1));
-    d->set(1, n1->get_displacement(2));
-    d->set(2, n2->get_displacement(1));
-    d->set(3, n2->get_displacement(2));
-    d->set(4, n3->get_displacement(1));
-    d->set(5, n3->get_displacement(2));
-    d->set(6, n4->get_displacement(1));
-    d->set(7, n4->get_displacement(2));
+    FixedMatrix<8, 1> d;
+    this->generate_displacement_vector(d);
 
     // Calculates displacement; [2x8]x[8x1] = [2x1]
-    FEMatrix *dsp = (*N * *d);
+    return N * d;
 
-    // Delete data
-    delete N;
-    delete d;
+}
 
-    // Return matrix
-    return dsp;
+/**
+ * Get displacement vector from (x,y) point inside membrane.
+ *
+ * @param x X-position
+ * @param y Y-position
+ * @return
+ */
+FEMatrix *Membrane::get_displacement(double x, double y) const {
+    this->validate_xy(x, y);
+    return this->calculate_displacement(x, y).to_fematrix();
+}
 
+/**
+ * Store deformation matrix B of point (x,y), deformation is B * d.
+ *
+ * @param x X-position
+ * @param y Y-position
+ * @param B Deformation matrix [3x8]
+ */
+void Membrane::generate_deformation_matrix(double x, double y, FixedMatrix<3, 8> &B) const {
+    double a1 = (this->b + x) / (4 * this->b * this->h);
+    double a2 = (this->b - x) / (4 * this->b * this->h);
+    double a3 = (this->h + y) / (4 * this->b * this->h);
+    double a4 = (this->h - y) / (4 * this->b * this->h);
+    B.fill_zeros();
+    B.set(0, 0, -a4);
+    B.set(0, 2, a4);
+    B.set(0, 4, a3);
+    B.set(0, 6, -a3);
+    B.set(1, 1, -a2);
+    B.set(1, 3, -a1);
+    B.set(1, 5, a1);
+    B.set(1, 7, a2);
+    B.set(2, 0, -a2);
+    B.set(2, 1, -a4);
+    B.set(2, 2, -a1);
+    B.set(2, 3, a4);
+    B.set(2, 4, a1);
+    B.set(2, 5, a3);
+    B.set(2, 6, a2);
+    B.set(2, 7, -a3);
+}
+
+/**
+ * Store node displacements, ordered as the element DOFID.
+ *
+ * @param d Displacement vector [8x1]
+ */
+void Membrane::generate_displacement_vector(FixedMatrix<8, 1> &d) const {
+    for (int k = 0; k < 4; k++) {
+        d.set(2 * k, this->nodes->at(static_cast<unsigned long>(k))->get_displacement(1));
+        d.set(2 * k + 1, this->nodes->at(static_cast<unsigned long>(k))->get_displacement(2));
+    }
 }
 
 /**
@@ -422,55 +509,31 @@ FEMatrix *Membrane::get_deformation(double x, double y) const {
     this->validate_xy(x, y);
 
     // Generate B matrix
-    double a1 = (this->b + x) / (4 * this->b * this->h);
-    double a2 = (this->b - x) / (4 * this->b * this->h);
-    double a3 = (this->h + y) / (4 * this->b * this->h);
-    double a4 = (this->h - y) / (4 * this->b * this->h);
-
-    FEMatrix *B = new FEMatrix(3, 8);
-    B->set(0, 0, -a4);
-    B->set(0, 2, a4);
-    B->set(0, 4, a3);
-    B->set(0, 6, -a3);
-    B->set(1, 1, -a2);
-    B->set(1, 3, -a1);
-    B->set(1, 5, a1);
-    B->set(1, 7, a2);
-    B->set(2, 0, -a2);
-    B->set(2, 1, -a4);
-    B->set(2, 2, -a1);
-    B->set(2, 3, a4);
-    B->set(2, 4, a1);
-    B->set(2, 5, a3);
-    B->set(2, 6, a2);
-    B->set(2, 7, -a3);
+    FixedMatrix<3, 8> B;
+    this->generate_deformation_matrix(x, y, B);
 
     // Get node displacements
-    Node *n1 = this->nodes->at(0);
-    Node *n2 = this->nodes->at(1);
-    Node *n3 = this->nodes->at(2);
-    Node *n4 = this->nodes->at(3);
-
-    FEMatrix *d = FEMatrix_vector(8);
-    d->set(0, n1->get_displacement(1));
-    d->set(1, n1->get_displacement(2));
-    d->set(2, n2->get_displacement(1));
-    d->set(3, n2->get_displacement(2));
-    d->set(4, n3->get_displacement(1));
-    d->set(5, n3->get_displacement(2));
-    d->set(6, n4->get_displacement(1));
-    d->set(7, n4->get_displacement(2));
+    FixedMatrix<8, 1> d;
+    this->generate_displacement_vector(d);
 
     // Calculates deformation; [3x8]x[8x1] = [3x1]
-    FEMatrix *def = (*B * *d);
-
-    // Delete data
-    delete B;
-    delete d;
+    return (B * d).to_fematrix();
 
-    // Return matrix
-    return def;
+}
 
+/**
+ * Calculate stress of (x,y) point inside membrane, D * B * d.
+ *
+ * @param x X-position
+ * @param y Y-position
+ * @return
+ */
+FixedMatrix<3, 1> Membrane::calculate_stress(double x, double y) const {
+    FixedMatrix<3, 8> B;
+    this->generate_deformation_matrix(x, y, B);
+    FixedMatrix<8, 1> d;
+    this->generate_displacement_vector(d);
+    return this->D * (B * d); // [3x3]x[3x8]x[8x1] = [3x1]
 }
 
 /**
@@ -481,10 +544,8 @@ FEMatrix *Membrane::get_deformation(double x, double y) const {
  * @return
  */
 FEMatrix *Membrane::get_stress(double x, double y) const {
-    FEMatrix *def = this->get_deformation(x, y);
-    FEMatrix *stress = *this->constitutive * *def; // [3x3]x[3x1] = [3x1]
-    delete def;
-    return stress;
+    this->validate_xy(x, y);
+    return this->calculate_stress(x, y).to_fematrix();
 }
 
 /**
@@ -495,27 +556,11 @@ FEMatrix *Membrane::get_stress(double x, double y) const {
 FEMatrix *Membrane::get_force_local() const {
 
     // Get node displacements
-    Node *n1 = this->nodes->at(0);
-    Node *n2 = this->nodes->at(1);
-    Node *n3 = this->nodes->at(2);
-    Node *n4 = this->nodes->at(3);
-
-    FEMatrix *d = FEMatrix_vector(8);
-    d->set(0, n1->get_displacement(1));
-    d->set(1, n1->get_displacement(2));
-    d->set(2, n2->get_displacement(1));
-    d->set(3, n2->get_displacement(2));
-    d->set(4, n3->get_displacement(1));
-    d->set(5, n3->get_displacement(2));
-    d->set(6, n4->get_displacement(1));
-    d->set(7, n4->get_displacement(2));
+    FixedMatrix<8, 1> d;
+    this->generate_displacement_vector(d);
 
     // Calculate force by multiplication with local stiffness matrix
-    FEMatrix *fr_local = (*this->stiffness_local * *d);
-    delete d;
-
-    // Return matrix
-    return fr_local;
+    return (this->K * d).to_fematrix();
 
 }
 
@@ -552,6 +597,13 @@ void Membrane::add_equivalent_force_node(int nodenum, FEMatrix *f) {
     f->enable_origin();
 }
 
+/**
+ * Set equivalent forces to zero.
+ */
+void Membrane::reset_equivalent_force() {
+    this->Feq->fill_zeros();
+}
+
 /**
  * Add resistant force to reaction.
  */
@@ -667,19 +719,16 @@ FEMatrix *Membrane::generate_stress_npoints_matrix() const {
             y = -this->h + (j - 1) * dy;
 
             // Calculate tension
-            FEMatrix *stress = this->get_stress(x, y);
+            FixedMatrix<3, 1> stress = this->calculate_stress(x, y);
 
             // Stores to matrix
             tvec->set(k, 0, cglobx + x + this->b);
             tvec->set(k, 1, cgloby + y + this->h);
             tvec->set(k, 2, x);
             tvec->set(k, 3, y);
-            tvec->set(k, 4, stress->get(0));
-            tvec->set(k, 5, stress->get(1));
-            tvec->set(k, 6, stress->get(2));
-
-            // Deletes matrix
-            delete stress;
+            tvec->set(k, 4, stress.get(0));
+            tvec->set(k, 5, stress.get(1));
+            tvec->set(k, 6, stress.get(2));
             k += 1;
 
         }
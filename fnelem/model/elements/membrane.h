@@ -34,6 +34,7 @@ Bidimensional membrane element composed by 4 nodes.
 
 // Libray imports
 #include "element.h"
+#include "../../math/fixed_matrix.h"
 
 class Membrane : public Element {
 private:
@@ -56,6 +57,15 @@ private:
     // Equivalent node forces
     FEMatrix *Feq;
 
+    // Constitutive matrix used by the element kernels
+    FixedMatrix<3, 3> D;
+
+    // Local stiffness matrix used by the element kernels
+    FixedMatrix<8, 8> K;
+
+    // Calculate constitutive matrix
+    void generate_constitutive();
+
     // Calculate local stiffness matrix
     void generate_local_stiffness();
 
@@ -63,17 +73,29 @@ private:
     void generate_global_stiffness();
 
     // Calculate Aij stiffness value
-    double k_aij(FEMatrix *A, int i, int j) const;
+    double k_aij(const FixedMatrix<6, 1> &A, int i, int j) const;
 
     // Calculate Bij stiffness value
-    double k_bij(FEMatrix *A, int i, int j) const;
+    double k_bij(const FixedMatrix<6, 1> &A, int i, int j) const;
 
     // Calculate Cij stiffness value
-    double k_cij(FEMatrix *A, int i, int j) const;
+    double k_cij(const FixedMatrix<6, 1> &A, int i, int j) const;
 
     // Validate (x,y) point to perform stress/deformation analysis
     void validate_xy(double x, double y) const;
 
+    // Store node displacements in d [8x1]
+    void generate_displacement_vector(FixedMatrix<8, 1> &d) const;
+
+    // Store deformation matrix of point (x,y) in B [3x8]
+    void generate_deformation_matrix(double x, double y, FixedMatrix<3, 8> &B) const;
+
+    // Calculate stress of point (x,y)
+    FixedMatrix<3, 1> calculate_stress(double x, double y) const;
+
+    // Calculate displacement of point (x,y)
+    FixedMatrix<2, 1> calculate_displacement(double x, double y) const;
+
     // Generate stress vector
     FEMatrix *generate_stress_npoints_matrix() const;
 
@@ -92,6 +114,18 @@ public:
     // Return membrane height
     double get_height() const;
 
+    // Return thickness of the section
+    double get_thickness() const;
+
+    // Return elasticity modulus of the section
+    double get_elasticity() const;
+
+    // Update thickness of the section
+    void set_thickness(double thickness);
+
+    // Update elasticity modulus of the section
+    void set_elasticity(double E);
+
     // Display membrane information
     void disp() const override;
 
@@ -116,6 +150,9 @@ public:
     // Add equivalent force to internal forces
     void add_equivalent_force_node(int nodenum, FEMatrix *f);
 
+    // Set equivalent forces to zero
+    void reset_equivalent_force() override;
+
     // Add resistant force to reaction
     void add_force_to_reaction() override;
 
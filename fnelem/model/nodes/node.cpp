@@ -259,6 +259,13 @@ void Node::apply_load(FEMatrix *load) {
     (*this->reaction) -= *load;
 }
 
+/**
+ * Set node reactions to zero, removes loads and element stresses applied to the node.
+ */
+void Node::reset_reactions() {
+    this->reaction->fill_zeros();
+}
+
 /**
  * Apply element inner stress to node reactions.
  *
@@ -35,11 +35,31 @@ was calculated using a CUDA algorithm (Gauss Jordan inversion).
 #include <vector>
 
 // FNELEM library imports
+#include "fnelem/math/amg.cpp"
+#include "fnelem/math/condition_estimate.cpp"
+#include "fnelem/math/element_operator.cpp"
 #include "fnelem/math/fematrix.cpp"
+#include "fnelem/math/fematrix_factorization.cpp"
+#include "fnelem/math/fematrix_gemm.cpp"
+#include "fnelem/math/fematrix_skyline.cpp"
+#include "fnelem/math/fematrix_sparse.cpp"
 #include "fnelem/math/fematrix_utils.cpp"
+#include "fnelem/math/gmg.cpp"
+#include "fnelem/math/low_rank_update.cpp"
 #include "fnelem/math/matrix_inversion_cpu.cpp"
+#include "fnelem/math/matrix_inversion_threaded.cpp"
+#include "fnelem/math/matrix_ordering.cpp"
+#include "fnelem/math/mixed_precision.cpp"
+#include "fnelem/math/multigrid.cpp"
+#include "fnelem/math/out_of_core_skyline.cpp"
+#include "fnelem/math/pcg.cpp"
+#include "fnelem/math/schur_solver.cpp"
+#include "fnelem/math/sparse_ldl.cpp"
+#include "fnelem/math/thread_pool.cpp"
 #include "fnelem/math/matrix_inversion_cuda.cu"
 
+#include "fnelem/analysis/solver_cost_model.cpp"
+#include "fnelem/analysis/solver_registry.cpp"
 #include "fnelem/analysis/static_analysis.cpp"
 #include "fnelem/model/base/model.cpp"
 #include "fnelem/model/base/model_component.cpp"
@@ -29,9 +29,13 @@ Test analysis package.
 */
 
 // Include sources
+#include "test_solver_cost_model.h"
+#include "test_solver_registry.h"
 #include "test_static_analysis.h"
 
 int main() {
+    test_solver_cost_model_suite();
+    test_solver_registry_suite();
     test_static_analysis_suite();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+/**
+FNELEM-GPU - TEST SOLVER COST MODEL
+Test automatic solver selection.
+
+@package test.analysis
+@author ppizarror
+@date 03/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/analysis/solver_cost_model.h"
+
+/**
+ * Creates lower triangle pattern of a m x m grid, five point stencil.
+ *
+ * @param m Grid size
+ * @return
+ */
+std::vector<std::vector<int>> *__test_solver_cost_model_grid(int m) {
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(static_cast<unsigned long>(m * m));
+    for (int i = 0; i < m * m; i++) {
+        if (i >= m) pattern->at(i).push_back(i - m);
+        if (i % m != 0) pattern->at(i).push_back(i - 1);
+        pattern->at(i).push_back(i);
+    }
+    return pattern;
+}
+
+void __test_solver_cost_model_selection() {
+    test_print_title("SOLVER-COST-MODEL", "test_solver_cost_model_selection");
+    SolverCostModel *model = new SolverCostModel();
+    model->set_memory_limit(1L << 34); // 16 GB, independent of the machine
+
+    // Selection requires the estimates
+    bool error = false;
+    try {
+        model->select();
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+
+    // Small full matrix uses dense factorization
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(10);
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j <= i; j++) {
+            pattern->at(i).push_back(j);
+        }
+    }
+    model->estimate(10, pattern, 100, 1);
+    assert(model->select() == "dense");
+    assert(model->get_factor_nnz() == 45);
+    delete pattern;
+
+    // Banded matrix uses skyline factorization
+    pattern = new std::vector<std::vector<int>>(5000);
+    for (int i = 0; i < 5000; i++) {
+        for (int j = std::max(0, i - 3); j <= i; j++) {
+            pattern->at(i).push_back(j);
+        }
+    }
+    model->estimate(5000, pattern, 5000 * 16, 1);
+    assert(model->select() == "skyline");
+    assert(model->get_flops("skyline") <= model->get_flops("ldl"));
+    delete pattern;
+
+    // Large envelope without fill-in uses sparse LDL'
+    pattern = new std::vector<std::vector<int>>(5000);
+    for (int i = 0; i < 5000; i++) {
+        if (i == 4999) {
+            for (int j = 0; j < i; j++) {
+                pattern->at(i).push_back(j);
+            }
+        }
+        pattern->at(i).push_back(i);
+    }
+    model->estimate(5000, pattern, 5000, 1);
+    assert(model->select() == "ldl");
+    assert(model->get_factor_nnz() == 4999);
+    delete pattern;
+
+    // Huge grid uses multigrid, if memory is small the Jacobi preconditioner is used
+    pattern = __test_solver_cost_model_grid(300);
+    model->estimate(90000, pattern, 90000 * 16, 1);
+    assert(model->select() == "amg");
+    model->set_memory_limit(static_cast<long>(model->get_memory("pcg")) + 1);
+    assert(model->get_selected().empty());
+    model->estimate(90000, pattern, 90000 * 16, 1);
+    assert(model->select() == "pcg");
+    assert(model->get_memory("pcg") < model->get_memory("amg"));
+    model->disp();
+
+    // Nothing fits, lowest memory is used
+    model->set_memory_limit(1024);
+    model->estimate(90000, pattern, 90000 * 16, 1);
+    assert(model->select() == "pcg");
+    assert(model->get_reason().find("no solver fits") != std::string::npos);
+    std::cout << model->get_reason() << std::endl;
+    delete pattern;
+
+    // GPU candidate
+    model->set_cuda(true);
+    pattern = __test_solver_cost_model_grid(4);
+    model->estimate(16, pattern, 16 * 16, 1);
+    assert(model->get_flops("cuda") > 0);
+    delete pattern;
+
+    // Invalid data
+    error = false;
+    try {
+        model->set_memory_limit(-1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    assert(SolverCostModel::get_available_memory() >= 0);
+    (void) error;
+
+    // Delete data
+    delete model;
+}
+
+/**
+ * Performs TEST-SOLVER-COST-MODEL suite.
+ */
+void test_solver_cost_model_suite() {
+    __test_solver_cost_model_selection();
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+FNELEM-GPU - TEST SOLVER REGISTRY
+Test solver backend registry.
+
+@package test.analysis
+@author ppizarror
+@date 02/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/analysis/solver_registry.h"
+
+void __test_solver_registry_backends() {
+    test_print_title("SOLVER-REGISTRY", "test_solver_registry_backends");
+
+    // Register backends
+    SolverRegistry *registry = new SolverRegistry();
+    int calls = 0;
+    registry->add("first", "First backend", true, [&calls](bool cached) {
+        calls += 1;
+        return std::string(cached ? "[CACHED]" : "");
+    });
+    registry->add("second", "Second backend", false, [](bool /* cached */) {
+        throw std::logic_error("[TEST] Backend failed");
+        return std::string();
+    });
+    assert(registry->get_number_backends() == 2);
+    assert(registry->has("first"));
+    assert(!registry->has("third"));
+    assert(registry->get_names()[1] == "second");
+    assert(registry->get_description("first") == "First backend");
+    assert(registry->requires_stiffness("first"));
+    assert(!registry->requires_stiffness("second"));
+
+    // Solve stores the time of each backend
+    assert(registry->get_runs("first") == 0);
+    assert(registry->get_last_time("first") == -1);
+    assert(registry->solve("first", false).empty());
+    assert(registry->solve("first", true) == "[CACHED]");
+    assert(calls == 2);
+    assert(registry->get_runs("first") == 2);
+    assert(registry->get_last_time("first") >= 0);
+    assert(registry->get_total_time("first") >= registry->get_last_time("first"));
+    registry->disp();
+
+    // Failed solutions are not counted
+    bool error = false;
+    try {
+        registry->solve("second", false);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    assert(registry->get_runs("second") == 0);
+
+    // Reset time
+    registry->reset_timing();
+    assert(registry->get_runs("first") == 0);
+    assert(registry->get_total_time("first") == 0);
+
+    // Duplicated and unknown backends
+    error = false;
+    try {
+        registry->add("first", "Duplicated", true, [](bool /* cached */) { return std::string(); });
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    error = false;
+    try {
+        registry->solve("third", false);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete registry;
+}
+
+/**
+ * Performs TEST-SOLVER-REGISTRY suite.
+ */
+void test_solver_registry_suite() {
+    __test_solver_registry_backends();
+}
\ No newline at end of file
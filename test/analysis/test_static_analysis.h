@@ -114,7 +114,7 @@ void __test_static_analysis_test() {
     assert(analysis->get_stiffness_matrix() == nullptr);
 
     // Run analysis
-    analysis->analyze(false);
+    analysis->analyze();
     analysis->disp();
 
     // Save results to file
@@ -196,7 +196,7 @@ void __test_building() {
     // n1 ------------ n2
     unsigned long n1, n2, n3, n4;
     std::vector<Element *> *elements = new std::vector<Element *>();
-    for (unsigned long i = 0; i < N; i++) {
+    for (unsigned long i = 0; i < static_cast<unsigned long>(N); i++) {
         n1 = i;
         n2 = N + i + 1;
         n3 = N + i + 2;
@@ -227,7 +227,7 @@ void __test_building() {
 
     // Create analysis
     StaticAnalysis *analysis = new StaticAnalysis(model);
-    analysis->analyze(false);
+    analysis->analyze();
 
     // Save results to file
     model->save_results("out/test-static-building-" + std::to_string(N));
@@ -260,6 +260,7 @@ void __test_bridge() {
         N = N + x;
     }
     infile.close();
+    if (N <= 0) N = 3; // Default number of piers if the file is missing
     std::cout << "Test bridge, number of piers: " << N << std::endl;
 
     int b = 100; // Pier width
@@ -314,7 +315,7 @@ void __test_bridge() {
     // n1 ------------ n2
     unsigned long n1, n2, n3, n4;
     std::vector<Element *> *elements = new std::vector<Element *>();
-    for (unsigned long i = 0; i < N; i++) {
+    for (unsigned long i = 0; i < static_cast<unsigned long>(N); i++) {
         n1 = i;
         n2 = i + 1;
         n3 = N + i + 2;
@@ -336,7 +337,7 @@ void __test_bridge() {
 
     // Add distribuited load
     std::vector<Load *> *loads = new std::vector<Load *>();
-    for (int i = 0; i < elements->size(); i++) {
+    for (int i = 0; i < static_cast<int>(elements->size()); i++) {
         Membrane *mem = dynamic_cast<Membrane *>(elements->at(static_cast<unsigned long>(i)));
         loads->push_back(
                 new LoadMembraneDistributed("DV100kN V @" + std::to_string(i + 1), mem, 4, 3, -100, 0, -100, 1));
@@ -347,7 +348,7 @@ void __test_bridge() {
 
     // Create analysis
     StaticAnalysis *analysis = new StaticAnalysis(model);
-    analysis->analyze(false);
+    analysis->analyze();
 
     // Save results to file
     model->save_results("out/test-static-bridge-" + std::to_string(N));
@@ -363,6 +364,1202 @@ void __test_bridge() {
     delete analysis;
 }
 
+/**
+ * Creates a wall model of nx*ny membranes, base nodes are fixed and a horizontal load is
+ * applied at the top-left node.
+ *
+ * @param nx Number of membranes along x
+ * @param ny Number of membranes along y
+ * @param skew Horizontal offset of each row of nodes, non zero values create parallelograms
+ * @return
+ */
+Model *__test_static_analysis_wall(int nx, int ny, double skew = 0) {
+    double b = 100; // Membrane width
+    double h = 100; // Membrane height
+    double t = 15; // Thickness (cm)
+    double E = 300000; // Elastic modulus
+    double nu = 0.15; // Poisson modulus
+
+    // Create model
+    Model *model = new Model(2, 2 * (nx + 1) * ny);
+
+    // Create nodes, row by row
+    std::vector<Node *> *nodes = new std::vector<Node *>();
+    for (int j = 0; j <= ny; j++) {
+        for (int i = 0; i <= nx; i++) {
+            nodes->push_back(new Node("N" + std::to_string(j * (nx + 1) + i + 1), b * i + skew * j, h * j));
+        }
+    }
+    model->add_nodes(nodes);
+
+    // Create elements
+    std::vector<Element *> *elements = new std::vector<Element *>();
+    unsigned long n1;
+    for (int j = 0; j < ny; j++) {
+        for (int i = 0; i < nx; i++) {
+            n1 = static_cast<unsigned long>(j * (nx + 1) + i);
+            elements->push_back(new Membrane("MEM" + std::to_string(elements->size() + 1), nodes->at(n1),
+                                             nodes->at(n1 + 1), nodes->at(n1 + nx + 2), nodes->at(n1 + nx + 1),
+                                             E, nu, t));
+        }
+    }
+    model->add_elements(elements);
+
+    // Create restraints
+    std::vector<Restraint *> *restraints = new std::vector<Restraint *>();
+    for (int i = 0; i <= nx; i++) {
+        RestraintNode *r = new RestraintNode("R" + std::to_string(i + 1), nodes->at(i));
+        r->add_all();
+        restraints->push_back(r);
+    }
+    model->add_restraints(restraints);
+
+    // Add load
+    std::vector<Load *> *loads = new std::vector<Load *>();
+    FEMatrix *loadv = FEMatrix_vector(2);
+    loadv->set(0, 1000);
+    loadv->set(1, -500);
+    loads->push_back(new LoadNode("NL1000kN", nodes->at(static_cast<unsigned long>(ny * (nx + 1))), loadv));
+    std::vector<LoadPattern *> *loadpattern = new std::vector<LoadPattern *>();
+    loadpattern->push_back(new LoadPatternConstant("LOADCONSTANT", loads));
+    model->add_load_patterns(loadpattern);
+    delete loadv;
+
+    return model;
+}
+
+/**
+ * Creates a bridge deck of n membranes in a single row, as in the bridge test. The end
+ * nodes of the bottom chord are fixed and every membrane has a distributed vertical load
+ * at its top side. Nodes are numbered along the bottom chord and then along the top chord.
+ *
+ * @param n Number of membranes
+ * @return
+ */
+Model *__test_static_analysis_bridge(int n) {
+    double b = 100; // Membrane width
+    double h = 100; // Membrane height
+    double t = 15; // Thickness (cm)
+    double E = 300000; // Elastic modulus
+    double nu = 0.15; // Poisson modulus
+
+    // Create model
+    Model *model = new Model(2, 4 * n);
+
+    // Create nodes, bottom and top chord
+    std::vector<Node *> *nodes = new std::vector<Node *>();
+    for (int i = 0; i <= n; i++) {
+        nodes->push_back(new Node("N" + std::to_string(i + 1), b * i, 0));
+    }
+    for (int i = 0; i <= n; i++) {
+        nodes->push_back(new Node("N" + std::to_string(n + i + 2), b * i, h));
+    }
+    model->add_nodes(nodes);
+
+    // Create elements
+    std::vector<Element *> *elements = new std::vector<Element *>();
+    unsigned long n1;
+    for (int i = 0; i < n; i++) {
+        n1 = static_cast<unsigned long>(i);
+        elements->push_back(new Membrane("MEM" + std::to_string(i + 1), nodes->at(n1), nodes->at(n1 + 1),
+                                         nodes->at(n1 + n + 2), nodes->at(n1 + n + 1), E, nu, t));
+    }
+    model->add_elements(elements);
+
+    // Create restraints
+    std::vector<Restraint *> *restraints = new std::vector<Restraint *>();
+    RestraintNode *r1 = new RestraintNode("R1", nodes->at(0));
+    RestraintNode *r2 = new RestraintNode("R2", nodes->at(static_cast<unsigned long>(n)));
+    r1->add_all();
+    r2->add_all();
+    restraints->push_back(r1);
+    restraints->push_back(r2);
+    model->add_restraints(restraints);
+
+    // Add distributed load
+    std::vector<Load *> *loads = new std::vector<Load *>();
+    for (int i = 0; i < n; i++) {
+        Membrane *mem = dynamic_cast<Membrane *>(elements->at(static_cast<unsigned long>(i)));
+        loads->push_back(new LoadMembraneDistributed("DV100kN V @" + std::to_string(i + 1), mem, 4, 3, -100, 0,
+                                                     -100, 1));
+    }
+    std::vector<LoadPattern *> *loadpattern = new std::vector<LoadPattern *>();
+    loadpattern->push_back(new LoadPatternConstant("LOADCONSTANT", loads));
+    model->add_load_patterns(loadpattern);
+
+    return model;
+}
+
+/**
+ * Creates a building of several stories and bays, as in the building test. Each story is a
+ * row of membranes of the bay width and the story height, base nodes are fixed and each
+ * floor has a horizontal load at the left node that grows with the height.
+ *
+ * @param stories Number of stories
+ * @param bays Number of bays
+ * @return
+ */
+Model *__test_static_analysis_building(int stories, int bays) {
+    double b = 500; // Bay width
+    double h = 300; // Story height
+    double t = 20; // Thickness (cm)
+    double E = 300000; // Elastic modulus
+    double nu = 0.15; // Poisson modulus
+
+    // Create model
+    Model *model = new Model(2, 2 * (bays + 1) * stories);
+
+    // Create nodes, floor by floor
+    std::vector<Node *> *nodes = new std::vector<Node *>();
+    for (int j = 0; j <= stories; j++) {
+        for (int i = 0; i <= bays; i++) {
+            nodes->push_back(new Node("N" + std::to_string(j * (bays + 1) + i + 1), b * i, h * j));
+        }
+    }
+    model->add_nodes(nodes);
+
+    // Create elements
+    std::vector<Element *> *elements = new std::vector<Element *>();
+    unsigned long n1;
+    for (int j = 0; j < stories; j++) {
+        for (int i = 0; i < bays; i++) {
+            n1 = static_cast<unsigned long>(j * (bays + 1) + i);
+            elements->push_back(new Membrane("MEM" + std::to_string(elements->size() + 1), nodes->at(n1),
+                                             nodes->at(n1 + 1), nodes->at(n1 + bays + 2), nodes->at(n1 + bays + 1),
+                                             E, nu, t));
+        }
+    }
+    model->add_elements(elements);
+
+    // Create restraints
+    std::vector<Restraint *> *restraints = new std::vector<Restraint *>();
+    for (int i = 0; i <= bays; i++) {
+        RestraintNode *r = new RestraintNode("R" + std::to_string(i + 1), nodes->at(static_cast<unsigned long>(i)));
+        r->add_all();
+        restraints->push_back(r);
+    }
+    model->add_restraints(restraints);
+
+    // Add floor loads
+    std::vector<Load *> *loads = new std::vector<Load *>();
+    FEMatrix *loadv = FEMatrix_vector(2);
+    for (int j = 1; j <= stories; j++) {
+        loadv->set(0, 100 * j);
+        loads->push_back(new LoadNode("NL" + std::to_string(j), nodes->at(static_cast<unsigned long>(j * (bays + 1))),
+                                      loadv));
+    }
+    std::vector<LoadPattern *> *loadpattern = new std::vector<LoadPattern *>();
+    loadpattern->push_back(new LoadPatternConstant("LOADCONSTANT", loads));
+    model->add_load_patterns(loadpattern);
+    delete loadv;
+
+    return model;
+}
+
+/**
+ * Deletes a model created by test functions.
+ *
+ * @param model Model
+ */
+void __test_static_analysis_delete(Model *model) {
+    model->clear();
+    delete model->get_nodes();
+    delete model->get_elements();
+    delete model->get_restrants();
+    delete model->get_load_patterns();
+    delete model;
+}
+
+/**
+ * Check two displacement vectors are the same under a relative tolerance.
+ *
+ * @param u1 Displacement vector
+ * @param u2 Displacement vector
+ * @param tol Relative tolerance
+ * @return
+ */
+bool __test_static_analysis_same_displacements(FEMatrix *u1, FEMatrix *u2, double tol) {
+    if (u1->length() != u2->length()) return false;
+    FEMatrix du = *u1 - *u2;
+    bool same = du.norm() <= tol * u1->norm();
+    return same;
+}
+
+/**
+ * Test conjugate gradient solver, displacements must match the sparse LDL' solver and the
+ * analysis must fail if the solver does not converge.
+ */
+void __test_static_analysis_pcg() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_pcg");
+
+    // Solve using direct solver
+    Model *model = __test_static_analysis_wall(4, 6);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *u_ldl = analysis->get_displacements_vector();
+    delete analysis;
+    __test_static_analysis_delete(model);
+
+    // Solve using PCG
+    model = __test_static_analysis_wall(4, 6);
+    analysis = new StaticAnalysis(model);
+    analysis->get_pcg_solver()->set_tolerance(1e-12);
+
+    // Not enough iterations, analysis fails instead of using the displacements
+    analysis->get_pcg_solver()->set_max_iterations(2);
+    bool error = false;
+    try {
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_PCG);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    assert(!analysis->get_pcg_solver()->has_converged());
+    (void) error;
+    analysis->get_pcg_solver()->set_max_iterations(1000);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_PCG);
+    FEMatrix *u_pcg = analysis->get_displacements_vector();
+    assert(analysis->get_pcg_solver()->has_converged());
+    assert(analysis->get_pcg_solver()->get_iterations() > 0);
+    assert(__test_static_analysis_same_displacements(u_ldl, u_pcg, 1e-8));
+
+    // Delete data
+    delete u_ldl;
+    delete u_pcg;
+    delete analysis;
+    __test_static_analysis_delete(model);
+}
+
+/**
+ * Check node displacements of two models are the same, models must have the same node order.
+ *
+ * @param m1 Model
+ * @param m2 Model
+ * @param tol Absolute tolerance
+ * @return
+ */
+bool __test_static_analysis_same_node_displacements(Model *m1, Model *m2, double tol) {
+    std::vector<Node *> *n1 = m1->get_nodes();
+    std::vector<Node *> *n2 = m2->get_nodes();
+    if (n1->size() != n2->size()) return false;
+    for (unsigned long k = 0; k < n1->size(); k++) {
+        for (int i = 1; i <= 2; i++) {
+            if (fabs(n1->at(k)->get_displacement(i) - n2->at(k)->get_displacement(i)) > tol) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test DOF renumbering over a wide wall numbered along its long side, RCM must reduce the
+ * bandwidth and the profile and every numbering must give the same displacements.
+ */
+void __test_static_analysis_numbering() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_numbering");
+
+    // Wide wall numbered along the long side
+    Model *model = __test_static_analysis_wall(12, 3);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze();
+    int bandwidth = analysis->get_bandwidth();
+    long profile = analysis->get_profile();
+    assert(bandwidth > 0);
+
+    // Reverse Cuthill-McKee
+    Model *model_rcm = __test_static_analysis_wall(12, 3);
+    StaticAnalysis *analysis_rcm = new StaticAnalysis(model_rcm);
+    analysis_rcm->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_RCM);
+    analysis_rcm->analyze();
+    assert(analysis_rcm->get_bandwidth() < bandwidth);
+    assert(analysis_rcm->get_profile() < profile);
+    assert(__test_static_analysis_same_node_displacements(model, model_rcm, 1e-9));
+    (void) bandwidth;
+    (void) profile;
+
+    // Minimum degree
+    Model *model_md = __test_static_analysis_wall(12, 3);
+    StaticAnalysis *analysis_md = new StaticAnalysis(model_md);
+    analysis_md->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_MINDEGREE);
+    analysis_md->analyze();
+    assert(__test_static_analysis_same_node_displacements(model, model_md, 1e-9));
+
+    // Invalid method
+    bool error = false;
+    try {
+        analysis->set_dof_numbering(-1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete analysis;
+    delete analysis_rcm;
+    delete analysis_md;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_rcm);
+    __test_static_analysis_delete(model_md);
+}
+
+/**
+ * Test skyline solver over a long bridge deck. Using the RCM numbering the bandwidth does
+ * not depend on the number of membranes, so the profile grows linearly with the length.
+ */
+void __test_static_analysis_skyline() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_skyline");
+
+    // Solve using sparse LDL'
+    Model *model = __test_static_analysis_bridge(40);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+
+    // Solve using skyline over a banded numbering
+    Model *model_sky = __test_static_analysis_bridge(40);
+    StaticAnalysis *analysis_sky = new StaticAnalysis(model_sky);
+    analysis_sky->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_RCM);
+    analysis_sky->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    double deflection = fabs(model->get_nodes()->at(20)->get_displacement(2)); // Midspan, defines the tolerance
+    assert(__test_static_analysis_same_node_displacements(model, model_sky, 1e-9 * deflection));
+    (void) deflection;
+
+    // Half of the deck has the same bandwidth
+    Model *model_half = __test_static_analysis_bridge(20);
+    StaticAnalysis *analysis_half = new StaticAnalysis(model_half);
+    analysis_half->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_RCM);
+    analysis_half->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(analysis_half->get_bandwidth() == analysis_sky->get_bandwidth());
+    assert(analysis_sky->get_profile() <= static_cast<long>(analysis_sky->get_ndof()) * analysis_sky->get_bandwidth());
+
+    // Delete data
+    delete analysis;
+    delete analysis_sky;
+    delete analysis_half;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_sky);
+    __test_static_analysis_delete(model_half);
+}
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+/**
+ * Test out of core solver over a long bridge deck, the memory budget only maps a part of
+ * the skyline factor at a time and the results must match the in memory skyline solver.
+ */
+void __test_static_analysis_out_of_core() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_out_of_core");
+
+    // Solve using skyline
+    Model *model = __test_static_analysis_bridge(150);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_RCM);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+
+    // Solve out of core, the budget splits the factor in many panels
+    Model *model_ooc = __test_static_analysis_bridge(150);
+    StaticAnalysis *analysis_ooc = new StaticAnalysis(model_ooc);
+    analysis_ooc->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_RCM);
+    analysis_ooc->set_out_of_core_memory(24576);
+    analysis_ooc->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_OUT_OF_CORE);
+    double deflection = fabs(model->get_nodes()->at(75)->get_displacement(2)); // Midspan, defines the tolerance
+    assert(__test_static_analysis_same_node_displacements(model, model_ooc, 1e-9 * deflection));
+    (void) deflection;
+    OutOfCoreSkyline *ooc = analysis_ooc->get_out_of_core_solver();
+    assert(ooc->get_panels() > 2);
+    assert(ooc->get_file_bytes() > 24576);
+    assert(ooc->get_peak_memory() <= 24576);
+
+    // Determinant reuses the factor file
+    int sign, sign_ooc;
+    double logdet = analysis->get_stiffness_log_det(&sign);
+    assert(fabs(logdet - analysis_ooc->get_stiffness_log_det(&sign_ooc)) < 1e-9 * fabs(logdet));
+    assert(sign == sign_ooc);
+    (void) logdet;
+    (void) sign_ooc;
+
+    // Second analysis uses the stored factorization
+    analysis_ooc->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_OUT_OF_CORE);
+    assert(analysis_ooc->is_factorization_cached());
+    assert(analysis_ooc->get_out_of_core_solver() == ooc);
+    (void) ooc;
+
+    // Invalid budget
+    bool error = false;
+    try {
+        analysis_ooc->set_out_of_core_memory(0);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete analysis;
+    delete analysis_ooc;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_ooc);
+}
+
+#endif
+
+/**
+ * Test dense factorization solver, displacements, stiffness determinant and condition number
+ * must match the ones of the sparse solvers.
+ */
+void __test_static_analysis_dense() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_dense");
+
+    // Solve using sparse LDL'
+    Model *model = __test_static_analysis_wall(3, 4);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *u_ldl = analysis->get_displacements_vector();
+
+    // Solve using dense factorization
+    Model *model_dense = __test_static_analysis_wall(3, 4);
+    StaticAnalysis *analysis_dense = new StaticAnalysis(model_dense);
+    analysis_dense->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_DENSE);
+    FEMatrix *u_dense = analysis_dense->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u_ldl, u_dense, 1e-9));
+
+    // Stiffness log determinant reuses each factorization, iterative solvers factorize again
+    int sign_ldl, sign_dense, sign_pcg;
+    double logdet_ldl = analysis->get_stiffness_log_det(&sign_ldl);
+    double logdet_dense = analysis_dense->get_stiffness_log_det(&sign_dense);
+    analysis_dense->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_PCG);
+    double logdet_pcg = analysis_dense->get_stiffness_log_det(&sign_pcg);
+    assert(sign_ldl == 1 && sign_dense == 1 && sign_pcg == 1);
+    assert(fabs(logdet_ldl - logdet_dense) < 1e-9 * fabs(logdet_ldl));
+    assert(fabs(logdet_ldl - logdet_pcg) < 1e-9 * fabs(logdet_ldl));
+    (void) logdet_ldl;
+    (void) logdet_dense;
+    (void) logdet_pcg;
+
+    // Condition number estimate does not depend on the factorization used
+    int nsolves;
+    double cond_pcg = analysis_dense->get_stiffness_condition(&nsolves);
+    double cond_ldl = analysis->get_stiffness_condition(&nsolves);
+    FEMatrix *K = analysis->get_stiffness_matrix();
+    double cond = K->cond();
+    assert(cond > 1);
+    assert(fabs(cond_ldl - cond) < 1e-6 * cond);
+    assert(fabs(cond_pcg - cond) < 1e-6 * cond);
+    (void) cond_pcg;
+    (void) cond_ldl;
+    (void) cond;
+    delete K;
+    analysis_dense->disp();
+
+    // Delete data
+    delete u_ldl;
+    delete u_dense;
+    delete analysis;
+    delete analysis_dense;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_dense);
+}
+
+/**
+ * Test load patterns solved as load cases of one factorization, each case must match the
+ * analysis of the model with a single load pattern.
+ */
+void __test_static_analysis_load_cases() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_load_cases");
+
+    // Model with a single load pattern
+    Model *model1 = __test_static_analysis_wall(3, 4);
+    StaticAnalysis *analysis1 = new StaticAnalysis(model1);
+    analysis1->analyze();
+    assert(analysis1->get_number_load_cases() == 1);
+
+    // Same model adding a second load pattern at the top right node
+    Model *model = __test_static_analysis_wall(3, 4);
+    std::vector<Load *> *loads = new std::vector<Load *>();
+    FEMatrix *loadv = FEMatrix_vector(2);
+    loadv->set(0, -200);
+    loadv->set(1, 300);
+    loads->push_back(new LoadNode("NL2", model->get_nodes()->back(), loadv));
+    model->get_load_patterns()->push_back(new LoadPatternConstant("LOADCONSTANT2", loads));
+    delete loadv;
+
+    // Solve both load cases using one factorization
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze();
+    assert(analysis->get_number_load_cases() == 2);
+    FEMatrix *U = analysis->get_displacements_matrix();
+    FEMatrix *F = analysis->get_force_matrix();
+    FEMatrix *u = analysis->get_displacements_vector();
+    FEMatrix *u1 = analysis1->get_displacements_vector();
+    for (int i = 0; i < analysis->get_ndof(); i++) {
+        assert(is_num_equal(U->get(i, 0), u1->get(i)));
+        assert(is_num_equal(U->get(i, 0) + U->get(i, 1), u->get(i)));
+    }
+    assert(is_num_equal(F->get(analysis->get_ndof() - 2, 1), -200));
+
+    // Push first load case to the model, results must be the single load pattern ones
+    analysis->update_load_case(0);
+    assert(__test_static_analysis_same_node_displacements(model, model1, 1e-12));
+    for (unsigned long k = 0; k < model->get_nodes()->size(); k++) {
+        for (int i = 1; i <= 2; i++) {
+            assert(fabs(model->get_nodes()->at(k)->get_reaction(i) -
+                        model1->get_nodes()->at(k)->get_reaction(i)) < 1e-8);
+        }
+    }
+
+    // Restore all load cases
+    analysis->update_load_cases();
+    assert(!__test_static_analysis_same_node_displacements(model, model1, 1e-12));
+
+    // Invalid load case
+    bool error = false;
+    try {
+        analysis->update_load_case(2);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete U;
+    delete F;
+    delete u;
+    delete u1;
+    delete analysis;
+    delete analysis1;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model1);
+}
+
+/**
+ * Test factorization cache, a repeated analysis reuses the factorization until the solver,
+ * the model or an element stiffness changes.
+ */
+void __test_static_analysis_factorization_cache() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_factorization_cache");
+
+    // First analysis factorizes the stiffness
+    Model *model = __test_static_analysis_wall(3, 4);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    assert(!analysis->is_factorization_cached());
+    FEMatrix *u1 = analysis->get_displacements_vector();
+
+    // Same model, factorization is reused and results do not change
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    assert(analysis->is_factorization_cached());
+    FEMatrix *u2 = analysis->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u1, u2, 1e-12));
+
+    // New load pattern does not change the stiffness
+    std::vector<Load *> *loads = new std::vector<Load *>();
+    FEMatrix *loadv = FEMatrix_vector(2);
+    loadv->set(0, 100);
+    loads->push_back(new LoadNode("NL2", model->get_nodes()->back(), loadv));
+    model->get_load_patterns()->push_back(new LoadPatternConstant("LOADCONSTANT2", loads));
+    delete loadv;
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    assert(analysis->is_factorization_cached());
+    assert(analysis->get_number_load_cases() == 2);
+
+    // Solver change, explicit invalidation and model notification
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(!analysis->is_factorization_cached());
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(analysis->is_factorization_cached());
+    analysis->invalidate_factorization();
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(!analysis->is_factorization_cached());
+    model->invalidate();
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(!analysis->is_factorization_cached());
+
+    // Element stiffness change is detected by the fingerprint
+    Element *old = model->get_elements()->at(0);
+    std::vector<Node *> *mnodes = old->get_nodes();
+    model->get_elements()->at(0) = new Membrane("MEM1", mnodes->at(0), mnodes->at(1), mnodes->at(2),
+                                                mnodes->at(3), 200000, 0.15, 15);
+    delete old;
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(!analysis->is_factorization_cached());
+
+    // Disabled cache
+    analysis->set_factorization_cache(false);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE);
+    assert(!analysis->is_factorization_cached());
+
+    // Delete data
+    delete u1;
+    delete u2;
+    delete analysis;
+    __test_static_analysis_delete(model);
+}
+
+/**
+ * Test low-rank update of the stored factorization over a design iteration of a building,
+ * the first story walls are thickened and a cracked panel loses half of their modulus.
+ * Results must match a new factorization of the same design.
+ */
+void __test_static_analysis_low_rank_update() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_low_rank_update");
+    std::vector<std::string> solvers = {FNELEM_STATIC_ANALYSIS_SOLVER_LDL, FNELEM_STATIC_ANALYSIS_SOLVER_SKYLINE,
+                                        FNELEM_STATIC_ANALYSIS_SOLVER_DENSE};
+    for (auto &solver : solvers) {
+
+        // First analysis factorizes the stiffness
+        Model *model = __test_static_analysis_building(8, 4);
+        StaticAnalysis *analysis = new StaticAnalysis(model);
+        analysis->analyze(solver);
+        assert(!analysis->is_factorization_updated());
+        assert(analysis->get_update_rank() == 0);
+
+        // Design change, thicker first story and a cracked panel, updates the factorization
+        for (unsigned long k = 0; k < 4; k++) {
+            dynamic_cast<Membrane *>(model->get_elements()->at(k))->set_thickness(30);
+        }
+        dynamic_cast<Membrane *>(model->get_elements()->at(17))->set_elasticity(150000);
+        analysis->analyze(solver);
+        assert(analysis->is_factorization_updated());
+        assert(!analysis->is_factorization_cached());
+        assert(analysis->get_update_rank() > 0 && analysis->get_update_rank() <= 18);
+        FEMatrix *u = analysis->get_displacements_vector();
+
+        // Compare with a new factorization of the same design
+        Model *model_new = __test_static_analysis_building(8, 4);
+        for (unsigned long k = 0; k < 4; k++) {
+            dynamic_cast<Membrane *>(model_new->get_elements()->at(k))->set_thickness(30);
+        }
+        dynamic_cast<Membrane *>(model_new->get_elements()->at(17))->set_elasticity(150000);
+        StaticAnalysis *analysis_new = new StaticAnalysis(model_new);
+        analysis_new->analyze(solver);
+        FEMatrix *u_new = analysis_new->get_displacements_vector();
+        assert(__test_static_analysis_same_displacements(u_new, u, 1e-9));
+
+        // Determinant includes the update
+        int sign, sign_new;
+        double logdet = analysis->get_stiffness_log_det(&sign);
+        assert(fabs(logdet - analysis_new->get_stiffness_log_det(&sign_new)) < 1e-9 * fabs(logdet));
+        assert(sign == sign_new);
+        (void) logdet;
+        (void) sign_new;
+
+        // Same design uses the stored factorization and the update
+        analysis->analyze(solver);
+        assert(analysis->is_factorization_cached());
+        FEMatrix *u2 = analysis->get_displacements_vector();
+        assert(__test_static_analysis_same_displacements(u_new, u2, 1e-9));
+
+        // Restoring the design removes the update, the rows do not change
+        for (unsigned long k = 0; k < 4; k++) {
+            dynamic_cast<Membrane *>(model->get_elements()->at(k))->set_thickness(20);
+        }
+        dynamic_cast<Membrane *>(model->get_elements()->at(17))->set_elasticity(300000);
+        analysis->analyze(solver);
+        assert(analysis->is_factorization_updated());
+        assert(analysis->get_update_rank() == 0);
+
+        // Many changes require a new factorization
+        for (auto &element : *model->get_elements()) {
+            dynamic_cast<Membrane *>(element)->set_thickness(25);
+        }
+        analysis->analyze(solver);
+        assert(!analysis->is_factorization_updated());
+        assert(analysis->get_update_rank() == 0);
+
+        // Delete data
+        delete u;
+        delete u2;
+        delete u_new;
+        delete analysis;
+        delete analysis_new;
+        __test_static_analysis_delete(model);
+        __test_static_analysis_delete(model_new);
+    }
+
+    // Disable update
+    Model *model = __test_static_analysis_building(3, 3);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->set_update_max_rank(0);
+    assert(analysis->get_update_max_rank() == 0);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    dynamic_cast<Membrane *>(model->get_elements()->at(0))->set_thickness(25);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    assert(!analysis->is_factorization_updated());
+    bool error = false;
+    try {
+        analysis->set_update_max_rank(-1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+    delete analysis;
+    __test_static_analysis_delete(model);
+}
+
+/**
+ * Test multithreaded assembly, the colored assembly must give the same stiffness values and
+ * displacements as the serial one.
+ */
+void __test_static_analysis_parallel_assembly() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_parallel_assembly");
+
+    // Serial assembly
+    Model *model = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze();
+    assert(analysis->get_assembly_colors() == 0);
+    FEMatrixSparse *K = analysis->get_stiffness_matrix_sparse();
+    FEMatrix *u = analysis->get_displacements_vector();
+
+    // Parallel assembly, a quad mesh needs four colors
+    Model *model_par = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis_par = new StaticAnalysis(model_par);
+    analysis_par->set_assembly_threads(4);
+    analysis_par->analyze();
+    assert(analysis_par->get_assembly_colors() == 4);
+    FEMatrixSparse *K_par = analysis_par->get_stiffness_matrix_sparse();
+    FEMatrix *u_par = analysis_par->get_displacements_vector();
+    assert(K->get_nnz() == K_par->get_nnz());
+    for (int k = 0; k < K->get_nnz(); k++) {
+        assert(fabs(K->get_values()[k] - K_par->get_values()[k]) <= 1e-9 * fabs(K->get_values()[k]));
+    }
+    assert(__test_static_analysis_same_displacements(u, u_par, 1e-9));
+
+    // Invalid number of threads
+    bool error = false;
+    try {
+        analysis_par->set_assembly_threads(-1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete K;
+    delete K_par;
+    delete u;
+    delete u_par;
+    delete analysis;
+    delete analysis_par;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_par);
+}
+
+/**
+ * Test element by element solver, the stiffness is not assembled and the displacements must
+ * match the direct solution.
+ */
+void __test_static_analysis_matrix_free() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_matrix_free");
+
+    // Direct solution
+    Model *model = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *u = analysis->get_displacements_vector();
+
+    // Element by element PCG, stiffness is not assembled
+    Model *model_ebe = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis_ebe = new StaticAnalysis(model_ebe);
+    analysis_ebe->get_pcg_solver()->set_tolerance(1e-10);
+    analysis_ebe->get_pcg_solver()->set_max_iterations(1000);
+    analysis_ebe->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_MATRIX_FREE);
+    assert(analysis_ebe->get_stiffness_matrix() == nullptr);
+    assert(analysis_ebe->get_pcg_solver()->has_converged());
+    FEMatrix *u_ebe = analysis_ebe->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_ebe, 1e-6));
+    assert(__test_static_analysis_same_node_displacements(model, model_ebe, 1e-6));
+    delete u_ebe;
+
+    // Parallel element products
+    Model *model_par = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis_par = new StaticAnalysis(model_par);
+    analysis_par->get_pcg_solver()->set_tolerance(1e-10);
+    analysis_par->get_pcg_solver()->set_max_iterations(1000);
+    analysis_par->set_assembly_threads(4);
+    analysis_par->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_MATRIX_FREE);
+    assert(analysis_par->get_assembly_colors() == 4);
+    u_ebe = analysis_par->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_ebe, 1e-6));
+    delete u_ebe;
+
+    // Direct solver assembles the stiffness again
+    analysis_ebe->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *K = analysis_ebe->get_stiffness_matrix();
+    assert(K != nullptr);
+    u_ebe = analysis_ebe->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_ebe, 1e-9));
+
+    // Delete data
+    delete K;
+    delete u;
+    delete u_ebe;
+    delete analysis;
+    delete analysis_ebe;
+    delete analysis_par;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_ebe);
+    __test_static_analysis_delete(model_par);
+}
+
+/**
+ * Test algebraic multigrid preconditioner over thin tall walls, it must use fewer iterations
+ * than Jacobi and their number must not grow with the mesh.
+ */
+void __test_static_analysis_amg() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_amg");
+
+    // Thin tall walls, iterations must not grow with the mesh
+    int sizes[3][2] = {{4, 16}, {8, 32}, {16, 64}};
+    int jacobi[3], multigrid[3];
+    for (int k = 0; k < 3; k++) {
+        Model *model = __test_static_analysis_wall(sizes[k][0], sizes[k][1]);
+        StaticAnalysis *analysis = new StaticAnalysis(model);
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+        FEMatrix *u = analysis->get_displacements_vector();
+
+        // Jacobi preconditioner
+        analysis->get_pcg_solver()->set_tolerance(1e-10);
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_PCG);
+        jacobi[k] = analysis->get_pcg_solver()->get_iterations();
+
+        // Multigrid preconditioner
+        analysis->get_amg_preconditioner()->set_coarse_size(50);
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_AMG);
+        multigrid[k] = analysis->get_pcg_solver()->get_iterations();
+        assert(analysis->get_pcg_solver()->has_converged());
+        FEMatrix *u_amg = analysis->get_displacements_vector();
+        assert(__test_static_analysis_same_displacements(u, u_amg, 1e-7));
+        assert(analysis->get_amg_preconditioner()->get_levels() > 1);
+
+        // Hierarchy is reused if the model does not change
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_AMG);
+        assert(analysis->is_factorization_cached());
+        assert(analysis->get_pcg_solver()->get_iterations() == multigrid[k]);
+
+        // Delete data
+        delete u;
+        delete u_amg;
+        delete analysis;
+        __test_static_analysis_delete(model);
+    }
+    for (int k = 0; k < 3; k++) {
+        assert(multigrid[k] < jacobi[k]);
+        assert(multigrid[k] <= multigrid[0] + 5);
+    }
+    (void) jacobi;
+    (void) multigrid;
+}
+
+/**
+ * Test geometric multigrid preconditioner over buildings of increasing number of stories
+ * and bays, the number of iterations must not grow with the grid.
+ */
+void __test_static_analysis_gmg() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_gmg");
+
+    // Buildings, iterations must not grow with the grid
+    int sizes[3][2] = {{16, 4}, {32, 8}, {64, 16}};
+    int multigrid[3];
+    for (int k = 0; k < 3; k++) {
+        Model *model = __test_static_analysis_building(sizes[k][0], sizes[k][1]);
+        StaticAnalysis *analysis = new StaticAnalysis(model);
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+        FEMatrix *u = analysis->get_displacements_vector();
+
+        // Geometric multigrid preconditioner
+        analysis->get_pcg_solver()->set_tolerance(1e-10);
+        analysis->get_gmg_preconditioner()->set_coarse_size(50);
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_GMG);
+        multigrid[k] = analysis->get_pcg_solver()->get_iterations();
+        assert(analysis->get_pcg_solver()->has_converged());
+        assert(analysis->get_gmg_preconditioner()->get_levels() > 1);
+        FEMatrix *u_gmg = analysis->get_displacements_vector();
+        assert(__test_static_analysis_same_displacements(u, u_gmg, 1e-7));
+
+        // Delete data
+        delete u;
+        delete u_gmg;
+        delete analysis;
+        __test_static_analysis_delete(model);
+    }
+    for (int k = 0; k < 3; k++) {
+        assert(multigrid[k] <= multigrid[0] + 5);
+    }
+    (void) multigrid;
+
+    // Parallelogram membranes are not a structured rectangular grid
+    Model *model = __test_static_analysis_wall(4, 4, 10);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    bool error = false;
+    try {
+        analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_GMG);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+    delete analysis;
+    __test_static_analysis_delete(model);
+}
+
+/**
+ * Test substructuring solver over a building of 16 stories, the stories are grouped in
+ * domains and the interface Schur complement must give the direct solution.
+ */
+void __test_static_analysis_substructure() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_substructure");
+
+    // Direct solution
+    Model *model = __test_static_analysis_building(16, 4);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *u = analysis->get_displacements_vector();
+
+    // Four groups of four stories, three floors of 5 nodes are the interface
+    Model *model_sub = __test_static_analysis_building(16, 4);
+    StaticAnalysis *analysis_sub = new StaticAnalysis(model_sub);
+    analysis_sub->set_substructures(4);
+    analysis_sub->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE);
+    assert(analysis_sub->get_schur_solver()->get_domains() == 4);
+    assert(analysis_sub->get_schur_solver()->get_interface_dimension() == 3 * 5 * 2);
+    FEMatrix *u_sub = analysis_sub->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_sub, 1e-9));
+    assert(__test_static_analysis_same_node_displacements(model, model_sub, 1e-9));
+    delete u_sub;
+
+    // Domains are condensed in parallel, factorization is reused
+    analysis_sub->set_assembly_threads(4);
+    analysis_sub->invalidate_factorization();
+    analysis_sub->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE);
+    assert(!analysis_sub->is_factorization_cached());
+    analysis_sub->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE);
+    assert(analysis_sub->is_factorization_cached());
+    u_sub = analysis_sub->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_sub, 1e-9));
+    delete u_sub;
+
+    // User partition, left and right bays
+    std::vector<int> partition;
+    for (int k = 0; k < 4 * 16; k++) {
+        partition.push_back(k % 4 < 2 ? 0 : 1);
+    }
+    analysis_sub->set_substructures(&partition);
+    analysis_sub->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE);
+    assert(!analysis_sub->is_factorization_cached());
+    assert(analysis_sub->get_schur_solver()->get_interface_dimension() == 16 * 2);
+    u_sub = analysis_sub->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_sub, 1e-9));
+
+    // Partition must have the number of elements
+    partition.pop_back();
+    analysis_sub->set_substructures(&partition);
+    bool error = false;
+    try {
+        analysis_sub->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete u;
+    delete u_sub;
+    delete analysis;
+    delete analysis_sub;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_sub);
+}
+
+/**
+ * Test mixed precision solver, the single precision factorization with refinement must
+ * reach the double precision solution and fall back to it if the refinement fails.
+ */
+void __test_static_analysis_mixed_precision() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_mixed_precision");
+
+    // Direct solution
+    Model *model = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *u = analysis->get_displacements_vector();
+
+    // Single precision factorization and refinement
+    Model *model_mixed = __test_static_analysis_wall(8, 6);
+    StaticAnalysis *analysis_mixed = new StaticAnalysis(model_mixed);
+    analysis_mixed->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_MIXED);
+    MixedPrecisionSolver *mixed = analysis_mixed->get_mixed_precision_solver();
+    assert(!mixed->is_fallback());
+    assert(mixed->get_refinement_steps() > 0);
+    FEMatrix *u_mixed = analysis_mixed->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_mixed, 1e-10));
+    assert(__test_static_analysis_same_node_displacements(model, model_mixed, 1e-10));
+    delete u_mixed;
+
+    // Renumbering changes the stiffness pattern, single precision factor must be recomputed
+    analysis_mixed->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_RCM);
+    analysis_mixed->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_MIXED);
+    assert(!mixed->is_fallback());
+    assert(__test_static_analysis_same_node_displacements(model, model_mixed, 1e-10));
+    analysis_mixed->set_dof_numbering(FNELEM_STATIC_ANALYSIS_NUMBERING_NONE);
+
+    // Refinement cannot reach the tolerance, uses double precision
+    mixed->set_max_steps(1);
+    mixed->set_tolerance(1e-30);
+    analysis_mixed->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_MIXED);
+    assert(mixed->is_fallback());
+    u_mixed = analysis_mixed->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_mixed, 1e-12));
+
+    // Delete data
+    delete u;
+    delete u_mixed;
+    delete analysis;
+    delete analysis_mixed;
+    __test_static_analysis_delete(model);
+    __test_static_analysis_delete(model_mixed);
+}
+
+/**
+ * Test solver backend registry, every built-in and user defined backend must give the
+ * direct solution and the automatic selection must follow the cost model.
+ */
+void __test_static_analysis_solver_backends() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_solver_backends");
+
+    // Sparse LDL' solution
+    Model *model = __test_static_analysis_wall(6, 4);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    assert(analysis->get_solver() == FNELEM_STATIC_ANALYSIS_SOLVER_AUTO);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    assert(analysis->get_last_solver() == FNELEM_STATIC_ANALYSIS_SOLVER_LDL);
+    FEMatrix *u = analysis->get_displacements_vector();
+
+    // Built-in backends
+    SolverRegistry *registry = analysis->get_solver_registry();
+    assert(registry->has(FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN));
+    assert(registry->has(FNELEM_STATIC_ANALYSIS_SOLVER_SUBSTRUCTURE));
+    assert(!registry->has(FNELEM_STATIC_ANALYSIS_SOLVER_CUDA));
+    assert(!registry->requires_stiffness(FNELEM_STATIC_ANALYSIS_SOLVER_MATRIX_FREE));
+
+    // Serial CPU inversion gives the same displacements
+    analysis->set_solver(FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN);
+    analysis->analyze();
+    assert(analysis->get_last_solver() == FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN);
+    FEMatrix *u_backend = analysis->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_backend, 1e-8));
+    delete u_backend;
+
+    // Gauss-Jordan kernels by host threads
+    analysis->set_assembly_threads(0);
+    analysis->analyze(FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN_THREADED);
+    u_backend = analysis->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_backend, 1e-8));
+    delete u_backend;
+
+    // User defined backend, dense factorization
+    int calls = 0;
+    analysis->add_solver("user", "Dense LU", [&calls](const FEMatrixSparse *K, const FEMatrix *F, bool /* cached */) {
+        calls += 1;
+        FEMatrix *Kdense = K->to_dense();
+        FEMatrixFactorization *fact = new FEMatrixFactorization();
+        fact->lu(Kdense);
+        FEMatrix *U = fact->solve(F);
+        delete Kdense;
+        delete fact;
+        return U;
+    });
+    analysis->analyze("user");
+    assert(calls == 1);
+    u_backend = analysis->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_backend, 1e-10));
+    delete u_backend;
+
+    // Each backend stores their time
+    assert(registry->get_runs(FNELEM_STATIC_ANALYSIS_SOLVER_LDL) == 1);
+    assert(registry->get_runs(FNELEM_STATIC_ANALYSIS_SOLVER_GAUSS_JORDAN) == 1);
+    assert(registry->get_runs("user") == 1);
+    assert(registry->get_runs(FNELEM_STATIC_ANALYSIS_SOLVER_PCG) == 0);
+    assert(registry->get_last_time("user") >= 0);
+    registry->disp();
+
+    // Automatic selection uses the cost model, the memory limit discards the direct solvers
+    SolverCostModel *costs = analysis->get_solver_cost_model();
+    analysis->set_solver(FNELEM_STATIC_ANALYSIS_SOLVER_AUTO);
+    analysis->analyze();
+    assert(analysis->get_last_solver() == costs->get_selected());
+    costs->set_memory_limit(static_cast<long>(costs->get_memory(FNELEM_STATIC_ANALYSIS_SOLVER_PCG)) + 1);
+    analysis->analyze();
+    assert(analysis->get_last_solver() == FNELEM_STATIC_ANALYSIS_SOLVER_PCG);
+    u_backend = analysis->get_displacements_vector();
+    assert(__test_static_analysis_same_displacements(u, u_backend, 1e-6));
+    delete u_backend;
+
+    // Invalid backends
+    bool error = false;
+    try {
+        analysis->set_solver("unknown");
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    error = false;
+    try {
+        analysis->analyze("unknown");
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    error = false;
+    try {
+        analysis->add_solver(FNELEM_STATIC_ANALYSIS_SOLVER_AUTO, "Reserved",
+                             [](const FEMatrixSparse * /* K */, const FEMatrix *F, bool /* cached */) {
+                                 return F->clone();
+                             });
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete u;
+    delete analysis;
+    __test_static_analysis_delete(model);
+}
+
+/**
+ * Test automatic solver selection when a load case is added, the cost model must estimate
+ * the candidates again for the new number of right hand sides.
+ */
+void __test_static_analysis_automatic_load_cases() {
+    test_print_title("STATIC-ANALYSIS", "test_static_analysis_automatic_load_cases");
+    Model *model = __test_static_analysis_wall(6, 4);
+    StaticAnalysis *analysis = new StaticAnalysis(model);
+    SolverCostModel *costs = analysis->get_solver_cost_model();
+    analysis->analyze();
+    double flops = costs->get_flops(FNELEM_STATIC_ANALYSIS_SOLVER_PCG);
+
+    // New load case, same topology, the candidates are estimated again
+    std::vector<Load *> *loads = new std::vector<Load *>();
+    FEMatrix *loadv = FEMatrix_vector(2);
+    loadv->set(0, 500);
+    loads->push_back(new LoadNode("NL500kN", model->get_nodes()->back(), loadv));
+    model->get_load_patterns()->push_back(new LoadPatternConstant("LOADCONSTANT2", loads));
+    delete loadv;
+    analysis->analyze();
+    assert(is_num_equal(costs->get_flops(FNELEM_STATIC_ANALYSIS_SOLVER_PCG), 2 * flops));
+    assert(analysis->get_last_solver() == costs->get_selected());
+    (void) flops;
+
+    // Delete data
+    delete analysis;
+    __test_static_analysis_delete(model);
+}
+
 /**
  * Performs TEST-STATIC-ANALYSIS suite.
  */
@@ -370,4 +1567,22 @@ void test_static_analysis_suite() {
     __test_static_analysis_test();
     __test_building();
     __test_bridge();
+    __test_static_analysis_pcg();
+    __test_static_analysis_numbering();
+    __test_static_analysis_skyline();
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+    __test_static_analysis_out_of_core();
+#endif
+    __test_static_analysis_dense();
+    __test_static_analysis_load_cases();
+    __test_static_analysis_factorization_cache();
+    __test_static_analysis_low_rank_update();
+    __test_static_analysis_parallel_assembly();
+    __test_static_analysis_matrix_free();
+    __test_static_analysis_amg();
+    __test_static_analysis_gmg();
+    __test_static_analysis_substructure();
+    __test_static_analysis_mixed_precision();
+    __test_static_analysis_solver_backends();
+    __test_static_analysis_automatic_load_cases();
 }
\ No newline at end of file
@@ -29,11 +29,49 @@ Test math package.
 */
 
 // Include sources
+#include "test_amg.h"
+#include "test_condition_estimate.h"
+#include "test_element_operator.h"
 #include "test_fematrix.h"
+#include "test_fematrix_expression.h"
+#include "test_fematrix_factorization.h"
+#include "test_fematrix_gemm.h"
+#include "test_fematrix_skyline.h"
+#include "test_fematrix_sparse.h"
 #include "test_fematrix_utils.h"
+#include "test_fixed_matrix.h"
+#include "test_gmg.h"
+#include "test_low_rank_update.h"
+#include "test_matrix_inversion_threaded.h"
+#include "test_matrix_ordering.h"
+#include "test_mixed_precision.h"
+#include "test_out_of_core_skyline.h"
+#include "test_pcg.h"
+#include "test_schur_solver.h"
+#include "test_sparse_ldl.h"
+#include "test_thread_pool.h"
 
 int main() {
+    test_amg_suite();
+    test_condition_estimate_suite();
+    test_element_operator_suite();
     test_fematrix_suite();
+    test_fematrix_expression_suite();
+    test_fematrix_factorization_suite();
+    test_fematrix_gemm_suite();
+    test_fematrix_skyline_suite();
+    test_fematrix_sparse_suite();
     test_fematrix_utils_suite();
+    test_fixed_matrix_suite();
+    test_gmg_suite();
+    test_low_rank_update_suite();
+    test_matrix_inversion_threaded_suite();
+    test_matrix_ordering_suite();
+    test_mixed_precision_suite();
+    test_out_of_core_skyline_suite();
+    test_pcg_suite();
+    test_schur_solver_suite();
+    test_sparse_ldl_suite();
+    test_thread_pool_suite();
     return 0;
 }
\ No newline at end of file
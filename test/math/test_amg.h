@@ -0,0 +1,159 @@
+/**
+FNELEM-GPU - ALGEBRAIC MULTIGRID TEST
+Test smoothed aggregation multigrid preconditioner.
+
+@package test.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/amg.h"
+#include "../../fnelem/math/pcg.h"
+
+/**
+ * Creates 2D Poisson matrix (5 point stencil) of n x n grid, only lower triangle.
+ *
+ * @param n Grid dimension
+ * @return
+ */
+FEMatrixSparse *__test_amg_poisson(int n) {
+    int N = n * n, i, j, k;
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(N));
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            k = i * n + j;
+            pattern[k].push_back(k);
+            if (j > 0) pattern[k].push_back(k - 1);
+            if (i > 0) pattern[k].push_back(k - n);
+        }
+    }
+    FEMatrixSparse *A = new FEMatrixSparse(N, N, &pattern, true);
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            k = i * n + j;
+            A->set(k, k, 4);
+            if (j > 0) A->set(k, k - 1, -1);
+            if (i > 0) A->set(k, k - n, -1);
+        }
+    }
+    return A;
+}
+
+void __test_amg_poisson_pcg() {
+    test_print_title("AMG", "test_amg_poisson_pcg");
+
+    // Each DOF is a block, near null space is the constant vector
+    int N = 40 * 40;
+    FEMatrixSparse *A = __test_amg_poisson(40);
+    std::vector<int> blocks(static_cast<unsigned long>(N));
+    FEMatrix *B = new FEMatrix(N, 1);
+    for (int i = 0; i < N; i++) {
+        blocks[i] = i;
+        B->set(i, 0, 1);
+    }
+    AMGPreconditioner *amg = new AMGPreconditioner();
+    assert(!amg->is_setup());
+    amg->set_coarse_size(20);
+    amg->setup(A, &blocks, B);
+    assert(amg->is_setup());
+    assert(amg->get_levels() > 2);
+    assert(amg->get_level_dimension(0) == N);
+    for (int l = 1; l < amg->get_levels(); l++) {
+        assert(amg->get_level_dimension(l) < amg->get_level_dimension(l - 1));
+    }
+    assert(amg->get_operator_complexity() > 1 && amg->get_operator_complexity() < 2);
+
+    // Solve using Jacobi and multigrid preconditioners
+    double *b = new double[N];
+    double *x = new double[N];
+    double *r = new double[N];
+    for (int i = 0; i < N; i++) {
+        b[i] = 1;
+        x[i] = 0;
+    }
+    PCGSolver *pcg = new PCGSolver();
+    pcg->solve(A, b, x);
+    int jacobi = pcg->get_iterations();
+    for (int i = 0; i < N; i++) {
+        x[i] = 0;
+    }
+    pcg->solve(N, [A](const double *v, double *y) { A->multiply(v, y); },
+               [amg](const double *v, double *z) { amg->apply(v, z); }, b, x);
+    assert(pcg->has_converged());
+    assert(pcg->get_iterations() < jacobi / 3);
+    (void) jacobi;
+
+    // Check residual
+    A->multiply(x, r);
+    double res = 0;
+    for (int i = 0; i < N; i++) {
+        res += (b[i] - r[i]) * (b[i] - r[i]);
+    }
+    assert(sqrt(res) < 1e-8 * sqrt(static_cast<double>(N)));
+
+    // Single level uses the direct solver
+    amg->set_max_levels(1);
+    amg->setup(A, &blocks, B);
+    assert(amg->get_levels() == 1);
+    amg->apply(b, x);
+    A->multiply(x, r);
+    for (int i = 0; i < N; i++) {
+        assert(fabs(b[i] - r[i]) < 1e-9);
+    }
+
+    // Invalid parameters
+    bool error = false;
+    try {
+        amg->set_strength_threshold(1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    error = false;
+    try {
+        amg->get_level_dimension(1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete[] b;
+    delete[] x;
+    delete[] r;
+    delete A;
+    delete B;
+    delete amg;
+    delete pcg;
+}
+
+/**
+ * Performs TEST-AMG tests.
+ */
+void test_amg_suite() {
+    __test_amg_poisson_pcg();
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+/**
+FNELEM-GPU - CONDITION ESTIMATE TEST
+Test 1-norm condition number estimate.
+
+@package test.math
+@author ppizarror
+@date 04/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/condition_estimate.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_factorization.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+#include "../../fnelem/math/fematrix_utils.h"
+
+/**
+ * Computes exact 1-norm condition number, the inverse is computed solving the identity.
+ *
+ * @param A Matrix
+ * @return
+ */
+double __test_condition_estimate_exact(FEMatrix *A) {
+    int *dim = A->size();
+    FEMatrixFactorization fact;
+    fact.lu(A);
+    FEMatrix *I = FEMatrix_identity(dim[0]);
+    FEMatrix *inv = fact.solve(I);
+    double cond = condition_norm1(A) * condition_norm1(inv);
+    delete[] dim;
+    delete I;
+    delete inv;
+    return cond;
+}
+
+void __test_condition_estimate_dense() {
+    test_print_title("CONDITION-ESTIMATE", "test_condition_estimate_dense");
+
+    // Diagonal matrix, estimate is exact
+    FEMatrix *D = new FEMatrix(10, 10);
+    for (int i = 0; i < 10; i++) D->set(i, i, i + 1);
+    assert(fabs(D->cond() - 10) < 1e-12);
+
+    // Non symmetric matrix, the estimate is a lower bound of the exact value
+    int n = 20;
+    FEMatrix *A = new FEMatrix(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) A->set(i, j, sin(1 + i * n + j));
+        A->set(i, i, A->get(i, i) + 0.5);
+    }
+    double exact = __test_condition_estimate_exact(A);
+    double est = A->cond();
+    assert(est <= exact * (1 + 1e-10));
+    assert(est >= exact / 3);
+    (void) est;
+
+    // Estimate only uses a few solves
+    FEMatrixFactorization *fact = new FEMatrixFactorization();
+    fact->lu(A);
+    int nsolves;
+    condition_inverse_norm1(n, [fact](double *x) { fact->solve(x, 1); },
+                            [fact](double *x) { fact->solve_transpose(x, 1); }, &nsolves);
+    assert(nsolves <= 2 * __CONDITION_ESTIMATE_MAX_ITERATIONS + 1);
+
+    // Transpose solve, A'*x = b
+    FEMatrix *b = FEMatrix_vector(n);
+    for (int i = 0; i < n; i++) b->set(i, i - 3);
+    double *x = b->get_array();
+    fact->solve_transpose(x, 1);
+    FEMatrix At = A->transpose();
+    FEMatrix *xt = FEMatrix_vector(n);
+    for (int i = 0; i < n; i++) xt->set(i, x[i]);
+    FEMatrix r = At * *xt;
+    r -= b;
+    assert(r.norm() < 1e-10 * b->norm());
+
+    // Ill conditioned Hilbert matrix
+    FEMatrix *H = new FEMatrix(6, 6);
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) H->set(i, j, 1.0 / (1 + i + j));
+    }
+    exact = __test_condition_estimate_exact(H);
+    assert(fabs(H->cond() - exact) < 1e-6 * exact);
+    (void) exact;
+
+    // Singular matrix
+    FEMatrix *S = new FEMatrix(3, 3);
+    S->fill_ones();
+    assert(std::isinf(S->cond()));
+
+    // Delete data
+    delete D;
+    delete A;
+    delete fact;
+    delete b;
+    delete[] x;
+    delete xt;
+    delete H;
+    delete S;
+}
+
+void __test_condition_estimate_sparse() {
+    test_print_title("CONDITION-ESTIMATE", "test_condition_estimate_sparse");
+
+    // Tridiagonal symmetric matrix, only lower triangle is stored
+    int n = 30;
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        pattern->at(i).push_back(i);
+        if (i > 0) pattern->at(i).push_back(i - 1);
+    }
+    FEMatrixSparse *K = new FEMatrixSparse(n, n, pattern, true);
+    for (int i = 0; i < n; i++) {
+        K->set(i, i, 2);
+        if (i > 0) K->set(i, i - 1, -1);
+    }
+    FEMatrix *Kd = K->to_dense();
+    assert(is_num_equal(condition_norm1(K), condition_norm1(Kd)));
+    assert(is_num_equal(condition_norm1(K), 4));
+
+    // Compare with the dense estimate
+    assert(fabs(Kd->cond() - __test_condition_estimate_exact(Kd)) < 1e-8 * Kd->cond());
+
+    // Invalid dimension
+    bool error = false;
+    try {
+        condition_inverse_norm1(0, [](double * /* x */) {}, nullptr, nullptr);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete pattern;
+    delete K;
+    delete Kd;
+}
+
+/**
+ * Performs TEST-CONDITION-ESTIMATE tests.
+ */
+void test_condition_estimate_suite() {
+    __test_condition_estimate_dense();
+    __test_condition_estimate_sparse();
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+FNELEM-GPU - ELEMENT OPERATOR TEST
+Test element by element operator products.
+
+@package test.math
+@author ppizarror
+@date 30/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/element_operator.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+
+void __test_element_operator_multiply() {
+    test_print_title("ELEMENT-OPERATOR", "test_element_operator_multiply");
+
+    // Chain of 2x2 springs, element e joins DOF e-1 and e, DOF -1 is restrained
+    int n = 10;
+    double block[4] = {2, -1, -1, 2};
+    ElementOperator *op = new ElementOperator(n);
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(n));
+    for (int e = 0; e < n; e++) {
+        int index[2] = {e - 1, e};
+        op->add_element(2, index, block);
+        pattern[e].push_back(e);
+        if (e > 0) pattern[e].push_back(e - 1);
+    }
+    assert(op->get_dimension() == n);
+    assert(op->get_number_elements() == n);
+    assert(op->get_number_values() == 4 * n);
+
+    // Assembled matrix
+    FEMatrixSparse *K = new FEMatrixSparse(n, n, &pattern, true);
+    for (int e = 0; e < n; e++) {
+        int index[2] = {e - 1, e};
+        K->assemble(2, index, block);
+    }
+    for (int i = 0; i < n; i++) {
+        assert(is_num_equal(op->get_diagonal()[i], K->get(i, i)));
+    }
+
+    // Compare products
+    double x[10], y[10], y_ebe[10];
+    for (int i = 0; i < n; i++) {
+        x[i] = 1.0 + 0.5 * i;
+    }
+    K->multiply(x, y);
+    op->multiply(x, y_ebe);
+    for (int i = 0; i < n; i++) {
+        assert(is_num_equal(y[i], y_ebe[i]));
+    }
+
+    // Parallel product, even and odd elements do not share DOF
+    ThreadPool *pool = new ThreadPool(4);
+    std::vector<std::vector<int>> colors(2);
+    for (int e = 0; e < n; e++) {
+        colors[e % 2].push_back(e);
+    }
+    op->set_parallel(colors, pool);
+    op->multiply(x, y_ebe);
+    for (int i = 0; i < n; i++) {
+        assert(is_num_equal(y[i], y_ebe[i]));
+    }
+
+    // Invalid element position
+    bool error = false;
+    try {
+        int index[2] = {0, n};
+        op->add_element(2, index, block);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete op;
+    delete pool;
+    delete K;
+}
+
+/**
+ * Performs TEST-ELEMENT-OPERATOR tests.
+ */
+void test_element_operator_suite() {
+    __test_element_operator_multiply();
+}
\ No newline at end of file
@@ -128,14 +128,12 @@ void __test_fematrix_substract() {
     m2->fill_ones();
     m2->set(0, 0, 3);
     m2->set(1, 1, 5);
-    FEMatrix *m3 = *m2 - *m1;
-    FEMatrix *m4 = -*m3;
-    assert(m3->get(0, 0) == 2);
-    assert(m4->get(0, 0) == -2);
+    FEMatrix m3 = *m2 - *m1;
+    FEMatrix m4 = -m3;
+    assert(m3.get(0, 0) == 2);
+    assert(m4.get(0, 0) == -2);
     delete m1;
     delete m2;
-    delete m3;
-    delete m4;
 }
 
 void __test_fematrix_transpose() {
@@ -272,39 +270,33 @@ void __test_fematrix_row_column() {
     m->disp();
 
     // Test row
-    FEMatrix *row1 = m->get_row(1, 1, 4); // [1, 2, 3, 4]
-    row1->disp();
-    assert(row1->get(1) == 1 && row1->get(2) == 2 && row1->get(3) == 3 && row1->get(4) == 4);
-    FEMatrix *row4 = m->get_row(4); // [13, 14, 15, 16]
-    row4->disp();
-    assert(row4->get(1) == 13 && row4->get(2) == 14 && row4->get(3) == 15 && row4->get(4) == 16);
-    FEMatrix *r = m->get_row(3, 2, 2); // [9, 10, 11, 12]
-    assert(r->get(1) == 10);
-
-    FEMatrix *r1 = m->get_row(3, 1, 3); // [9, 10, 11, 12]
-    r1->disp();
-    assert(r1->length() == 3);
+    FEMatrix row1 = m->get_row(1, 1, 4); // [1, 2, 3, 4]
+    row1.disp();
+    assert(row1.get(1) == 1 && row1.get(2) == 2 && row1.get(3) == 3 && row1.get(4) == 4);
+    FEMatrix row4 = m->get_row(4); // [13, 14, 15, 16]
+    row4.disp();
+    assert(row4.get(1) == 13 && row4.get(2) == 14 && row4.get(3) == 15 && row4.get(4) == 16);
+    FEMatrix r = m->get_row(3, 2, 2); // [9, 10, 11, 12]
+    assert(r.get(1) == 10);
+
+    FEMatrix r1 = m->get_row(3, 1, 3); // [9, 10, 11, 12]
+    r1.disp();
+    assert(r1.length() == 3);
 
     // Test column
-    FEMatrix *col1 = m->get_column(1); // [1, 5, 9, 13]
-    col1->disp();
-    assert(col1->length() == 4);
-    assert(col1->is_vector());
+    FEMatrix col1 = m->get_column(1); // [1, 5, 9, 13]
+    col1.disp();
+    assert(col1.length() == 4);
+    assert(col1.is_vector());
 
     // Test multipication
-    FEMatrix *colt = col1->transpose();
-    colt->disp();
-    *colt *= *col1;
-    assert(colt->get(1) == 1 + 5 * 5 + 9 * 9 + 13 * 13);
+    FEMatrix colt = col1.transpose();
+    colt.disp();
+    colt *= col1;
+    assert(colt.get(1) == 1 + 5 * 5 + 9 * 9 + 13 * 13);
 
     // Variable deletion
     delete m;
-    delete col1;
-    delete row1;
-    delete row4;
-    delete colt;
-    delete r;
-    delete r1;
 }
 
 void __test_fematrix_equal() {
@@ -370,32 +362,55 @@ void __test_fematrix_determinant() {
     mat4->set(4, 2, 5);
     mat4->set(4, 3, 7);
     mat4->set(4, 4, 3);
-    FEMatrix *mat4t = mat4->transpose();
+    FEMatrix mat4t = mat4->transpose();
     assert(is_num_equal(mat4->det(), -580));
-    assert(is_num_equal(mat4t->det(), -580));
+    assert(is_num_equal(mat4t.det(), -580));
 
     // Determinant of inverse [4x4]
     FEMatrix *imat4 = matrix_inverse_cpu(mat4);
     assert(is_num_equal(imat4->det(), -0.00172413793103448208));
 
     // Determinant of sum
-    FEMatrix *mat4s = *mat4 + *imat4;
-    assert(is_num_equal(mat4s->det(), -1451.98793103448247165943));
+    FEMatrix mat4s = *mat4 + *imat4;
+    assert(is_num_equal(mat4s.det(), -1451.98793103448247165943));
 
     // Determinant zero for a NxN ones matrix
     FEMatrix *mat_ones = new FEMatrix(10, 10);
     mat_ones->fill_ones();
     assert(is_num_equal(mat_ones->det(), 0));
 
+    // Log determinant keeps the sign apart
+    int sign;
+    assert(is_num_equal(mat4->log_det(&sign), log(580.0)));
+    assert(sign == -1);
+    assert(std::isinf(mat_ones->log_det(&sign)) && sign == 0);
+
+    // Small pivots are not singular
+    FEMatrix mat_small(2, 2);
+    mat_small.set(0, 0, 1);
+    mat_small.set(1, 1, 1e-15);
+    assert(mat_small.det() == 1e-15);
+    assert(is_num_equal(mat_small.log_det(&sign), log(1e-15)));
+    assert(sign == 1);
+
+    // Large diagonal matrix, determinant overflows but log determinant does not
+    FEMatrix *mat_big = new FEMatrix(400, 400);
+    for (int i = 0; i < 400; i++) {
+        mat_big->set(i, i, 10);
+    }
+    assert(std::isinf(mat_big->det()));
+    assert(fabs(mat_big->log_det(&sign) - 400 * log(10.0)) < 1e-12 * 400 * log(10.0));
+    assert(sign == 1);
+    (void) sign;
+
     // Destroy variables
     delete mat1;
     delete mat2;
     delete mat3;
     delete mat4;
-    delete mat4t;
     delete imat4;
-    delete mat4s;
     delete mat_ones;
+    delete mat_big;
 }
 
 void __test_fematrix_norm() {
@@ -445,6 +460,81 @@ void __test_fematrix_double_equal() {
     delete mat;
 }
 
+void __test_fematrix_value_semantics() {
+    test_print_title("FEMATRIX", "test_fematrix_value_semantics");
+    FEMatrix a(3, 4);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) a.set(i, j, i + 2 * j);
+    }
+
+    // Copy is independent, move takes the storage
+    FEMatrix b(a);
+    b.set(0, 0, 10);
+    assert(a.get(0, 0) == 0 && b.get(0, 0) == 10);
+    const double *data = b.get_data();
+    FEMatrix c(std::move(b));
+    assert(c.get_data() == data && c.get(0, 0) == 10);
+    c = a;
+    assert(c == a);
+
+    // Empty and moved from matrices can be assigned
+    FEMatrix e(std::move(c));
+    c = FEMatrix();
+    assert(c.rows() == 0 && c.columns() == 0);
+    FEMatrix d = a;
+    d = c;
+    assert(d.rows() == 0 && d.columns() == 0);
+    d = e;
+    assert(d == a);
+    FEMatrix g(std::move(d));
+    FEMatrix f(d);
+    f = a;
+    f = d;
+    assert(f.rows() == 0 && f.columns() == 0);
+    c = a;
+
+    // Products and sums by value
+    FEMatrix at = a.transpose();
+    FEMatrix p = a * at;
+    FEMatrix q = a * at + a * at * 2;
+    assert(p.get_square_dimension() == 3);
+    assert(q.get(2, 1) == 3 * p.get(2, 1));
+    FEMatrix np = -p;
+    assert(np.get(1, 1) == -p.get(1, 1));
+
+    // Output matrices are reused once they have enough storage
+    FEMatrix r;
+    a.multiply(at, r);
+    data = r.get_data();
+    assert(r == p);
+    for (int k = 0; k < 5; k++) {
+        a.multiply(at, r);
+        r.add(p, r);
+        a.transpose(at);
+        a.get_row(1, at);
+        a.get_column(2, at);
+        a.transpose(at);
+    }
+    assert(r.get_data() == data);
+    assert(r.get(2, 1) == 2 * p.get(2, 1));
+    (void) data;
+    r.subtract(p, r);
+    assert(r == p);
+    FEMatrix row;
+    a.get_row(2, row);
+    assert(row.length() == 4 && row.get(3) == a.get(2, 3));
+
+    // Result can not be an operand of the product
+    bool error = false;
+    try {
+        a.multiply(at, a);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+}
+
 void test_fematrix_suite() {
     __test_fematrix_init();
     __test_fematrix_disp();
@@ -464,4 +554,5 @@ void test_fematrix_suite() {
     __test_fematrix_norm();
     __test_fematrix_diagonal();
     __test_fematrix_double_equal();
+    __test_fematrix_value_semantics();
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+/**
+FNELEM-GPU - FEMATRIX EXPRESSION TEST
+Test lazily evaluated matrix expressions.
+
+@package test.math
+@author ppizarror
+@date 06/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_expression.h"
+
+void __test_fematrix_expression_element() {
+    test_print_title("FEMATRIX-EXPRESSION", "test_fematrix_expression_element");
+    FEMatrix a(4, 3), b(4, 3);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            a.set(i, j, i - j);
+            b.set(i, j, i * j + 1);
+        }
+    }
+
+    // Sum, difference, scale and negation in one loop
+    FEMatrix c = 2 * a + b * 0.5 - (-a);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            assert(is_num_equal(c.get(i, j), 3 * a.get(i, j) + 0.5 * b.get(i, j)));
+        }
+    }
+
+    // Lazy transpose
+    FEMatrix at = FEMatrix_transpose(a + b);
+    assert(at.rows() == 3 && at.columns() == 4);
+    assert(at.get(2, 1) == a.get(1, 2) + b.get(1, 2));
+
+    // Dimension must agree
+    bool error = false;
+    try {
+        FEMatrix d = a + at;
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+}
+
+void __test_fematrix_expression_product() {
+    test_print_title("FEMATRIX-EXPRESSION", "test_fematrix_expression_product");
+
+    // Element stiffness B'DB, compared with the eager product
+    FEMatrix B(3, 8), D(3, 3);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 8; j++) B.set(i, j, sin(1.0 + i * 8 + j));
+        for (int j = 0; j < 3; j++) D.set(i, j, 1.0 / (1 + i + j));
+    }
+    FEMatrix K = FEMatrix_transpose(B) * D * B;
+    FEMatrix Bt = B.transpose();
+    FEMatrix BtD;
+    Bt.multiply(D, BtD);
+    FEMatrix Ke;
+    BtD.multiply(B, Ke);
+    assert(K.rows() == 8 && K.columns() == 8);
+    assert(K.is_symmetric());
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            assert(is_num_equal(K.get(i, j), Ke.get(i, j)));
+        }
+    }
+
+    // Axpy, y = a * x + y, reuses the storage of y
+    FEMatrix x(5, 1), y(5, 1), z(5, 1);
+    for (int i = 0; i < 5; i++) {
+        x.set(i, i + 1);
+        y.set(i, 2 * i);
+    }
+    const double *data = y.get_data();
+    y += 3 * x;
+    assert(y.get_data() == data);
+    assert(y.get(4) == 23);
+    data = z.get_data();
+    z = y - x * 2;
+    assert(z.get_data() == data);
+    assert(z.get(4) == 13);
+    y = z;
+
+    // Product that reads the result is evaluated in a new matrix
+    FEMatrix A(5, 5);
+    for (int i = 0; i < 5; i++) A.set(i, i, i + 1);
+    y = A * y;
+    assert(y.get(4) == 65 && y.get(0) == 1);
+    y += A * y;
+    assert(y.get(0) == 2);
+
+    // Product of two matrices uses the blocked multiplication, storage is reused
+    FEMatrix G(40, 30), H(30, 20), P, Q;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 30; j++) {
+            G.set(i, j, sin(1.0 + i * 30 + j));
+            if (i < 20) H.set(j, i, cos(2.0 + j * 20 + i));
+        }
+    }
+    G.multiply(H, P);
+    Q = G * H;
+    assert(Q == P);
+    data = Q.get_data();
+    Q = G * H;
+    assert(Q.get_data() == data);
+    (void) data;
+    FEMatrix R = G * H;
+    assert(R == P);
+
+    // Product dimension must agree
+    bool error = false;
+    try {
+        FEMatrix z = x * A;
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+}
+
+/**
+ * Performs TEST-FEMATRIX-EXPRESSION tests.
+ */
+void test_fematrix_expression_suite() {
+    __test_fematrix_expression_element();
+    __test_fematrix_expression_product();
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+/**
+FNELEM-GPU - FEMATRIX FACTORIZATION TEST
+Test dense blocked LU and Cholesky factorizations.
+
+@package test.math
+@author ppizarror
+@date 29/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_factorization.h"
+#include "../../fnelem/math/fematrix_utils.h"
+
+/**
+ * Creates a n*n matrix, symmetric positive definite if requested.
+ *
+ * @param n Dimension
+ * @param symmetric Symmetric positive definite
+ * @return
+ */
+FEMatrix *__test_fematrix_factorization_matrix(int n, bool symmetric) {
+    FEMatrix *mat = new FEMatrix(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (symmetric) {
+                mat->set(i, j, 1.0 / (1 + i + j));
+            } else {
+                mat->set(i, j, sin(1 + i * n + j));
+            }
+        }
+        mat->set(i, i, mat->get(i, i) + (symmetric ? 1 : 0.1));
+    }
+    return mat;
+}
+
+/**
+ * Returns the relative residual norm of A*X = B.
+ *
+ * @param A Matrix
+ * @param x Solution
+ * @param b Right hand side
+ * @return
+ */
+double __test_fematrix_factorization_residual(FEMatrix *A, FEMatrix *x, FEMatrix *b) {
+    FEMatrix r = *A * *x;
+    r -= b;
+    double *rv = r.get_array();
+    double *bv = b->get_array();
+    int *dim = b->size();
+    double rnorm = 0, bnorm = 0;
+    for (int k = 0; k < dim[0] * dim[1]; k++) {
+        rnorm += rv[k] * rv[k];
+        bnorm += bv[k] * bv[k];
+    }
+    delete[] rv;
+    delete[] bv;
+    delete[] dim;
+    return sqrt(rnorm / bnorm);
+}
+
+void __test_fematrix_factorization_lu() {
+    test_print_title("FEMATRIX-FACTORIZATION", "test_fematrix_factorization_lu");
+
+    // Several blocks, last one incomplete
+    FEMatrix *A = __test_fematrix_factorization_matrix(23, false);
+    FEMatrixFactorization *fact = new FEMatrixFactorization();
+    fact->set_block_size(5);
+    fact->lu(A);
+    assert(fact->is_factorized());
+    assert(fact->get_type() == FEMATRIX_FACTORIZATION_LU);
+    assert(fact->get_dimension() == 23);
+
+    // Vector right hand side
+    FEMatrix *b = FEMatrix_vector(23);
+    b->fill_ones();
+    FEMatrix *x = fact->solve(b);
+    assert(__test_fematrix_factorization_residual(A, x, b) < 1e-10);
+
+    // Same solution without blocking
+    FEMatrixFactorization *fact1 = new FEMatrixFactorization();
+    fact1->set_block_size(100);
+    fact1->lu(A);
+    FEMatrix *x1 = fact1->solve(b);
+    FEMatrix dx = *x - *x1;
+    assert(dx.norm() < 1e-10 * x->norm());
+
+    // Determinant from the factors
+    int sign, sign1;
+    double logdet = fact->log_det(&sign);
+    assert(fabs(logdet - A->log_det(&sign1)) < 1e-10 * fabs(logdet));
+    assert(sign == sign1);
+    assert(fabs(fact->det() - A->det()) < 1e-10 * fabs(A->det()));
+    (void) logdet;
+    (void) sign1;
+
+    // Multiple right hand sides
+    FEMatrix *B = new FEMatrix(23, 3);
+    for (int i = 0; i < 23; i++) {
+        for (int j = 0; j < 3; j++) B->set(i, j, i - j);
+    }
+    FEMatrix *X = fact->solve(B);
+    assert(__test_fematrix_factorization_residual(A, X, B) < 1e-10);
+
+    // Singular matrix
+    FEMatrix *S = new FEMatrix(3, 3);
+    S->fill_ones();
+    bool error = false;
+    try {
+        fact->lu(S);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    assert(!fact->is_factorized());
+    (void) error;
+
+    // Delete data
+    delete A;
+    delete b;
+    delete x;
+    delete x1;
+    delete B;
+    delete X;
+    delete S;
+    delete fact;
+    delete fact1;
+}
+
+void __test_fematrix_factorization_cholesky() {
+    test_print_title("FEMATRIX-FACTORIZATION", "test_fematrix_factorization_cholesky");
+
+    // Factorize using several blocks
+    FEMatrix *A = __test_fematrix_factorization_matrix(30, true);
+    FEMatrixFactorization *fact = new FEMatrixFactorization();
+    fact->set_block_size(4);
+    fact->cholesky(A);
+    assert(fact->get_type() == FEMATRIX_FACTORIZATION_CHOLESKY);
+
+    // Solve and compare with LU
+    FEMatrix *b = FEMatrix_vector(30);
+    for (int i = 0; i < 30; i++) b->set(i, 1 + i % 5);
+    FEMatrix *x = fact->solve(b);
+    assert(__test_fematrix_factorization_residual(A, x, b) < 1e-10);
+    fact->lu(A);
+    FEMatrix *xlu = fact->solve(b);
+    FEMatrix dx = *x - *xlu;
+    assert(dx.norm() < 1e-8 * x->norm());
+
+    // Cholesky determinant is positive and equals the LU one
+    int sign;
+    double logdet = fact->log_det(&sign);
+    fact->cholesky(A);
+    assert(fabs(fact->log_det(&sign) - logdet) < 1e-10 * fabs(logdet));
+    assert(sign == 1);
+    (void) logdet;
+
+    // Not positive definite
+    FEMatrix *N = FEMatrix_identity(3);
+    N->set(1, 1, -1);
+    bool error = false;
+    try {
+        fact->cholesky(N);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete A;
+    delete b;
+    delete x;
+    delete xlu;
+    delete N;
+    delete fact;
+}
+
+/**
+ * Performs TEST-FEMATRIX-FACTORIZATION tests.
+ */
+void test_fematrix_factorization_suite() {
+    __test_fematrix_factorization_lu();
+    __test_fematrix_factorization_cholesky();
+}
\ No newline at end of file
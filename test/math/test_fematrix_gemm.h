@@ -0,0 +1,154 @@
+/**
+FNELEM-GPU - MATRIX MULTIPLICATION TEST
+Test blocked matrix product kernels.
+
+@package test.math
+@author ppizarror
+@date 08/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_gemm.h"
+#include "../../fnelem/math/thread_pool.h"
+
+/**
+ * Compares the product of matrix multiplication with the naive triple loop.
+ *
+ * @param n Rows of A
+ * @param k Columns of A
+ * @param m Columns of B
+ * @param pool Thread pool
+ */
+void __test_fematrix_gemm_compare(int n, int k, int m, ThreadPool *pool) {
+    std::vector<double> A(static_cast<unsigned long>(n * k)), B(static_cast<unsigned long>(k * m));
+    std::vector<double> C(static_cast<unsigned long>(n * m)), D(static_cast<unsigned long>(n * m));
+    for (int i = 0; i < n * k; i++) A[i] = sin(1.0 + i);
+    for (int i = 0; i < k * m; i++) B[i] = cos(2.0 + 3 * i);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            double sum = 0;
+            for (int p = 0; p < k; p++) sum += A[i * k + p] * B[p * m + j];
+            D[i * m + j] = sum;
+        }
+    }
+    fematrix_gemm(A.data(), B.data(), C.data(), n, k, m, pool);
+    for (int i = 0; i < n * m; i++) {
+        assert(fabs(C[i] - D[i]) < 1e-10);
+    }
+}
+
+void __test_fematrix_gemm_kernels() {
+    test_print_title("FEMATRIX-GEMM", "test_fematrix_gemm_kernels");
+    int kernel = fematrix_gemm_get_kernel();
+    assert(fematrix_gemm_kernel_supported(kernel));
+    assert(fematrix_gemm_kernel_supported(FEMATRIX_GEMM_KERNEL_SCALAR));
+    std::cout << "\tDetected kernel: " << fematrix_gemm_kernel_name(kernel) << std::endl;
+
+    // Every supported kernel over odd dimensions, narrow products and several depth blocks
+    ThreadPool pool(3);
+    int dims[][3] = {{1, 1, 1}, {7, 5, 3}, {17, 19, 23}, {33, 300, 9}, {61, 47, 2}, {100, 60, 37}, {130, 270, 150}};
+    for (int kern = FEMATRIX_GEMM_KERNEL_SCALAR; kern <= FEMATRIX_GEMM_KERNEL_AVX512; kern++) {
+        if (!fematrix_gemm_kernel_supported(kern)) {
+            bool error = false;
+            try {
+                fematrix_gemm_set_kernel(kern);
+            } catch (const std::logic_error &e) {
+                error = true;
+            }
+            assert(error);
+            (void) error;
+            continue;
+        }
+        fematrix_gemm_set_kernel(kern);
+        assert(fematrix_gemm_get_kernel() == kern);
+        for (auto &d : dims) {
+            __test_fematrix_gemm_compare(d[0], d[1], d[2], nullptr);
+            __test_fematrix_gemm_compare(d[0], d[1], d[2], &pool);
+        }
+    }
+    bool error = false;
+    try {
+        fematrix_gemm_set_kernel(-1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+    fematrix_gemm_set_kernel(kernel);
+}
+
+void __test_fematrix_gemm_product() {
+    test_print_title("FEMATRIX-GEMM", "test_fematrix_gemm_product");
+    FEMatrix A(40, 40), F(40, 2), u;
+    for (int i = 0; i < 40; i++) {
+        A.set(i, i, 2);
+        if (i > 0) A.set(i, i - 1, -1);
+        F.set(i, 0, 1);
+        F.set(i, 1, i);
+    }
+
+    // Threaded product gives the same result
+    ThreadPool pool(2);
+    A.multiply(F, u);
+    FEMatrix ut;
+    A.multiply(F, ut, &pool);
+    assert(u.equals(&ut));
+    assert(u.get(0, 0) == 2 && u.get(5, 0) == 1 && u.get(5, 1) == 6);
+
+    // Self product
+    FEMatrix B = A;
+    B *= A;
+    B *= A;
+    B *= A;
+    FEMatrix C = A * A * A * A;
+    assert(B.equals(&C));
+    B *= F;
+    assert(B.rows() == 40 && B.columns() == 2);
+
+    // Narrow product longer than a packed block of B
+    int k = 3 * __FEMATRIX_GEMM_KC + 5;
+    FEMatrix D(6, k), v(k, 1), w;
+    for (int p = 0; p < k; p++) {
+        D.set(0, p, 1);
+        D.set(1, p, p % 7);
+        D.set(2, p, -0.5);
+        v.set(p, 0, 2);
+    }
+    D.multiply(v, w);
+    double sum = 0;
+    for (int p = 0; p < k; p++) {
+        sum += 2 * (p % 7);
+    }
+    assert(w.get(0, 0) == 2 * k && w.get(1, 0) == sum && w.get(2, 0) == -k && w.get(5, 0) == 0);
+}
+
+/**
+ * Performs TEST-FEMATRIX-GEMM tests.
+ */
+void test_fematrix_gemm_suite() {
+    __test_fematrix_gemm_kernels();
+    __test_fematrix_gemm_product();
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+FNELEM-GPU - FEMATRIX SKYLINE TEST
+Test skyline matrix and in place factorization.
+
+@package test.math
+@author ppizarror
+@date 28/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_skyline.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+#include "../../fnelem/math/fematrix_utils.h"
+
+/**
+ * Creates a symmetric positive definite matrix with a variable band, row i is coupled with
+ * the previous (i % 4) rows.
+ *
+ * @param n Dimension
+ * @return
+ */
+FEMatrixSparse *__test_fematrix_skyline_banded(int n) {
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        for (int j = std::max(0, i - i % 4); j <= i; j++) {
+            pattern->at(i).push_back(j);
+        }
+    }
+    FEMatrixSparse *mat = new FEMatrixSparse(n, n, pattern, true);
+    for (int i = 0; i < n; i++) {
+        for (int j = std::max(0, i - i % 4); j < i; j++) {
+            mat->set(i, j, -1.0 / (1 + i - j));
+        }
+        mat->set(i, i, 5 + i);
+    }
+    delete pattern;
+    return mat;
+}
+
+void __test_fematrix_skyline_storage() {
+    test_print_title("FEMATRIX-SKYLINE", "test_fematrix_skyline_storage");
+
+    // Create from sparse matrix
+    FEMatrixSparse *mat = __test_fematrix_skyline_banded(10);
+    FEMatrixSkyline *sky = new FEMatrixSkyline(mat);
+    sky->disp();
+    assert(sky->get_dimension() == 10);
+    assert(sky->get_bandwidth() == 3);
+    assert(sky->get_profile() == mat->get_nnz() - 10);
+    assert(is_num_equal(sky->get(3, 1), -1.0 / 3));
+    assert(is_num_equal(sky->get(1, 3), -1.0 / 3));
+    assert(is_num_equal(sky->get(4, 3), 0)); // Outside envelope
+
+    // Dense representation and product
+    FEMatrix *dense = sky->to_dense();
+    FEMatrix *dense_sparse = mat->to_dense();
+    assert(dense->equals(dense_sparse));
+    double *x = new double[10];
+    double *y1 = new double[10];
+    double *y2 = new double[10];
+    for (int i = 0; i < 10; i++) x[i] = i + 1;
+    sky->multiply(x, y1);
+    mat->multiply(x, y2);
+    for (int i = 0; i < 10; i++) assert(is_num_equal(y1[i], y2[i]));
+
+    // Values outside the envelope cannot be set
+    bool error = false;
+    try {
+        sky->add(4, 3, 1);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Create from first column
+    int first[3] = {0, 0, 2};
+    FEMatrixSkyline *sky2 = new FEMatrixSkyline(3, first);
+    assert(sky2->get_nvalues() == 4);
+    sky2->set(1, 0, 2);
+    sky2->add(0, 1, 1);
+    assert(is_num_equal(sky2->get(1, 0), 3));
+
+    // Delete data
+    delete mat;
+    delete sky;
+    delete sky2;
+    delete dense;
+    delete dense_sparse;
+    delete[] x;
+    delete[] y1;
+    delete[] y2;
+}
+
+void __test_fematrix_skyline_solve() {
+    test_print_title("FEMATRIX-SKYLINE", "test_fematrix_skyline_solve");
+
+    // Factorize in place
+    FEMatrixSparse *mat = __test_fematrix_skyline_banded(40);
+    FEMatrixSkyline *sky = new FEMatrixSkyline(mat);
+    sky->factorize();
+    assert(sky->is_factorized());
+
+    // Solve and check residual
+    FEMatrix *b = FEMatrix_vector(40);
+    for (int i = 0; i < 40; i++) b->set(i, 1 + i % 3);
+    FEMatrix *x = sky->solve(b);
+    FEMatrix *r = *mat * *x;
+    *r -= b;
+    assert(r->norm() < 1e-10 * b->norm());
+
+    // Determinant from the factors equals the dense one
+    FEMatrix *dense = mat->to_dense();
+    int sign, sign1;
+    double logdet = sky->log_det(&sign);
+    assert(fabs(logdet - dense->log_det(&sign1)) < 1e-10 * fabs(logdet));
+    assert(sign == sign1);
+    (void) logdet;
+    (void) sign1;
+
+    // Matrix cannot be factorized twice
+    bool error = false;
+    try {
+        sky->factorize();
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+
+    // Singular matrix
+    int first[2] = {0, 0};
+    FEMatrixSkyline *sing = new FEMatrixSkyline(2, first);
+    sing->set(0, 0, 1);
+    sing->set(1, 0, 1);
+    sing->set(1, 1, 1);
+    error = false;
+    try {
+        sing->factorize();
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete mat;
+    delete sky;
+    delete sing;
+    delete dense;
+    delete b;
+    delete x;
+    delete r;
+}
+
+/**
+ * Performs TEST-FEMATRIX-SKYLINE tests.
+ */
+void test_fematrix_skyline_suite() {
+    __test_fematrix_skyline_storage();
+    __test_fematrix_skyline_solve();
+}
\ No newline at end of file
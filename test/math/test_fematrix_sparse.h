@@ -0,0 +1,134 @@
+/**
+FNELEM-GPU - FEMATRIX SPARSE TEST
+Test FEMatrixSparse class.
+
+@package test.math
+@author ppizarror
+@date 24/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+
+void __test_fematrix_sparse_init() {
+    test_print_title("FEMATRIX-SPARSE", "test_fematrix_sparse_init");
+
+    // Tridiagonal pattern, repeated and upper indices are removed
+    int n = 4;
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(4);
+    for (int i = 0; i < n; i++) {
+        pattern->at(i).push_back(i);
+        pattern->at(i).push_back(i);
+        if (i > 0) pattern->at(i).push_back(i - 1);
+        if (i < n - 1) pattern->at(i).push_back(i + 1);
+    }
+    FEMatrixSparse *mat = new FEMatrixSparse(n, n, pattern, true);
+    assert(mat->get_nnz() == 2 * n - 1);
+    assert(mat->is_symmetric());
+    assert(mat->get_square_dimension() == n);
+
+    // Set values
+    for (int i = 0; i < n; i++) {
+        mat->set(i, i, 2);
+        if (i > 0) mat->add(i, i - 1, -1);
+    }
+    assert(mat->get(1, 0) == -1);
+    assert(mat->get(0, 1) == -1);
+    assert(mat->get(0, 3) == 0);
+    mat->disp();
+
+    // Dense matrix must be symmetric
+    FEMatrix *dense = mat->to_dense();
+    assert(dense->is_symmetric());
+    assert(dense->sum() == 2 * n - 2 * (n - 1));
+
+    // Position out of pattern
+    bool err = false;
+    try {
+        mat->set(3, 0, 1);
+    } catch (const std::logic_error &e) {
+        err = true;
+    }
+    assert(err);
+    (void) err;
+
+    delete pattern;
+    delete dense;
+    delete mat;
+}
+
+void __test_fematrix_sparse_multiplication() {
+    test_print_title("FEMATRIX-SPARSE", "test_fematrix_sparse_multiplication");
+
+    // Full symmetric pattern
+    int n = 3;
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(3);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            pattern->at(i).push_back(j);
+        }
+    }
+    FEMatrixSparse *mat = new FEMatrixSparse(n, n, pattern, true);
+    mat->set(0, 0, 4);
+    mat->set(1, 0, 1);
+    mat->set(1, 1, 3);
+    mat->set(2, 0, 2);
+    mat->set(2, 1, 5);
+    mat->set(2, 2, 6);
+
+    // Compare against dense product
+    FEMatrix *x = new FEMatrix(n, 2);
+    x->set(0, 0, 1);
+    x->set(1, 0, 2);
+    x->set(2, 0, 3);
+    x->set(0, 1, -1);
+    x->set(2, 1, 1);
+    FEMatrix *dense = mat->to_dense();
+    FEMatrix *y = *mat * *x;
+    FEMatrix yd = *dense * *x;
+    assert(y->equals(&yd));
+    assert(y->get(0, 0) == 12);
+
+    // Clone keeps values
+    FEMatrixSparse *matc = mat->clone();
+    assert(matc->get(2, 1) == 5);
+    assert(matc->get_nnz() == mat->get_nnz());
+
+    delete pattern;
+    delete mat;
+    delete matc;
+    delete x;
+    delete y;
+    delete dense;
+}
+
+/**
+ * Performs TEST-FEMATRIX-SPARSE tests.
+ */
+void test_fematrix_sparse_suite() {
+    __test_fematrix_sparse_init();
+    __test_fematrix_sparse_multiplication();
+}
\ No newline at end of file
@@ -37,12 +37,11 @@ void __test_fematrix_utils_identity() {
     test_print_title("FEMATRIX-UTILS", "test_fematrix_utils_identity");
     int n = 5;
     FEMatrix *i = FEMatrix_identity(n);
-    FEMatrix *it = i->transpose();
+    FEMatrix it = i->transpose();
     assert(i->is_diag());
     assert(i->sum() == n);
-    assert(it->equals(i));
+    assert(it.equals(i));
     delete i;
-    delete it;
 }
 
 void __test_fematrix_utils_vector() {
@@ -0,0 +1,112 @@
+/**
+FNELEM-GPU - FIXED MATRIX TEST
+Test matrices with dimensions known at compile time.
+
+@package test.math
+@author ppizarror
+@date 07/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fixed_matrix.h"
+
+void __test_fixed_matrix_init() {
+    test_print_title("FIXED-MATRIX", "test_fixed_matrix_init");
+
+    // Dimensions are known at compile time, values are stored in the object
+    static_assert(FixedMatrix<3, 8>::rows() == 3 && FixedMatrix<3, 8>::columns() == 8, "Invalid dimension");
+    assert(sizeof(FixedMatrix<8, 8>) == 64 * sizeof(double));
+    FixedMatrix<3, 8> B;
+    for (int k = 0; k < 24; k++) {
+        assert(B.get_data()[k] == 0);
+    }
+    B.set(2, 7, 5);
+    B(1, 3) = -2;
+    assert(B.get(2, 7) == 5 && B(1, 3) == -2);
+    B.fill(1);
+    assert(B.get(0, 0) == 1 && B.get(2, 7) == 1);
+
+    // Copy to a dynamic matrix
+    FEMatrix *Bd = B.to_fematrix();
+    assert(Bd->rows() == 3 && Bd->columns() == 8);
+    assert(Bd->sum() == 24);
+    delete Bd;
+}
+
+void __test_fixed_matrix_operations() {
+    test_print_title("FIXED-MATRIX", "test_fixed_matrix_operations");
+    FixedMatrix<3, 8> B;
+    FixedMatrix<3, 3> D;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 8; j++) B.set(i, j, sin(1.0 + i * 8 + j));
+        for (int j = 0; j < 3; j++) D.set(i, j, 1.0 / (1 + i + j));
+    }
+
+    // Element stiffness B'DB, compared with the dynamic matrix
+    FixedMatrix<8, 8> K = B.transpose() * D * B;
+    FEMatrix Bd, Dd, Kd;
+    B.to_fematrix(Bd);
+    D.to_fematrix(Dd);
+    Kd = FEMatrix_transpose(Bd) * Dd * Bd;
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            assert(is_num_equal(K(i, j), Kd.get(i, j)));
+        }
+    }
+
+    // Sum, difference and constant
+    FixedMatrix<8, 8> K2 = K + K * 2 - K;
+    assert(is_num_equal(K2(5, 2), 2 * K(5, 2)));
+    K2 -= K;
+    K2 *= 3;
+    assert(is_num_equal(K2(5, 2), 3 * K(5, 2)));
+
+    // Symmetric from upper triangle
+    FixedMatrix<3, 3> S;
+    S.set(0, 1, 2);
+    S.set(0, 2, 3);
+    S.set(1, 2, 4);
+    S.make_symmetric();
+    assert(S(1, 0) == 2 && S(2, 0) == 3 && S(2, 1) == 4);
+
+    // Storage of the dynamic matrix is reused
+    FEMatrix v(8, 1);
+    const double *data = v.get_data();
+    FixedMatrix<8, 1> x;
+    x.fill(1);
+    (K * x).to_fematrix(v);
+    assert(v.get_data() == data);
+    assert(is_num_equal(v.get(3), K(3, 0) + K(3, 1) + K(3, 2) + K(3, 3) + K(3, 4) + K(3, 5) + K(3, 6) + K(3, 7)));
+    (void) data;
+}
+
+/**
+ * Performs TEST-FIXED-MATRIX tests.
+ */
+void test_fixed_matrix_suite() {
+    __test_fixed_matrix_init();
+    __test_fixed_matrix_operations();
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+FNELEM-GPU - GEOMETRIC MULTIGRID TEST
+Test geometric multigrid preconditioner.
+
+@package test.math
+@author ppizarror
+@date 31/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/gmg.h"
+#include "../../fnelem/math/pcg.h"
+
+void __test_gmg_poisson_pcg() {
+    test_print_title("GMG", "test_gmg_poisson_pcg");
+
+    // Interior nodes of a 41x41 grid, boundary nodes are restrained
+    int n = 39, N = n * n;
+    FEMatrixSparse *A = __test_amg_poisson(n);
+    std::vector<double> x, y;
+    for (int i = 0; i < n + 2; i++) {
+        x.push_back(i);
+        y.push_back(0.5 * i);
+    }
+    std::vector<int> dof(static_cast<unsigned long>((n + 2) * (n + 2)), -1);
+    for (int j = 1; j <= n; j++) {
+        for (int i = 1; i <= n; i++) {
+            dof[j * (n + 2) + i] = (j - 1) * n + (i - 1);
+        }
+    }
+    GMGPreconditioner *gmg = new GMGPreconditioner();
+    gmg->set_coarse_size(10);
+    gmg->setup(A, &x, &y, &dof);
+    assert(gmg->get_levels() == 5); // 39, 19, 9, 4 and 2 interior lines
+    assert(gmg->get_level_dimension(1) == 19 * 19);
+    assert(gmg->get_level_dimension(4) == 2 * 2);
+
+    // Solve using Jacobi and multigrid preconditioners
+    double *b = new double[N];
+    double *u = new double[N];
+    double *r = new double[N];
+    for (int i = 0; i < N; i++) {
+        b[i] = 1;
+        u[i] = 0;
+    }
+    PCGSolver *pcg = new PCGSolver();
+    pcg->solve(A, b, u);
+    int jacobi = pcg->get_iterations();
+    for (int i = 0; i < N; i++) {
+        u[i] = 0;
+    }
+    pcg->solve(N, [A](const double *v, double *w) { A->multiply(v, w); },
+               [gmg](const double *v, double *z) { gmg->apply(v, z); }, b, u);
+    assert(pcg->has_converged());
+    assert(pcg->get_iterations() < jacobi / 5);
+    (void) jacobi;
+    A->multiply(u, r);
+    double res = 0;
+    for (int i = 0; i < N; i++) {
+        res += (b[i] - r[i]) * (b[i] - r[i]);
+    }
+    assert(sqrt(res) < 1e-8 * sqrt(static_cast<double>(N)));
+
+    // Grid DOF must cover the matrix
+    dof[n + 3] = -1;
+    bool error = false;
+    try {
+        gmg->setup(A, &x, &y, &dof);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete[] b;
+    delete[] u;
+    delete[] r;
+    delete A;
+    delete gmg;
+    delete pcg;
+}
+
+/**
+ * Performs TEST-GMG tests.
+ */
+void test_gmg_suite() {
+    __test_gmg_poisson_pcg();
+}
\ No newline at end of file
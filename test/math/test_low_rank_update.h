@@ -0,0 +1,153 @@
+/**
+FNELEM-GPU - LOW-RANK UPDATE TEST
+Test Sherman-Morrison-Woodbury update of a factorized matrix.
+
+@package test.math
+@author ppizarror
+@date 04/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_factorization.h"
+#include "../../fnelem/math/fematrix_utils.h"
+#include "../../fnelem/math/low_rank_update.h"
+
+void __test_low_rank_update_solve() {
+    test_print_title("LOW-RANK-UPDATE", "test_low_rank_update_solve");
+
+    // Factorize symmetric positive definite matrix
+    int n = 20;
+    FEMatrix *A = new FEMatrix(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) A->set(i, j, 1.0 / (1 + i + j));
+        A->set(i, i, A->get(i, i) + 1);
+    }
+    FEMatrixFactorization *fact = new FEMatrixFactorization();
+    fact->cholesky(A);
+
+    // Update three rows and columns
+    std::vector<int> rows = {3, 7, 12};
+    double delta[9] = {2.0, 0.5, 0, 0.5, -0.3, 0.1, 0, 0.1, 1.5};
+    LowRankUpdate *update = new LowRankUpdate();
+    update->update(n, rows, delta, [fact](double *x, int nrhs) { fact->solve(x, nrhs); });
+    assert(update->is_active());
+    assert(update->get_rank() == 3);
+
+    // Updated matrix is factorized to compare
+    FEMatrix *Au = A->clone();
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            Au->set(rows[i], rows[j], Au->get(rows[i], rows[j]) + delta[i * 3 + j]);
+        }
+    }
+    FEMatrixFactorization *fact_u = new FEMatrixFactorization();
+    fact_u->lu(Au);
+
+    // Two right hand sides, original solution is corrected
+    FEMatrix *b = new FEMatrix(n, 2);
+    for (int i = 0; i < n; i++) {
+        b->set(i, 0, 1);
+        b->set(i, 1, i - 5);
+    }
+    FEMatrix *x = fact->solve(b);
+    double *xu = x->get_array();
+    update->solve(xu, 2);
+    FEMatrix *x_exact = fact_u->solve(b);
+    for (int i = 0; i < n; i++) {
+        for (int r = 0; r < 2; r++) {
+            assert(fabs(xu[i * 2 + r] - x_exact->get(i, r)) < 1e-10 * (1 + fabs(x_exact->get(i, r))));
+        }
+    }
+
+    // Determinant of the updated matrix, det(A)*det(C)
+    int sign, sign_u, sign_c;
+    double logdet = fact->log_det(&sign) + update->log_det(&sign_c);
+    assert(fabs(logdet - fact_u->log_det(&sign_u)) < 1e-10);
+    assert(sign * sign_c == sign_u);
+    (void) logdet;
+    (void) sign_u;
+
+    // Discard update
+    update->clear();
+    assert(!update->is_active());
+    assert(update->get_rank() == 0);
+
+    // Delete data
+    delete A;
+    delete Au;
+    delete fact;
+    delete fact_u;
+    delete update;
+    delete b;
+    delete x;
+    delete[] xu;
+    delete x_exact;
+}
+
+void __test_low_rank_update_singular() {
+    test_print_title("LOW-RANK-UPDATE", "test_low_rank_update_singular");
+
+    // Identity, second diagonal value is removed
+    FEMatrix *I = FEMatrix_identity(3);
+    FEMatrixFactorization *fact = new FEMatrixFactorization();
+    fact->cholesky(I);
+    LowRankSolve solve = [fact](double *x, int nrhs) { fact->solve(x, nrhs); };
+    LowRankUpdate *update = new LowRankUpdate();
+    std::vector<int> rows = {1};
+    double delta = -1;
+    bool error = false;
+    try {
+        update->update(3, rows, &delta, solve);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    assert(!update->is_active());
+
+    // Row overflow
+    rows[0] = 3;
+    error = false;
+    try {
+        update->update(3, rows, &delta, solve);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete I;
+    delete fact;
+    delete update;
+}
+
+/**
+ * Performs TEST-LOW-RANK-UPDATE tests.
+ */
+void test_low_rank_update_suite() {
+    __test_low_rank_update_solve();
+    __test_low_rank_update_singular();
+}
\ No newline at end of file
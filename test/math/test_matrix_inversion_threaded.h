@@ -0,0 +1,92 @@
+/**
+FNELEM-GPU - THREADED MATRIX INVERSION TEST
+Test Gauss-Jordan inversion by host threads.
+
+@package test.math
+@author ppizarror
+@date 02/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/matrix_inversion_cpu.h"
+#include "../../fnelem/math/matrix_inversion_threaded.h"
+
+void __test_matrix_inversion_threaded_inverse() {
+    test_print_title("MATRIX-INVERSION-THREADED", "test_matrix_inversion_threaded_inverse");
+
+    // Symmetric diagonally dominant matrix
+    int n = 60;
+    FEMatrix *A = new FEMatrix(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double v = (i == j) ? 2.0 * n : cos(0.3 * i + 0.7 * j);
+            if (abs(i - j) > 10) v = 0; // Banded values, rows are skipped
+            A->set(i, j, v);
+            A->set(j, i, v);
+        }
+    }
+    FEMatrix *inv = matrix_inverse_cpu(A);
+
+    // Serial and parallel inversion use the same kernels
+    FEMatrix *inv_serial = matrix_inverse_threaded(A, nullptr);
+    ThreadPool *pool = new ThreadPool(4);
+    FEMatrix *inv_parallel = matrix_inverse_threaded(A, pool);
+    FEMatrix AI = *A * *inv_parallel;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            assert(fabs(inv_serial->get(i, j) - inv->get(i, j)) < 1e-12);
+            assert(inv_serial->get(i, j) == inv_parallel->get(i, j));
+            assert(fabs(AI.get(i, j) - (i == j ? 1 : 0)) < 1e-12);
+        }
+    }
+
+    // Singular matrix
+    FEMatrix *S = new FEMatrix(3, 3);
+    S->set(0, 0, 1);
+    S->set(2, 2, 1);
+    bool error = false;
+    try {
+        matrix_inverse_threaded(S, pool);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete A;
+    delete S;
+    delete inv;
+    delete inv_serial;
+    delete inv_parallel;
+    delete pool;
+}
+
+/**
+ * Performs TEST-MATRIX-INVERSION-THREADED tests.
+ */
+void test_matrix_inversion_threaded_suite() {
+    __test_matrix_inversion_threaded_inverse();
+}
\ No newline at end of file
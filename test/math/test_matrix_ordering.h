@@ -0,0 +1,135 @@
+/**
+FNELEM-GPU - MATRIX ORDERING TEST
+Test graph orderings.
+
+@package test.math
+@author ppizarror
+@date 28/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/matrix_ordering.h"
+
+/**
+ * Creates the adjacency graph of a nx*ny grid numbered row by row.
+ *
+ * @param nx Number of vertices along x
+ * @param ny Number of vertices along y
+ * @return
+ */
+std::vector<std::vector<int>> *__test_matrix_ordering_grid(int nx, int ny) {
+    std::vector<std::vector<int>> *graph = new std::vector<std::vector<int>>(static_cast<unsigned long>(nx * ny));
+    int v;
+    for (int j = 0; j < ny; j++) {
+        for (int i = 0; i < nx; i++) {
+            v = j * nx + i;
+            if (i > 0) graph->at(v).push_back(v - 1);
+            if (i < nx - 1) graph->at(v).push_back(v + 1);
+            if (j > 0) graph->at(v).push_back(v - nx);
+            if (j < ny - 1) graph->at(v).push_back(v + nx);
+        }
+    }
+    return graph;
+}
+
+/**
+ * Returns graph bandwidth under a permutation.
+ *
+ * @param graph Adjacency graph
+ * @param perm Permutation, perm[k] is the vertex placed at position k
+ * @return
+ */
+int __test_matrix_ordering_bandwidth(std::vector<std::vector<int>> *graph, std::vector<int> *perm) {
+    std::vector<int> pos(graph->size());
+    for (unsigned long k = 0; k < perm->size(); k++) {
+        pos[perm->at(k)] = static_cast<int>(k);
+    }
+    int bw = 0;
+    for (unsigned long v = 0; v < graph->size(); v++) {
+        for (int w : graph->at(v)) {
+            bw = std::max(bw, abs(pos[v] - pos[w]));
+        }
+    }
+    return bw;
+}
+
+void __test_matrix_ordering_rcm() {
+    test_print_title("MATRIX-ORDERING", "test_matrix_ordering_rcm");
+
+    // Long grid numbered along the long side has bandwidth 20
+    std::vector<std::vector<int>> *graph = __test_matrix_ordering_grid(20, 3);
+    std::vector<int> natural;
+    for (int k = 0; k < 60; k++) natural.push_back(k);
+    assert(__test_matrix_ordering_bandwidth(graph, &natural) == 20);
+
+    // RCM numbers along the short side
+    std::vector<int> *perm = ordering_rcm(graph);
+    assert(ordering_is_permutation(perm, 60));
+    assert(__test_matrix_ordering_bandwidth(graph, perm) <= 4);
+    delete perm;
+
+    // Disconnected graph, isolated vertex
+    graph->push_back(std::vector<int>());
+    perm = ordering_rcm(graph);
+    assert(ordering_is_permutation(perm, 61));
+    delete perm;
+    delete graph;
+}
+
+void __test_matrix_ordering_minimum_degree() {
+    test_print_title("MATRIX-ORDERING", "test_matrix_ordering_minimum_degree");
+
+    // Star graph, the center is eliminated once only one leaf remains
+    std::vector<std::vector<int>> *graph = new std::vector<std::vector<int>>(6);
+    for (int k = 1; k < 6; k++) {
+        graph->at(0).push_back(k);
+        graph->at(k).push_back(0);
+    }
+    std::vector<int> *perm = ordering_minimum_degree(graph);
+    assert(ordering_is_permutation(perm, 6));
+    assert(perm->at(4) == 0 || perm->at(5) == 0);
+    delete perm;
+    delete graph;
+
+    // Grid graph
+    graph = __test_matrix_ordering_grid(7, 5);
+    perm = ordering_minimum_degree(graph);
+    assert(ordering_is_permutation(perm, 35));
+    delete perm;
+    delete graph;
+
+    // Invalid permutations
+    std::vector<int> p = {0, 2, 2};
+    assert(!ordering_is_permutation(&p, 3));
+    assert(!ordering_is_permutation(&p, 4));
+}
+
+/**
+ * Performs TEST-MATRIX-ORDERING tests.
+ */
+void test_matrix_ordering_suite() {
+    __test_matrix_ordering_rcm();
+    __test_matrix_ordering_minimum_degree();
+}
\ No newline at end of file
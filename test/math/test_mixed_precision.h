@@ -0,0 +1,102 @@
+/**
+FNELEM-GPU - MIXED PRECISION SOLVER TEST
+Test single precision factorization with iterative refinement.
+
+@package test.math
+@author ppizarror
+@date 01/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/mixed_precision.h"
+
+void __test_mixed_precision_refinement() {
+    test_print_title("MIXED-PRECISION", "test_mixed_precision_refinement");
+
+    // Double precision solution
+    int N = 30 * 30;
+    FEMatrixSparse *A = __test_amg_poisson(30);
+    FEMatrix *b = new FEMatrix(N, 2);
+    for (int i = 0; i < N; i++) {
+        b->set(i, 0, 1);
+        b->set(i, 1, sin(0.1 * i));
+    }
+    SparseLDL *ldl = new SparseLDL();
+    ldl->factorize(A);
+    FEMatrix *u = ldl->solve(b);
+
+    // Single precision factors use half of the memory
+    MixedPrecisionSolver *mixed = new MixedPrecisionSolver();
+    mixed->factorize(A);
+    assert(!mixed->is_fallback());
+    assert(2 * mixed->get_factor_bytes() == ldl->get_factor_bytes());
+
+    // Refinement recovers double precision accuracy
+    FEMatrix *u_mixed = mixed->solve(b);
+    assert(mixed->get_refinement_steps() > 0);
+    assert(mixed->get_residual() <= 1e-12);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < 2; j++) {
+            assert(fabs(u->get(i, j) - u_mixed->get(i, j)) <= 1e-9 * fabs(u->get(i, j)) + 1e-12);
+        }
+    }
+    delete u_mixed;
+
+    // Without refinement steps the solver falls back to double precision
+    mixed->set_max_steps(0);
+    u_mixed = mixed->solve(b);
+    assert(mixed->is_fallback());
+    assert(mixed->get_refinement_steps() == 0);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < 2; j++) {
+            assert(fabs(u->get(i, j) - u_mixed->get(i, j)) <= 1e-12 * fabs(u->get(i, j)) + 1e-14);
+        }
+    }
+
+    // Invalid tolerance
+    bool error = false;
+    try {
+        mixed->set_tolerance(0);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete A;
+    delete b;
+    delete ldl;
+    delete u;
+    delete u_mixed;
+    delete mixed;
+}
+
+/**
+ * Performs TEST-MIXED-PRECISION tests.
+ */
+void test_mixed_precision_suite() {
+    __test_mixed_precision_refinement();
+}
\ No newline at end of file
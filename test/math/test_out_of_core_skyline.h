@@ -0,0 +1,156 @@
+/**
+FNELEM-GPU - OUT-OF-CORE SKYLINE TEST
+Test skyline factorization stored in memory-mapped panels.
+
+@package test.math
+@author ppizarror
+@date 05/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_skyline.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+#include "../../fnelem/math/out_of_core_skyline.h"
+
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+
+void __test_out_of_core_skyline_solve() {
+    test_print_title("OUT-OF-CORE-SKYLINE", "test_out_of_core_skyline_solve");
+
+    // In memory skyline factorization
+    int N = 30 * 30;
+    FEMatrixSparse *A = __test_amg_poisson(30);
+    FEMatrixSkyline *sky = new FEMatrixSkyline(A);
+    sky->factorize();
+
+    // Budget only holds a few panels of the envelope
+    long memory = 65536;
+    OutOfCoreSkyline *ooc = new OutOfCoreSkyline(A, memory, OutOfCoreSkyline::get_default_directory());
+    assert(ooc->get_dimension() == N);
+    assert(ooc->get_nvalues() == sky->get_nvalues());
+    assert(ooc->get_file_bytes() == 8 * sky->get_nvalues());
+    assert(ooc->get_panels() > 4);
+    assert(ooc->get_file_bytes() > memory);
+    ooc->factorize();
+    assert(ooc->is_factorized());
+    assert(ooc->get_peak_memory() <= memory);
+
+    // Same operations than the in memory factorization
+    FEMatrix *b = new FEMatrix(N, 2);
+    for (int i = 0; i < N; i++) {
+        b->set(i, 0, 1);
+        b->set(i, 1, sin(0.1 * i));
+    }
+    FEMatrix *x = ooc->solve(b);
+    FEMatrix *x_sky = sky->solve(b);
+    for (int i = 0; i < N; i++) {
+        assert(fabs(x->get(i, 0) - x_sky->get(i, 0)) <= 1e-12 * fabs(x_sky->get(i, 0)));
+        assert(fabs(x->get(i, 1) - x_sky->get(i, 1)) <= 1e-12 * (1 + fabs(x_sky->get(i, 1))));
+    }
+    int sign, sign_sky;
+    assert(fabs(ooc->log_det(&sign) - sky->log_det(&sign_sky)) < 1e-10 * fabs(sky->log_det(&sign_sky)));
+    assert(sign == sign_sky);
+    (void) sign;
+    (void) sign_sky;
+
+    // Factorization cannot be repeated
+    bool error = false;
+    try {
+        ooc->factorize();
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete A;
+    delete sky;
+    delete ooc;
+    delete b;
+    delete x;
+    delete x_sky;
+}
+
+void __test_out_of_core_skyline_errors() {
+    test_print_title("OUT-OF-CORE-SKYLINE", "test_out_of_core_skyline_errors");
+
+    // Singular matrix [1 1; 1 1]
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(2);
+    pattern->at(0).push_back(0);
+    pattern->at(1).push_back(0);
+    pattern->at(1).push_back(1);
+    FEMatrixSparse *mat = new FEMatrixSparse(2, 2, pattern, true);
+    mat->set(0, 0, 1);
+    mat->set(1, 0, 1);
+    mat->set(1, 1, 1);
+    OutOfCoreSkyline *ooc = new OutOfCoreSkyline(mat, 1024, OutOfCoreSkyline::get_default_directory());
+    bool error = false;
+    try {
+        ooc->factorize();
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    assert(!ooc->is_factorized());
+
+    // Solve requires factorization
+    double x[2] = {1, 1};
+    error = false;
+    try {
+        ooc->solve(x);
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+
+    // Invalid directory
+    error = false;
+    try {
+        OutOfCoreSkyline invalid(mat, 1024, "/fnelem-directory-does-not-exist");
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete pattern;
+    delete mat;
+    delete ooc;
+}
+
+#endif
+
+/**
+ * Performs TEST-OUT-OF-CORE-SKYLINE tests, only if memory-mapped files are supported.
+ */
+void test_out_of_core_skyline_suite() {
+#ifdef FNELEM_OUT_OF_CORE_SKYLINE
+    __test_out_of_core_skyline_solve();
+    __test_out_of_core_skyline_errors();
+#endif
+}
\ No newline at end of file
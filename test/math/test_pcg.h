@@ -0,0 +1,96 @@
+/**
+FNELEM-GPU - PCG TEST
+Test preconditioned conjugate gradient solver.
+
+@package test.math
+@author ppizarror
+@date 27/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+#include "../../fnelem/math/fematrix_utils.h"
+#include "../../fnelem/math/pcg.h"
+
+void __test_pcg_solve() {
+    test_print_title("PCG", "test_pcg_solve");
+
+    // Symmetric positive definite tridiagonal matrix with variable diagonal
+    int n = 20;
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        pattern->at(i).push_back(i);
+        if (i > 0) pattern->at(i).push_back(i - 1);
+    }
+    FEMatrixSparse *mat = new FEMatrixSparse(n, n, pattern, true);
+    for (int i = 0; i < n; i++) {
+        mat->set(i, i, 2 + i);
+        if (i > 0) mat->set(i, i - 1, -1);
+    }
+
+    // Solve
+    FEMatrix *b = FEMatrix_vector(n);
+    b->fill_ones();
+    PCGSolver *pcg = new PCGSolver();
+    pcg->set_tolerance(1e-12);
+    pcg->set_max_iterations(100);
+    FEMatrix *x = pcg->solve(mat, b);
+    pcg->disp();
+    assert(pcg->has_converged());
+    assert(pcg->get_iterations() <= n);
+
+    // History starts with the initial residual and decreases below tolerance
+    std::vector<double> history = pcg->get_history();
+    assert(history.size() == static_cast<unsigned long>(pcg->get_iterations() + 1));
+    assert(is_num_equal(history[0], 1));
+    assert(history.back() < 1e-12);
+
+    // Check residual
+    FEMatrix *r = *mat * *x;
+    *r -= b;
+    assert(r->norm() < 1e-9);
+
+    // Iteration cap stops the solver
+    pcg->set_max_iterations(1);
+    FEMatrix *x1 = pcg->solve(mat, b);
+    assert(!pcg->has_converged());
+    assert(pcg->get_iterations() == 1);
+
+    delete pattern;
+    delete mat;
+    delete b;
+    delete x;
+    delete x1;
+    delete r;
+    delete pcg;
+}
+
+/**
+ * Performs TEST-PCG tests.
+ */
+void test_pcg_suite() {
+    __test_pcg_solve();
+}
\ No newline at end of file
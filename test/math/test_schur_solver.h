@@ -0,0 +1,115 @@
+/**
+FNELEM-GPU - SUBSTRUCTURING SOLVER TEST
+Test domain decomposition solver.
+
+@package test.math
+@author ppizarror
+@date 01/01/2019
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/schur_solver.h"
+
+void __test_schur_solver_chain() {
+    test_print_title("SCHUR-SOLVER", "test_schur_solver_chain");
+
+    // Chain of 2x2 springs, element e joins DOF e-1 and e, DOF -1 is restrained. Each
+    // domain has 5 consecutive elements, so DOF 4, 9 and 14 are interface DOF
+    int n = 20;
+    double block[4] = {2, -1, -1, 2};
+    SchurSolver *schur = new SchurSolver(n, 4);
+    std::vector<std::vector<int>> pattern(static_cast<unsigned long>(n));
+    for (int e = 0; e < n; e++) {
+        int index[2] = {e - 1, e};
+        schur->add_element(e / 5, 2, index, block);
+        pattern[e].push_back(e);
+        if (e > 0) pattern[e].push_back(e - 1);
+    }
+    schur->factorize();
+    assert(schur->is_factorized());
+    assert(schur->get_domains() == 4);
+    assert(schur->get_interface_dimension() == 3);
+    assert(schur->get_interior_dimension(0) == 4);
+    assert(schur->get_interior_dimension(3) == 5);
+
+    // Assembled matrix and direct solution
+    FEMatrixSparse *K = new FEMatrixSparse(n, n, &pattern, true);
+    for (int e = 0; e < n; e++) {
+        int index[2] = {e - 1, e};
+        K->assemble(2, index, block);
+    }
+    FEMatrix *b = new FEMatrix(n, 2);
+    for (int i = 0; i < n; i++) {
+        b->set(i, 0, 1);
+        b->set(i, 1, i % 3 - 1);
+    }
+    SparseLDL *ldl = new SparseLDL();
+    ldl->factorize(K);
+    FEMatrix *u = ldl->solve(b);
+
+    // Serial and parallel substructuring
+    FEMatrix *u_schur = schur->solve(b);
+    ThreadPool *pool = new ThreadPool(4);
+    schur->set_thread_pool(pool);
+    schur->factorize();
+    FEMatrix *u_par = schur->solve(b);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < 2; j++) {
+            assert(fabs(u->get(i, j) - u_schur->get(i, j)) < 1e-9 * fabs(u->get(i, j)) + 1e-12);
+            assert(fabs(u->get(i, j) - u_par->get(i, j)) < 1e-9 * fabs(u->get(i, j)) + 1e-12);
+        }
+    }
+
+    // DOF without elements
+    SchurSolver *missing = new SchurSolver(3, 1);
+    int index[2] = {0, 1};
+    missing->add_element(0, 2, index, block);
+    bool error = false;
+    try {
+        missing->factorize();
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+
+    // Delete data
+    delete schur;
+    delete missing;
+    delete pool;
+    delete K;
+    delete b;
+    delete ldl;
+    delete u;
+    delete u_schur;
+    delete u_par;
+}
+
+/**
+ * Performs TEST-SCHUR-SOLVER tests.
+ */
+void test_schur_solver_suite() {
+    __test_schur_solver_chain();
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+/**
+FNELEM-GPU - SPARSE LDL TEST
+Test sparse LDL factorization.
+
+@package test.math
+@author ppizarror
+@date 26/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/fematrix.h"
+#include "../../fnelem/math/fematrix_sparse.h"
+#include "../../fnelem/math/fematrix_utils.h"
+#include "../../fnelem/math/matrix_inversion_cpu.h"
+#include "../../fnelem/math/sparse_ldl.h"
+
+/**
+ * Creates a 2D laplacian matrix of a nx*nx grid, symmetric positive definite.
+ *
+ * @param nx Grid size
+ * @return
+ */
+FEMatrixSparse *__test_sparse_ldl_laplacian(int nx) {
+    int n = nx * nx;
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    int k;
+    for (int i = 0; i < nx; i++) {
+        for (int j = 0; j < nx; j++) {
+            k = i * nx + j;
+            pattern->at(k).push_back(k);
+            if (j > 0) pattern->at(k).push_back(k - 1);
+            if (i > 0) pattern->at(k).push_back(k - nx);
+        }
+    }
+    FEMatrixSparse *mat = new FEMatrixSparse(n, n, pattern, true);
+    for (int i = 0; i < nx; i++) {
+        for (int j = 0; j < nx; j++) {
+            k = i * nx + j;
+            mat->set(k, k, 4);
+            if (j > 0) mat->set(k, k - 1, -1);
+            if (i > 0) mat->set(k, k - nx, -1);
+        }
+    }
+    delete pattern;
+    return mat;
+}
+
+void __test_sparse_ldl_etree() {
+    test_print_title("SPARSE-LDL", "test_sparse_ldl_etree");
+
+    // Tridiagonal matrix, elimination tree is a path
+    int n = 6;
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        pattern->at(i).push_back(i);
+        if (i > 0) pattern->at(i).push_back(i - 1);
+    }
+    FEMatrixSparse *mat = new FEMatrixSparse(n, n, pattern, true);
+    for (int i = 0; i < n; i++) {
+        mat->set(i, i, 2);
+        if (i > 0) mat->set(i, i - 1, -1);
+    }
+
+    SparseLDL *ldl = new SparseLDL();
+    ldl->symbolic(mat);
+    assert(ldl->is_analyzed());
+    assert(!ldl->is_factorized());
+    assert(ldl->get_factor_nnz() == n - 1); // No fill-in
+    const int *parent = ldl->get_elimination_tree();
+    for (int i = 0; i < n - 1; i++) {
+        assert(parent[i] == i + 1);
+    }
+    assert(parent[n - 1] == -1);
+    (void) parent;
+
+    delete pattern;
+    delete mat;
+    delete ldl;
+}
+
+void __test_sparse_ldl_solve() {
+    test_print_title("SPARSE-LDL", "test_sparse_ldl_solve");
+
+    // Factorize laplacian
+    FEMatrixSparse *mat = __test_sparse_ldl_laplacian(5);
+    int n = mat->get_square_dimension();
+    SparseLDL *ldl = new SparseLDL();
+    ldl->factorize(mat);
+    assert(ldl->is_factorized());
+
+    // Compare with dense inversion
+    FEMatrix *b = FEMatrix_vector(n);
+    for (int i = 0; i < n; i++) {
+        b->set(i, i + 1);
+    }
+    FEMatrix *x = ldl->solve(b);
+    FEMatrix *dense = mat->to_dense();
+    FEMatrix *inv = matrix_inverse_cpu(dense);
+    FEMatrix xinv = *inv * *b;
+    for (int i = 0; i < n; i++) {
+        assert(fabs(x->get(i) - xinv.get(i)) < 1e-9);
+    }
+
+    // Residual must be small
+    FEMatrix *r = *mat * *x;
+    *r -= b;
+    assert(r->norm() < 1e-9);
+
+    // Determinant from the diagonal factor equals the dense one
+    int sign, sign1;
+    double logdet = ldl->log_det(&sign);
+    assert(fabs(logdet - dense->log_det(&sign1)) < 1e-10 * fabs(logdet));
+    assert(sign == 1 && sign1 == 1);
+    assert(fabs(ldl->det() - dense->det()) < 1e-10 * dense->det());
+    (void) logdet;
+    (void) sign1;
+
+    // Numeric factorization can be repeated with new values
+    mat->set(0, 0, 8);
+    ldl->numeric(mat);
+    FEMatrix *x2 = ldl->solve(b);
+    FEMatrix *r2 = *mat * *x2;
+    *r2 -= b;
+    assert(r2->norm() < 1e-9);
+
+    // Several right hand sides, second column doubles the first one
+    FEMatrix *B = new FEMatrix(n, 2);
+    for (int i = 0; i < n; i++) {
+        B->set(i, 0, b->get(i));
+        B->set(i, 1, 2 * b->get(i));
+    }
+    FEMatrix *X = ldl->solve(B);
+    for (int i = 0; i < n; i++) {
+        assert(is_num_equal(X->get(i, 0), x2->get(i)));
+        assert(is_num_equal(X->get(i, 1), 2 * x2->get(i)));
+    }
+
+    delete mat;
+    delete ldl;
+    delete B;
+    delete X;
+    delete b;
+    delete x;
+    delete x2;
+    delete dense;
+    delete inv;
+    delete r;
+    delete r2;
+}
+
+void __test_sparse_ldl_singular() {
+    test_print_title("SPARSE-LDL", "test_sparse_ldl_singular");
+
+    // Singular matrix [1 1; 1 1]
+    std::vector<std::vector<int>> *pattern = new std::vector<std::vector<int>>(2);
+    pattern->at(0).push_back(0);
+    pattern->at(1).push_back(0);
+    pattern->at(1).push_back(1);
+    FEMatrixSparse *mat = new FEMatrixSparse(2, 2, pattern, true);
+    mat->set(0, 0, 1);
+    mat->set(1, 0, 1);
+    mat->set(1, 1, 1);
+
+    SparseLDL *ldl = new SparseLDL();
+    bool err = false;
+    try {
+        ldl->factorize(mat);
+    } catch (const std::logic_error &e) {
+        err = true;
+    }
+    assert(err);
+    assert(!ldl->is_factorized());
+    (void) err;
+
+    delete pattern;
+    delete mat;
+    delete ldl;
+}
+
+void __test_sparse_ldl_pattern() {
+    test_print_title("SPARSE-LDL", "test_sparse_ldl_pattern");
+
+    // Diagonal and dense lower triangle matrices, same dimension
+    int n = 4;
+    std::vector<std::vector<int>> *pdiag = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    std::vector<std::vector<int>> *pdense = new std::vector<std::vector<int>>(static_cast<unsigned long>(n));
+    for (int i = 0; i < n; i++) {
+        pdiag->at(i).push_back(i);
+        for (int j = 0; j <= i; j++) {
+            pdense->at(i).push_back(j);
+        }
+    }
+    FEMatrixSparse *diag = new FEMatrixSparse(n, n, pdiag, true);
+    FEMatrixSparse *dense = new FEMatrixSparse(n, n, pdense, true);
+    for (int i = 0; i < n; i++) {
+        diag->set(i, i, 2);
+        for (int j = 0; j <= i; j++) {
+            dense->set(i, j, i == j ? n + 1 : 1);
+        }
+    }
+    assert(diag->get_pattern_fingerprint() != dense->get_pattern_fingerprint());
+
+    // Symbolic factorization is redone if the pattern changes
+    SparseLDL *ldl = new SparseLDL();
+    ldl->factorize(diag);
+    assert(ldl->get_factor_nnz() == 0);
+    ldl->factorize(dense);
+    assert(ldl->get_factor_nnz() == n * (n - 1) / 2);
+    double x[] = {n + 4.0, n + 4.0, n + 4.0, n + 4.0};
+    ldl->solve(x);
+    for (int i = 0; i < n; i++) {
+        assert(is_num_equal(x[i], 1));
+    }
+
+    // Numeric factorization requires the pattern of the symbolic factorization
+    bool err = false;
+    try {
+        ldl->numeric(diag);
+    } catch (const std::logic_error &e) {
+        err = true;
+    }
+    assert(err);
+    (void) err;
+
+    delete pdiag;
+    delete pdense;
+    delete diag;
+    delete dense;
+    delete ldl;
+}
+
+/**
+ * Performs TEST-SPARSE-LDL tests.
+ */
+void test_sparse_ldl_suite() {
+    __test_sparse_ldl_etree();
+    __test_sparse_ldl_solve();
+    __test_sparse_ldl_singular();
+    __test_sparse_ldl_pattern();
+}
\ No newline at end of file
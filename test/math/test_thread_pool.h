@@ -0,0 +1,84 @@
+/**
+FNELEM-GPU - THREAD POOL TEST
+Test thread pool parallel loops.
+
+@package test.math
+@author ppizarror
+@date 30/12/2018
+@license
+	MIT License
+	Copyright (c) 2018 Pablo Pizarro R.
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+// Include sources
+#include "../test_utils.h"
+#include "../../fnelem/math/thread_pool.h"
+
+void __test_thread_pool_parallel_for() {
+    test_print_title("THREAD-POOL", "test_thread_pool_parallel_for");
+
+    // Each position is written by one chunk
+    ThreadPool *pool = new ThreadPool(4);
+    assert(pool->get_threads() == 4);
+    std::vector<int> values(1000, 0);
+    for (int rep = 0; rep < 10; rep++) {
+        pool->parallel_for(1000, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) values[i] += i;
+        });
+    }
+    for (int i = 0; i < 1000; i++) {
+        assert(values[i] == 10 * i);
+    }
+
+    // Range shorter than the number of threads
+    int count = 0;
+    pool->parallel_for(1, [&](int begin, int end) { count += end - begin; });
+    assert(count == 1);
+    pool->parallel_for(0, [&](int begin, int end) { count += end - begin; });
+    assert(count == 1);
+
+    // Exceptions are thrown again by the calling thread
+    bool error = false;
+    try {
+        pool->parallel_for(100, [&](int /* begin */, int end) {
+            if (end == 100) throw std::logic_error("Last chunk");
+        });
+    } catch (const std::logic_error &e) {
+        error = true;
+    }
+    assert(error);
+    (void) error;
+    delete pool;
+
+    // Single thread runs on the calling thread
+    ThreadPool *serial = new ThreadPool(1);
+    assert(serial->get_threads() == 1);
+    serial->parallel_for(10, [&](int begin, int end) { count += end - begin; });
+    assert(count == 11);
+    delete serial;
+}
+
+/**
+ * Performs TEST-THREAD-POOL tests.
+ */
+void test_thread_pool_suite() {
+    __test_thread_pool_parallel_for();
+}
\ No newline at end of file
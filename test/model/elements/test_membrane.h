@@ -57,6 +57,7 @@ void __test_membrane_creation() {
     assert (n2 == nodes->at(1));
     assert (n3 == nodes->at(2));
     assert (n4 == nodes->at(3));
+    (void) nodes;
 
     // Test dimension
     assert(is_num_equal(mem->get_width(), 250));
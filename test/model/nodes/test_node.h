@@ -149,8 +149,8 @@ void __test_node_load() {
     n->apply_load(load);
     FEMatrix *r1 = n->get_reactions();
     r1->disp();
-    FEMatrix *minload = -*load;
-    assert(r1->equals(minload));
+    FEMatrix minload = -*load;
+    assert(r1->equals(&minload));
     n->apply_element_stress(load);
     FEMatrix *r2 = n->get_reactions();
     assert(r2->is_zeros());
@@ -158,7 +158,6 @@ void __test_node_load() {
     delete n;
     delete r1;
     delete load;
-    delete minload;
 }
 
 void __test_node_full() {
@@ -32,9 +32,30 @@ Imports all tests.
 #ifndef FNELEM_GPU_TEST_FNELEM_SUITE_H
 #define FNELEM_GPU_TEST_FNELEM_SUITE_H
 
+#include "analysis/test_solver_cost_model.h"
+#include "analysis/test_solver_registry.h"
 #include "analysis/test_static_analysis.h"
+#include "math/test_amg.h"
+#include "math/test_condition_estimate.h"
+#include "math/test_element_operator.h"
 #include "math/test_fematrix.h"
+#include "math/test_fematrix_expression.h"
+#include "math/test_fematrix_factorization.h"
+#include "math/test_fematrix_gemm.h"
+#include "math/test_fematrix_skyline.h"
+#include "math/test_fematrix_sparse.h"
 #include "math/test_fematrix_utils.h"
+#include "math/test_fixed_matrix.h"
+#include "math/test_gmg.h"
+#include "math/test_low_rank_update.h"
+#include "math/test_matrix_inversion_threaded.h"
+#include "math/test_matrix_ordering.h"
+#include "math/test_mixed_precision.h"
+#include "math/test_out_of_core_skyline.h"
+#include "math/test_pcg.h"
+#include "math/test_schur_solver.h"
+#include "math/test_sparse_ldl.h"
+#include "math/test_thread_pool.h"
 #include "model/base/test_model.h"
 #include "model/base/test_model_component.h"
 #include "model/elements/test_elements.h"
@@ -52,8 +73,27 @@ Imports all tests.
  */
 void test_suite() {
     test_elements_suite();
+    test_amg_suite();
+    test_condition_estimate_suite();
+    test_element_operator_suite();
     test_fematrix_suite();
+    test_fematrix_expression_suite();
+    test_fematrix_factorization_suite();
+    test_fematrix_gemm_suite();
+    test_fematrix_skyline_suite();
+    test_fematrix_sparse_suite();
     test_fematrix_utils_suite();
+    test_fixed_matrix_suite();
+    test_gmg_suite();
+    test_low_rank_update_suite();
+    test_matrix_inversion_threaded_suite();
+    test_matrix_ordering_suite();
+    test_mixed_precision_suite();
+    test_out_of_core_skyline_suite();
+    test_pcg_suite();
+    test_schur_solver_suite();
+    test_sparse_ldl_suite();
+    test_thread_pool_suite();
     test_load_membrane_distributed_suite();
     test_load_node_suite();
     test_load_pattern_constant_suite();
@@ -64,6 +104,8 @@ void test_suite() {
     test_model_suite();
     test_node_suite();
     test_restraint_node_suite();
+    test_solver_cost_model_suite();
+    test_solver_registry_suite();
     test_static_analysis_suite();
 }
 